@@ -0,0 +1,439 @@
+// Times the demo's hot kernels one at a time on the demo's own assets: the
+// fetus.igu render, every legacy10 pass, the Surface32 blits, the indexed
+// present, the Watercube and Feta effect kernels and the IGU/ASE/GIF loaders.
+// Pixel kernels report ns/pixel of the 512x256 frame they cover, loaders MB/s
+// of the file they parse.
+//
+// usage: forward_microbench [iterations] [name-substring ...]
+// Assets are looked up under original/forward from the working directory up.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/AseScene.h"
+#include "core/Camera.h"
+#include "core/EffectKernels.h"
+#include "core/GifIndexed.h"
+#include "core/Image32.h"
+#include "core/ImageView.h"
+#include "core/IndexedSurface8.h"
+#include "core/LegacyPacked10.h"
+#include "core/Mesh.h"
+#include "core/MeshLoaderIgu.h"
+#include "core/Renderer3D.h"
+#include "core/Surface32.h"
+
+namespace {
+
+namespace core = forward::core;
+namespace legacy10 = forward::core::legacy10;
+
+constexpr int kFrameWidth = 512;
+constexpr int kFrameHeight = 256;
+constexpr size_t kFramePixels = static_cast<size_t>(kFrameWidth) * kFrameHeight;
+
+enum class Unit { kNanosecondsPerPixel, kMegabytesPerSecond };
+
+struct Kernel {
+  std::string name;
+  Unit unit = Unit::kNanosecondsPerPixel;
+  // Pixels touched or bytes parsed by one call of `run`.
+  double work = 0.0;
+  std::function<void(int iteration)> run;
+};
+
+std::string FindForwardAsset(const std::string& relative_path) {
+  std::error_code ec;
+  std::filesystem::path cursor = std::filesystem::current_path(ec);
+  while (!ec) {
+    const std::filesystem::path candidate = cursor / "original" / "forward" / relative_path;
+    if (std::filesystem::exists(candidate, ec)) {
+      return candidate.string();
+    }
+    if (cursor.parent_path() == cursor) {
+      break;
+    }
+    cursor = cursor.parent_path();
+  }
+  return {};
+}
+
+double FileBytes(const std::string& path) {
+  std::error_code ec;
+  const uintmax_t size = std::filesystem::file_size(path, ec);
+  return ec ? 0.0 : static_cast<double>(size);
+}
+
+uint32_t PackArgb(uint8_t r, uint8_t g, uint8_t b) {
+  return 0xFF000000u | (static_cast<uint32_t>(r) << 16u) | (static_cast<uint32_t>(g) << 8u) |
+         static_cast<uint32_t>(b);
+}
+
+void ToPacked10(const uint32_t* argb, uint32_t* packed10, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    packed10[i] = legacy10::PackRgb8To10(static_cast<uint8_t>((argb[i] >> 16u) & 0xFFu),
+                                         static_cast<uint8_t>((argb[i] >> 8u) & 0xFFu),
+                                         static_cast<uint8_t>(argb[i] & 0xFFu));
+  }
+}
+
+// Mirrors the Feta scene's instance setup at `t` seconds.
+void ConfigureFetusInstance(core::RenderInstance* instance, const core::Image32& texture, float t) {
+  instance->rotation_radians.Set(0.28f * std::sin(t * 0.14f), -t * 0.52f, t * 0.11f);
+  instance->translation = core::Vec3(0.0f,
+                                     0.12f * std::sin(t * 0.37f),
+                                     2.55f + 0.35f * std::sin(t * 0.21f));
+  instance->fill_color = PackArgb(220, 220, 220);
+  instance->draw_fill = true;
+  instance->draw_wire = false;
+  instance->texture = core::ImageView(texture);
+  instance->use_mesh_uv = true;
+  instance->texture_wrap = true;
+  instance->enable_backface_culling = true;
+}
+
+bool Matches(const std::string& name, const std::vector<std::string>& filters) {
+  if (filters.empty()) {
+    return true;
+  }
+  return std::any_of(filters.begin(), filters.end(), [&](const std::string& filter) {
+    return name.find(filter) != std::string::npos;
+  });
+}
+
+void RunKernel(const Kernel& kernel, int iterations) {
+  kernel.run(0);  // Warm caches and lazily sized buffers.
+  const auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    kernel.run(i + 1);
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const double seconds = std::chrono::duration<double>(end - begin).count() / iterations;
+  if (kernel.unit == Unit::kNanosecondsPerPixel) {
+    std::printf("%-36s %10.3f us  %8.3f ns/px\n",
+                kernel.name.c_str(),
+                seconds * 1.0e6,
+                kernel.work > 0.0 ? seconds * 1.0e9 / kernel.work : 0.0);
+  } else {
+    std::printf("%-36s %10.3f us  %8.1f MB/s\n",
+                kernel.name.c_str(),
+                seconds * 1.0e6,
+                seconds > 0.0 ? kernel.work / (1024.0 * 1024.0) / seconds : 0.0);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int iterations = 200;
+  std::vector<std::string> filters;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i == 1 && !arg.empty() && arg.find_first_not_of("0123456789") == std::string::npos) {
+      iterations = std::max(1, std::atoi(arg.c_str()));
+    } else {
+      filters.push_back(arg);
+    }
+  }
+
+  const std::string mesh_path = FindForwardAsset("meshes/fetus.igu");
+  const std::string texture_path = FindForwardAsset("images/babyenv.jpg");
+  const std::string ring_path = FindForwardAsset("images/rinku2.jpg");
+  const std::string gif_path = FindForwardAsset("images/phorward.gif");
+  const std::string ase_path = FindForwardAsset("asses/alku6.ase");
+  for (const std::string* path : {&mesh_path, &texture_path, &ring_path, &gif_path, &ase_path}) {
+    if (path->empty()) {
+      std::fprintf(stderr, "asset not found under original/forward\n");
+      return 1;
+    }
+  }
+
+  std::string error;
+  core::Mesh mesh;
+  core::Image32 texture;
+  core::Image32 ring;
+  core::IndexedImage8 gif;
+  if (!core::LoadIguMesh(mesh_path, mesh, &error) ||
+      !core::LoadImage32(texture_path, texture, &error) ||
+      !core::LoadImage32(ring_path, ring, &error) ||
+      !core::LoadGifIndexed8FirstFrame(gif_path, &gif, &error)) {
+    std::fprintf(stderr, "asset load failed: %s\n", error.c_str());
+    return 1;
+  }
+
+  // The rendered fetus over its environment map is the input of every frame pass.
+  core::Camera camera;
+  camera.fov_degrees = 84.0f;
+  core::RenderInstance instance;
+  const float radius = mesh.BoundingRadius();
+  instance.uniform_scale = (radius > 0.001f) ? (1.0f / radius) : 1.0f;
+  ConfigureFetusInstance(&instance, texture, 10.0f);
+  core::Renderer3D renderer(kFrameWidth, kFrameHeight);
+  core::Surface32 frame(kFrameWidth, kFrameHeight, false);
+  frame.BlitToBack(texture, 0, 0, 0, 0, kFrameWidth, kFrameHeight);
+  renderer.DrawMesh(frame, mesh, camera, instance);
+  const core::RenderStats fetus_stats = renderer.LastDrawStats();
+  const std::vector<uint32_t> frame_argb(frame.BackPixels(), frame.BackPixels() + kFramePixels);
+
+  core::Surface32 mask_surface(kFrameWidth, kFrameHeight, false);
+  core::RenderInstance mask_instance = instance;
+  mask_instance.texture = core::ImageView();
+  mask_instance.fill_color = PackArgb(255, 255, 255);
+  mask_instance.texture_unlit = true;
+  mask_surface.ClearBack(0);
+  renderer.DrawMesh(mask_surface, mesh, camera, mask_instance);
+  std::vector<uint8_t> mesh_mask(kFramePixels);
+  for (size_t i = 0; i < kFramePixels; ++i) {
+    mesh_mask[i] = (mask_surface.BackPixels()[i] & 0x00FFFFFFu) != 0u ? 1u : 0u;
+  }
+
+  std::vector<uint32_t> frame_packed(kFramePixels);
+  ToPacked10(frame_argb.data(), frame_packed.data(), kFramePixels);
+  std::vector<uint32_t> texture_packed(texture.pixels.size());
+  ToPacked10(texture.pixels.data(), texture_packed.data(), texture.pixels.size());
+  std::vector<uint32_t> work(kFramePixels);
+  std::vector<uint32_t> argb_out(kFramePixels);
+
+  core::Surface32 target(kFrameWidth, kFrameHeight, false);
+  core::IndexedSurface8 indexed(kFrameWidth, kFrameHeight);
+  indexed.SetPalette(gif.palette_r, gif.palette_g, gif.palette_b);
+  indexed.BlitImageAt(gif, 0, 0);
+
+  constexpr int kRippleSize = 256;
+  const size_t ripple_count = static_cast<size_t>(kRippleSize) * kRippleSize;
+  std::vector<uint32_t> ring_packed(ring.pixels.size());
+  ToPacked10(ring.pixels.data(), ring_packed.data(), ring.pixels.size());
+  std::vector<uint32_t> ripple_a(ripple_count, 0u);
+  std::vector<uint32_t> ripple_b(ripple_count, 0u);
+  for (int i = 0; i < 4; ++i) {
+    legacy10::AdditiveBlit(ring_packed.data(), ring.width, ring.height, 0, 0, ripple_b.data(),
+                           kRippleSize, kRippleSize, 40 + i * 48, 96, ring.width, ring.height);
+  }
+
+  std::array<uint32_t, 256> feta_palette{};
+  for (int i = 0; i < 256; ++i) {
+    feta_palette[static_cast<size_t>(i)] = legacy10::PackRgb8To10(
+        static_cast<uint8_t>(std::min(255, i * 2)), static_cast<uint8_t>(std::min(255, i * 3)),
+        static_cast<uint8_t>(i));
+  }
+  std::vector<uint8_t> feta_indices_a(kFramePixels);
+  std::vector<uint8_t> feta_indices_b(kFramePixels);
+  for (size_t i = 0; i < kFramePixels; ++i) {
+    feta_indices_a[i] = static_cast<uint8_t>(i & 0xFFu);
+  }
+
+  const double frame_pixels = static_cast<double>(kFramePixels);
+  const int sprite_w = std::min(texture.width, kFrameWidth);
+  const int sprite_h = std::min(texture.height, kFrameHeight);
+  const double sprite_pixels = static_cast<double>(sprite_w) * sprite_h;
+  auto reset_work = [&] { std::copy(frame_packed.begin(), frame_packed.end(), work.begin()); };
+  auto reset_target = [&] {
+    std::copy(frame_argb.begin(), frame_argb.end(), target.BackPixelsMutable());
+  };
+
+  std::vector<Kernel> kernels;
+  kernels.push_back({"Renderer3D::DrawMesh fetus", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int i) {
+                       ConfigureFetusInstance(&instance, texture, 10.0f + 0.02f * i);
+                       renderer.DrawMesh(target, mesh, camera, instance);
+                     }});
+  // Same view into a half-size layer, per frame pixel it ends up covering.
+  core::Surface32 half_layer(kFrameWidth / 2, kFrameHeight / 2, false);
+  kernels.push_back({"Renderer3D::DrawMesh fetus half", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int i) {
+                       ConfigureFetusInstance(&instance, texture, 10.0f + 0.02f * i);
+                       renderer.DrawMesh(half_layer, mesh, camera, instance);
+                     }});
+
+  kernels.push_back({"legacy10::PackRgb8To10", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) { ToPacked10(frame_argb.data(), work.data(), kFramePixels); }});
+  kernels.push_back({"legacy10::PackColor24To10", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) {
+                       for (size_t p = 0; p < kFramePixels; ++p) {
+                         work[p] = legacy10::PackColor24To10(frame_argb[p] & 0x00FFFFFFu);
+                       }
+                     }});
+  kernels.push_back({"legacy10::Unpack10ToArgb", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) {
+                       for (size_t p = 0; p < kFramePixels; ++p) {
+                         argb_out[p] = legacy10::Unpack10ToArgb(frame_packed[p]);
+                       }
+                     }});
+  kernels.push_back({"legacy10::AddSaturating", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) {
+                       for (size_t p = 0; p < kFramePixels; ++p) {
+                         work[p] = legacy10::AddSaturating(work[p], frame_packed[p]);
+                       }
+                     }});
+  kernels.push_back({"legacy10::SubSaturating", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) {
+                       for (size_t p = 0; p < kFramePixels; ++p) {
+                         work[p] = legacy10::SubSaturating(work[p], frame_packed[p]);
+                       }
+                     }});
+  kernels.push_back({"legacy10::AddConstant", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) {
+                       reset_work();
+                       legacy10::AddConstant(work.data(), kFramePixels, 0x203040u);
+                     }});
+  kernels.push_back({"legacy10::SubConstant", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) {
+                       reset_work();
+                       legacy10::SubConstant(work.data(), kFramePixels, 0x203040u);
+                     }});
+  kernels.push_back({"legacy10::ShiftChannelsRight", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) {
+                       reset_work();
+                       legacy10::ShiftChannelsRight(work.data(), kFramePixels, 1);
+                     }});
+  kernels.push_back({"legacy10::AverageNoSaturation", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) {
+                       legacy10::AverageNoSaturation(work.data(), frame_packed.data(),
+                                                     kFramePixels);
+                     }});
+  kernels.push_back({"legacy10::AddHalfSaturating", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) {
+                       reset_work();
+                       legacy10::AddHalfSaturating(work.data(), frame_packed.data(),
+                                                   kFramePixels);
+                     }});
+  kernels.push_back({"legacy10::AdditiveBlit", Unit::kNanosecondsPerPixel, sprite_pixels,
+                     [&](int) {
+                       reset_work();
+                       legacy10::AdditiveBlit(texture_packed.data(), texture.width,
+                                              texture.height, 0, 0, work.data(), kFrameWidth,
+                                              kFrameHeight, 0, 0, sprite_w, sprite_h);
+                     }});
+  kernels.push_back({"legacy10::AdditiveBlitScaled", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) {
+                       reset_work();
+                       legacy10::AdditiveBlitScaled(texture_packed.data(), texture.width,
+                                                    texture.height, work.data(), kFrameWidth,
+                                                    kFrameHeight, 0, 0, kFrameWidth,
+                                                    kFrameHeight);
+                     }});
+  kernels.push_back({"legacy10::HorizontalFeedbackBlur", Unit::kNanosecondsPerPixel,
+                     frame_pixels, [&](int) {
+                       reset_work();
+                       legacy10::HorizontalFeedbackBlur(work.data(), kFrameWidth, kFrameHeight,
+                                                        0.5f);
+                     }});
+  kernels.push_back({"legacy10::ConvertBufferToArgb", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) {
+                       legacy10::ConvertBufferToArgb(frame_packed.data(), argb_out.data(),
+                                                     kFramePixels);
+                     }});
+
+  kernels.push_back({"Surface32::ClearBack", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) { target.ClearBack(PackArgb(2, 3, 8)); }});
+  kernels.push_back({"Surface32::AddBackRgb", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) {
+                       reset_target();
+                       target.AddBackRgb(32, 48, 64);
+                     }});
+  kernels.push_back({"Surface32::SubBackRgb", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int) {
+                       reset_target();
+                       target.SubBackRgb(32, 48, 64);
+                     }});
+  kernels.push_back({"Surface32::BlitToBack", Unit::kNanosecondsPerPixel, sprite_pixels,
+                     [&](int) { target.BlitToBack(texture, 0, 0, 0, 0, sprite_w, sprite_h); }});
+  kernels.push_back({"Surface32::AlphaBlitToBack", Unit::kNanosecondsPerPixel, sprite_pixels,
+                     [&](int) {
+                       reset_target();
+                       target.AlphaBlitToBack(texture, 0, 0, 0, 0, sprite_w, sprite_h, 160);
+                     }});
+  kernels.push_back({"Surface32::AdditiveBlitToBack", Unit::kNanosecondsPerPixel,
+                     sprite_pixels, [&](int) {
+                       reset_target();
+                       target.AdditiveBlitToBack(texture, 0, 0, 0, 0, sprite_w, sprite_h, 150);
+                     }});
+  kernels.push_back({"Surface32::AdditiveBlitScaledToBack", Unit::kNanosecondsPerPixel,
+                     frame_pixels, [&](int) {
+                       reset_target();
+                       target.AdditiveBlitScaledToBack(texture, 0, 0, kFrameWidth, kFrameHeight,
+                                                       150);
+                     }});
+  kernels.push_back({"Surface32::AlphaBlitScaledToBack", Unit::kNanosecondsPerPixel,
+                     frame_pixels, [&](int) {
+                       reset_target();
+                       target.AlphaBlitScaledToBack(texture, 0, 0, kFrameWidth, kFrameHeight,
+                                                    140);
+                     }});
+  kernels.push_back({"Surface32::AdditiveBlitScaledToBack x2", Unit::kNanosecondsPerPixel,
+                     frame_pixels, [&](int) {
+                       reset_target();
+                       target.AdditiveBlitScaledToBack(half_layer.FrontView(), 0, 0, kFrameWidth,
+                                                       kFrameHeight, 150);
+                     }});
+  kernels.push_back({"Surface32::AlphaBlitScaledToBack x2", Unit::kNanosecondsPerPixel,
+                     frame_pixels, [&](int) {
+                       reset_target();
+                       target.AlphaBlitScaledToBack(half_layer.FrontView(), 0, 0, kFrameWidth,
+                                                    kFrameHeight, 140);
+                     }});
+
+  kernels.push_back({"IndexedSurface8::PresentToBack", Unit::kNanosecondsPerPixel,
+                     frame_pixels, [&](int) { indexed.PresentToBack(target); }});
+
+  kernels.push_back({"WatercubeWaveStep", Unit::kNanosecondsPerPixel,
+                     static_cast<double>(ripple_count), [&](int i) {
+                       if ((i & 1) == 0) {
+                         core::WatercubeWaveStep(ripple_b, &ripple_a, kRippleSize, kRippleSize);
+                       } else {
+                         core::WatercubeWaveStep(ripple_a, &ripple_b, kRippleSize, kRippleSize);
+                       }
+                     }});
+  kernels.push_back({"ApplyFetaIndexedComposite", Unit::kNanosecondsPerPixel, frame_pixels,
+                     [&](int i) {
+                       reset_target();
+                       const bool a_to_b = (i & 1) == 0;
+                       core::ApplyFetaIndexedComposite(
+                           target.BackPixelsMutable(), kFrameWidth, kFrameHeight,
+                           a_to_b ? feta_indices_a.data() : feta_indices_b.data(),
+                           a_to_b ? feta_indices_b.data() : feta_indices_a.data(),
+                           mesh_mask.data(), feta_palette, work.data(), 0.0, 0.0, 0.0);
+                     }});
+
+  core::Mesh loaded_mesh;
+  kernels.push_back({"LoadIguMesh fetus.igu", Unit::kMegabytesPerSecond, FileBytes(mesh_path),
+                     [&](int) { core::LoadIguMesh(mesh_path, loaded_mesh, nullptr); }});
+  kernels.push_back({"ParseAseScene alku6.ase", Unit::kMegabytesPerSecond, FileBytes(ase_path),
+                     [&](int) {
+                       core::AseSceneData scene;
+                       const std::vector<std::string> all_objects;
+                       core::ParseAseScene(ase_path, &all_objects, &scene);
+                     }});
+  core::IndexedImage8 loaded_gif;
+  kernels.push_back({"LoadGifIndexed8FirstFrame phorward", Unit::kMegabytesPerSecond,
+                     FileBytes(gif_path), [&](int) {
+                       core::LoadGifIndexed8FirstFrame(gif_path, &loaded_gif, nullptr);
+                     }});
+
+  std::printf("%d iterations, %dx%d frame, fetus.igu %zu triangles\n",
+              iterations, kFrameWidth, kFrameHeight, mesh.triangles.size());
+  std::printf("fetus draw: %llu near-rejected, %llu near-clipped, %llu back-facing, %llu zero-area; "
+              "%llu px tested, %llu depth-rejected, %llu shaded\n",
+              static_cast<unsigned long long>(fetus_stats.triangles_near_rejected),
+              static_cast<unsigned long long>(fetus_stats.triangles_near_clipped),
+              static_cast<unsigned long long>(fetus_stats.triangles_backface_culled),
+              static_cast<unsigned long long>(fetus_stats.triangles_zero_area),
+              static_cast<unsigned long long>(fetus_stats.pixels_tested),
+              static_cast<unsigned long long>(fetus_stats.pixels_depth_rejected),
+              static_cast<unsigned long long>(fetus_stats.pixels_shaded));
+  for (const Kernel& kernel : kernels) {
+    if (Matches(kernel.name, filters)) {
+      RunKernel(kernel, iterations);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,238 @@
+// Times the word-at-a-time GIF LZW decoder against the previous bit-at-a-time
+// decoder (kept here verbatim as the baseline) and checks both produce the same
+// indices.
+//
+// usage: forward_gif_bench [iterations] [file.gif ...]
+// Without files, decodes images/phorward.gif and images/scape/saari.gif from
+// original/forward.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "core/GifIndexed.h"
+#include "core/MappedFile.h"
+
+namespace {
+
+bool DecodeGifLzwBitwise(const std::vector<uint8_t>& compressed,
+                         int min_code_size,
+                         size_t expected_pixels,
+                         std::vector<uint8_t>* out_indices) {
+  if (!out_indices || min_code_size < 2 || min_code_size > 8) {
+    return false;
+  }
+
+  constexpr int kMaxCodes = 4096;
+  const int clear_code = 1 << min_code_size;
+  const int end_code = clear_code + 1;
+
+  std::array<uint16_t, kMaxCodes> prefix{};
+  std::array<uint8_t, kMaxCodes> suffix{};
+  std::array<uint8_t, kMaxCodes> stack{};
+
+  for (int i = 0; i < clear_code; ++i) {
+    suffix[static_cast<size_t>(i)] = static_cast<uint8_t>(i);
+  }
+
+  int code_size = min_code_size + 1;
+  int next_code = end_code + 1;
+  size_t bit_pos = 0;
+
+  auto read_code = [&]() -> int {
+    if (bit_pos + static_cast<size_t>(code_size) > compressed.size() * 8u) {
+      return -1;
+    }
+    int value = 0;
+    for (int i = 0; i < code_size; ++i) {
+      const size_t bit_index = bit_pos + static_cast<size_t>(i);
+      const size_t byte_index = bit_index >> 3u;
+      const int bit_in_byte = static_cast<int>(bit_index & 7u);
+      value |= ((compressed[byte_index] >> bit_in_byte) & 1u) << i;
+    }
+    bit_pos += static_cast<size_t>(code_size);
+    return value;
+  };
+
+  out_indices->clear();
+  out_indices->reserve(expected_pixels);
+
+  int old_code = -1;
+  uint8_t first_char = 0;
+
+  while (out_indices->size() < expected_pixels) {
+    const int code = read_code();
+    if (code < 0) {
+      break;
+    }
+
+    if (code == clear_code) {
+      code_size = min_code_size + 1;
+      next_code = end_code + 1;
+      old_code = -1;
+      continue;
+    }
+    if (code == end_code) {
+      break;
+    }
+
+    if (old_code == -1) {
+      if (code >= clear_code) {
+        return false;
+      }
+      first_char = suffix[static_cast<size_t>(code)];
+      out_indices->push_back(first_char);
+      old_code = code;
+      continue;
+    }
+
+    int in_code = code;
+    int stack_size = 0;
+    int traverse_code = code;
+
+    if (traverse_code >= next_code) {
+      stack[static_cast<size_t>(stack_size++)] = first_char;
+      traverse_code = old_code;
+    }
+
+    while (traverse_code >= clear_code) {
+      if (traverse_code < 0 || traverse_code >= next_code || stack_size >= kMaxCodes) {
+        return false;
+      }
+      stack[static_cast<size_t>(stack_size++)] = suffix[static_cast<size_t>(traverse_code)];
+      traverse_code = static_cast<int>(prefix[static_cast<size_t>(traverse_code)]);
+    }
+
+    if (traverse_code < 0 || traverse_code >= clear_code || stack_size >= kMaxCodes) {
+      return false;
+    }
+    first_char = suffix[static_cast<size_t>(traverse_code)];
+    stack[static_cast<size_t>(stack_size++)] = first_char;
+
+    while (stack_size > 0 && out_indices->size() < expected_pixels) {
+      out_indices->push_back(stack[static_cast<size_t>(--stack_size)]);
+    }
+
+    if (next_code < kMaxCodes) {
+      prefix[static_cast<size_t>(next_code)] = static_cast<uint16_t>(old_code);
+      suffix[static_cast<size_t>(next_code)] = first_char;
+      ++next_code;
+      if (next_code == (1 << code_size) && code_size < 12) {
+        ++code_size;
+      }
+    }
+
+    old_code = in_code;
+  }
+
+  if (out_indices->size() < expected_pixels) {
+    return false;
+  }
+  out_indices->resize(expected_pixels);
+  return true;
+}
+
+std::string FindForwardAsset(const std::string& relative_path) {
+  std::error_code ec;
+  std::filesystem::path cursor = std::filesystem::current_path(ec);
+  while (!ec) {
+    const std::filesystem::path candidate = cursor / "original" / "forward" / relative_path;
+    if (std::filesystem::exists(candidate, ec)) {
+      return candidate.string();
+    }
+    if (cursor.parent_path() == cursor) {
+      break;
+    }
+    cursor = cursor.parent_path();
+  }
+  return {};
+}
+
+template <typename Fn>
+double TimeMilliseconds(int iterations, Fn&& fn) {
+  const auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    fn();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - begin).count() / iterations;
+}
+
+bool BenchFile(const std::string& path, int iterations) {
+  forward::core::MappedFile file;
+  forward::core::GifLzwFrame frame;
+  std::string error;
+  if (!file.Open(path, &error) ||
+      !forward::core::ReadGifFirstFrameLzw(
+          std::span<const uint8_t>(file.Data(), file.Size()), &frame, &error)) {
+    std::fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+    return false;
+  }
+
+  const size_t pixel_count = frame.PixelCount();
+  std::vector<uint8_t> reference;
+  std::vector<uint8_t> fast(pixel_count);
+  bool ok = true;
+  const double bitwise_ms = TimeMilliseconds(iterations, [&] {
+    ok = DecodeGifLzwBitwise(frame.compressed, frame.min_code_size, pixel_count, &reference) && ok;
+  });
+  const double fast_ms = TimeMilliseconds(iterations, [&] {
+    ok = forward::core::DecodeGifLzw(
+             frame.compressed, frame.min_code_size, fast.data(), pixel_count, &error) &&
+         ok;
+  });
+  const bool identical = ok && reference == fast;
+
+  const double megapixels = static_cast<double>(pixel_count) / 1.0e6;
+  std::printf("%-24s %4dx%-4d %7zu B  bitwise %7.3f ms (%6.1f Mpx/s)  fast %7.3f ms (%6.1f Mpx/s)  "
+              "x%.2f  %s\n",
+              std::filesystem::path(path).filename().string().c_str(),
+              frame.width,
+              frame.height,
+              frame.compressed.size(),
+              bitwise_ms,
+              megapixels / (bitwise_ms / 1000.0),
+              fast_ms,
+              megapixels / (fast_ms / 1000.0),
+              bitwise_ms / fast_ms,
+              identical ? "identical" : "MISMATCH");
+  return identical;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int iterations = 50;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i == 1 && !arg.empty() && arg.find_first_not_of("0123456789") == std::string::npos) {
+      iterations = std::max(1, std::atoi(arg.c_str()));
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  if (paths.empty()) {
+    for (const char* relative : {"images/phorward.gif", "images/scape/saari.gif"}) {
+      const std::string path = FindForwardAsset(relative);
+      if (path.empty()) {
+        std::fprintf(stderr, "asset not found: %s\n", relative);
+        return 1;
+      }
+      paths.push_back(path);
+    }
+  }
+
+  bool all_identical = true;
+  for (const std::string& path : paths) {
+    all_identical = BenchFile(path, iterations) && all_identical;
+  }
+  return all_identical ? 0 : 1;
+}
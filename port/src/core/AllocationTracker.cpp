@@ -0,0 +1,330 @@
+#include "AllocationTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if FORWARD_TRACK_ALLOCATIONS && !defined(NDEBUG) && \
+    (defined(_WIN32) || defined(__GLIBC__) || defined(__APPLE__))
+#define FORWARD_ALLOCATION_SITES 1
+#else
+#define FORWARD_ALLOCATION_SITES 0
+#endif
+
+#if FORWARD_ALLOCATION_SITES
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+#include <cstdio>
+#else
+#include <cxxabi.h>
+#include <execinfo.h>
+#endif
+#endif
+
+#if FORWARD_TRACK_ALLOCATIONS && defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace forward::core {
+namespace {
+
+#if FORWARD_TRACK_ALLOCATIONS
+
+std::atomic<uint64_t> g_count{0};
+std::atomic<uint64_t> g_bytes{0};
+thread_local AllocationCounters t_counters;
+
+#if FORWARD_ALLOCATION_SITES
+
+constexpr int kSiteDepth = 16;
+// CaptureSite(), Allocate() and the operator new overload; debug builds do
+// not inline them.
+constexpr int kSkippedFrames = 3;
+constexpr size_t kMaxSites = 4096;
+
+struct SiteSlot {
+  uint64_t hash = 0;
+  void* frames[kSiteDepth] = {};
+  int depth = 0;
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+};
+
+// Fixed storage: the table is written from inside operator new.
+SiteSlot g_sites[kMaxSites];
+std::atomic_flag g_sites_lock = ATOMIC_FLAG_INIT;
+// Per thread, like the counters the bench checks, so a report only lists
+// stacks of the thread that was being measured.
+thread_local bool t_capture = false;
+thread_local bool t_in_capture = false;
+
+class SiteLock {
+ public:
+  SiteLock() {
+    while (g_sites_lock.test_and_set(std::memory_order_acquire)) {
+    }
+  }
+  ~SiteLock() { g_sites_lock.clear(std::memory_order_release); }
+};
+
+void CaptureSite(size_t size) {
+  if (!t_capture || t_in_capture) {
+    return;
+  }
+  t_in_capture = true;
+  void* raw[kSiteDepth + kSkippedFrames];
+#if defined(_WIN32)
+  const int captured =
+      static_cast<int>(CaptureStackBackTrace(0, kSiteDepth + kSkippedFrames, raw, nullptr));
+#else
+  const int captured = backtrace(raw, kSiteDepth + kSkippedFrames);
+#endif
+  const int depth = std::max(0, captured - kSkippedFrames);
+  void* const* frames = raw + (captured - depth);
+
+  uint64_t hash = 1469598103934665603ull;
+  for (int i = 0; i < depth; ++i) {
+    hash = (hash ^ reinterpret_cast<uintptr_t>(frames[i])) * 1099511628211ull;
+  }
+  hash |= 1u;
+
+  SiteLock lock;
+  for (size_t probe = 0; probe < kMaxSites; ++probe) {
+    SiteSlot& slot = g_sites[(hash + probe) & (kMaxSites - 1)];
+    if (slot.hash == 0) {
+      slot.hash = hash;
+      slot.depth = depth;
+      std::copy(frames, frames + depth, slot.frames);
+    } else if (slot.hash != hash) {
+      continue;
+    }
+    ++slot.count;
+    slot.bytes += size;
+    break;
+  }
+  t_in_capture = false;
+}
+
+std::string DescribeFrame(void* address) {
+#if defined(_WIN32)
+  char text[32];
+  std::snprintf(text, sizeof(text), "%p", address);
+  return text;
+#else
+  char** symbols = backtrace_symbols(&address, 1);
+  if (!symbols) {
+    return "?";
+  }
+  std::string text = symbols[0];
+  std::free(symbols);
+  // Demangle the first "_Z..." name, as both glibc and macOS print it.
+  const size_t begin = text.find("_Z");
+  if (begin != std::string::npos) {
+    const size_t end = text.find_first_of("+) ", begin);
+    const std::string mangled = text.substr(begin, end - begin);
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+    if (status == 0 && demangled) {
+      text.replace(begin, mangled.size(), demangled);
+    }
+    std::free(demangled);
+  }
+  return text;
+#endif
+}
+
+#endif  // FORWARD_ALLOCATION_SITES
+
+void* Allocate(size_t size) {
+  g_count.fetch_add(1, std::memory_order_relaxed);
+  g_bytes.fetch_add(size, std::memory_order_relaxed);
+  ++t_counters.count;
+  t_counters.bytes += size;
+#if FORWARD_ALLOCATION_SITES
+  CaptureSite(size);
+#endif
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void* AllocateAligned(size_t size, size_t alignment) {
+  g_count.fetch_add(1, std::memory_order_relaxed);
+  g_bytes.fetch_add(size, std::memory_order_relaxed);
+  ++t_counters.count;
+  t_counters.bytes += size;
+#if FORWARD_ALLOCATION_SITES
+  CaptureSite(size);
+#endif
+  // aligned_alloc() wants a whole number of alignments.
+  const size_t rounded = std::max(alignment, (size + alignment - 1) / alignment * alignment);
+#if defined(_WIN32)
+  return _aligned_malloc(rounded, alignment);
+#else
+  return std::aligned_alloc(alignment, rounded);
+#endif
+}
+
+void FreeAligned(void* pointer) {
+#if defined(_WIN32)
+  _aligned_free(pointer);
+#else
+  std::free(pointer);
+#endif
+}
+
+#endif  // FORWARD_TRACK_ALLOCATIONS
+
+}  // namespace
+
+bool AllocationTrackingEnabled() { return FORWARD_TRACK_ALLOCATIONS != 0; }
+
+AllocationCounters ProcessAllocations() {
+#if FORWARD_TRACK_ALLOCATIONS
+  return {g_count.load(std::memory_order_relaxed), g_bytes.load(std::memory_order_relaxed)};
+#else
+  return {};
+#endif
+}
+
+AllocationCounters ThreadAllocations() {
+#if FORWARD_TRACK_ALLOCATIONS
+  return t_counters;
+#else
+  return {};
+#endif
+}
+
+bool AllocationSitesAvailable() { return FORWARD_ALLOCATION_SITES != 0; }
+
+void SetAllocationSiteCapture(bool enabled) {
+#if FORWARD_ALLOCATION_SITES
+  t_capture = enabled;
+#else
+  static_cast<void>(enabled);
+#endif
+}
+
+std::vector<AllocationSite> TakeAllocationSites(size_t max_sites) {
+  std::vector<AllocationSite> sites;
+#if FORWARD_ALLOCATION_SITES
+  // This thread's own allocations below must not wait for the lock it holds.
+  const bool was_in_capture = t_in_capture;
+  t_in_capture = true;
+  std::vector<SiteSlot> taken;
+  taken.reserve(kMaxSites);
+  {
+    SiteLock lock;
+    for (SiteSlot& slot : g_sites) {
+      if (slot.hash != 0) {
+        taken.push_back(slot);
+        slot = SiteSlot{};
+      }
+    }
+  }
+  std::sort(taken.begin(), taken.end(),
+            [](const SiteSlot& a, const SiteSlot& b) { return a.count > b.count; });
+  taken.resize(std::min(taken.size(), max_sites));
+  for (const SiteSlot& slot : taken) {
+    AllocationSite site;
+    site.count = slot.count;
+    site.bytes = slot.bytes;
+    for (int i = 0; i < slot.depth; ++i) {
+      site.frames.push_back(DescribeFrame(slot.frames[i]));
+    }
+    sites.push_back(std::move(site));
+  }
+  t_in_capture = was_in_capture;
+#else
+  static_cast<void>(max_sites);
+#endif
+  return sites;
+}
+
+}  // namespace forward::core
+
+#if FORWARD_TRACK_ALLOCATIONS
+
+void* operator new(std::size_t size) {
+  void* pointer = forward::core::Allocate(size);
+  if (!pointer) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new[](std::size_t size) {
+  void* pointer = forward::core::Allocate(size);
+  if (!pointer) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return forward::core::Allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return forward::core::Allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  void* pointer = forward::core::AllocateAligned(size, static_cast<std::size_t>(alignment));
+  if (!pointer) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  void* pointer = forward::core::AllocateAligned(size, static_cast<std::size_t>(alignment));
+  if (!pointer) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return forward::core::AllocateAligned(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size,
+                     std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return forward::core::AllocateAligned(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  forward::core::FreeAligned(pointer);
+}
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+  forward::core::FreeAligned(pointer);
+}
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+  forward::core::FreeAligned(pointer);
+}
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+  forward::core::FreeAligned(pointer);
+}
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+  forward::core::FreeAligned(pointer);
+}
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+  forward::core::FreeAligned(pointer);
+}
+
+#endif  // FORWARD_TRACK_ALLOCATIONS
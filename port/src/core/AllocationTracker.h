@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifndef FORWARD_TRACK_ALLOCATIONS
+#define FORWARD_TRACK_ALLOCATIONS 0
+#endif
+
+namespace forward::core {
+
+// Calls to the global operator new and the bytes they asked for.
+struct AllocationCounters {
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+};
+
+inline AllocationCounters& operator+=(AllocationCounters& a, const AllocationCounters& b) {
+  a.count += b.count;
+  a.bytes += b.bytes;
+  return a;
+}
+
+inline AllocationCounters operator-(const AllocationCounters& a, const AllocationCounters& b) {
+  return {a.count - b.count, a.bytes - b.bytes};
+}
+
+// A call stack that allocated while site capture was on, innermost frame
+// first, with what it allocated.
+struct AllocationSite {
+  std::vector<std::string> frames;
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+};
+
+// Builds with FORWARD_TRACK_ALLOCATIONS=1 replace the global operator new and
+// delete with counting versions. Without it every counter stays zero.
+bool AllocationTrackingEnabled();
+
+// Since process start, over all threads and over the calling thread.
+AllocationCounters ProcessAllocations();
+AllocationCounters ThreadAllocations();
+
+// Call stacks are recorded only in debug builds of the tracker, and only on
+// threads that have turned capture on; the table holds a bounded number of
+// distinct stacks.
+bool AllocationSitesAvailable();
+// Applies to the calling thread only.
+void SetAllocationSiteCapture(bool enabled);
+// The `max_sites` stacks that allocated most often, which are then forgotten.
+std::vector<AllocationSite> TakeAllocationSites(size_t max_sites);
+
+}  // namespace forward::core
@@ -0,0 +1,527 @@
+#include "AseScene.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "MappedFile.h"
+#include "TextScan.h"
+
+namespace forward::core {
+namespace {
+
+constexpr float kPi = 3.14159265358979323846f;
+
+// Splits `line` on whitespace (and ':' when `split_colons`) into views over the
+// line, reusing `out_tokens`' storage. Returns the line's '{' minus '}' count.
+int TokenizeAseLine(std::string_view line, bool split_colons, std::vector<std::string_view>* out_tokens) {
+  out_tokens->clear();
+  int brace_delta = 0;
+  size_t token_start = std::string_view::npos;
+  for (size_t i = 0; i <= line.size(); ++i) {
+    const char c = (i < line.size()) ? line[i] : ' ';
+    brace_delta += (c == '{') ? 1 : (c == '}') ? -1 : 0;
+    const bool separator = c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f' ||
+                           (split_colons && c == ':');
+    if (separator) {
+      if (token_start != std::string_view::npos) {
+        out_tokens->push_back(line.substr(token_start, i - token_start));
+        token_start = std::string_view::npos;
+      }
+    } else if (token_start == std::string_view::npos) {
+      token_start = i;
+    }
+  }
+  return brace_delta;
+}
+
+bool FindAseQuoted(std::string_view line, std::string_view* out_text) {
+  const size_t first_quote = line.find('"');
+  const size_t last_quote = line.rfind('"');
+  if (first_quote == std::string_view::npos || last_quote <= first_quote) {
+    return false;
+  }
+  *out_text = line.substr(first_quote + 1, last_quote - first_quote - 1);
+  return true;
+}
+
+float AseFloat(std::string_view token) { return ParseNumberPrefix<float>(token); }
+double AseDouble(std::string_view token) { return ParseNumberPrefix<double>(token); }
+int AseInt(std::string_view token, int fallback = 0) {
+  return ParseNumberPrefix<int>(token, fallback);
+}
+
+}  // namespace
+
+bool ParseAseScene(const std::string& path,
+                   const std::vector<std::string>* object_names,
+                   AseSceneData* out_scene) {
+  if (!out_scene) {
+    return false;
+  }
+  MappedFile file;
+  if (!file.Open(path, nullptr)) {
+    return false;
+  }
+  std::vector<AseAnimatedObject>* out_objects = &out_scene->animated_objects;
+
+  struct Face {
+    int a = 0;
+    int b = 0;
+    int c = 0;
+  };
+  struct TVert {
+    float u = 0.0f;
+    float v = 0.0f;
+  };
+  struct TFace {
+    int a = 0;
+    int b = 0;
+    int c = 0;
+  };
+  struct RotDeltaKey {
+    double time_ms = 0.0;
+    Vec3 axis;
+    float angle = 0.0f;
+  };
+  struct RawObject {
+    std::string name;
+    Vec3 tm_pos;
+    Vec3 tm_rot_axis{0.0f, 0.0f, 1.0f};
+    float tm_rot_angle = 0.0f;
+    std::vector<Vec3> vertices_world;
+    std::vector<Face> faces;
+    std::vector<TVert> texverts;
+    std::vector<TFace> tfaces;
+    std::vector<AseTrackKey> pos_track;
+    std::vector<RotDeltaKey> rot_track_delta;
+  };
+
+  auto ensure_vec3_size = [](std::vector<Vec3>* v, int idx) {
+    if (idx < 0 || !v) {
+      return;
+    }
+    const size_t need = static_cast<size_t>(idx + 1);
+    if (v->size() < need) {
+      v->resize(need);
+    }
+  };
+  auto ensure_face_size = [](std::vector<Face>* v, int idx) {
+    if (idx < 0 || !v) {
+      return;
+    }
+    const size_t need = static_cast<size_t>(idx + 1);
+    if (v->size() < need) {
+      v->resize(need);
+    }
+  };
+  auto ensure_tvert_size = [](std::vector<TVert>* v, int idx) {
+    if (idx < 0 || !v) {
+      return;
+    }
+    const size_t need = static_cast<size_t>(idx + 1);
+    if (v->size() < need) {
+      v->resize(need);
+    }
+  };
+  auto ensure_tface_size = [](std::vector<TFace>* v, int idx) {
+    if (idx < 0 || !v) {
+      return;
+    }
+    const size_t need = static_cast<size_t>(idx + 1);
+    if (v->size() < need) {
+      v->resize(need);
+    }
+  };
+
+  std::unordered_set<std::string> allowed_name_set;
+  if (object_names) {
+    for (const std::string& name : *object_names) {
+      if (!name.empty()) {
+        allowed_name_set.insert(name);
+      }
+    }
+  }
+
+  auto parse_face = [](const std::vector<std::string_view>& tokens, Face* out_face) -> bool {
+    if (!out_face || tokens.empty()) {
+      return false;
+    }
+    bool has_a = false;
+    bool has_b = false;
+    bool has_c = false;
+    for (size_t i = 0; i + 1 < tokens.size(); ++i) {
+      if (tokens[i] == "A") {
+        out_face->a = AseInt(tokens[i + 1]);
+        has_a = true;
+      } else if (tokens[i] == "B") {
+        out_face->b = AseInt(tokens[i + 1]);
+        has_b = true;
+      } else if (tokens[i] == "C") {
+        out_face->c = AseInt(tokens[i + 1]);
+        has_c = true;
+      }
+    }
+    return has_a && has_b && has_c;
+  };
+
+  auto finalize_object = [&](RawObject&& raw) {
+    if (raw.name.empty() || raw.vertices_world.empty() || raw.faces.empty()) {
+      return;
+    }
+    if (!allowed_name_set.empty() &&
+        allowed_name_set.find(raw.name) == allowed_name_set.end()) {
+      return;
+    }
+
+    AseAnimatedObject out;
+    out.name = raw.name;
+    out.base_position = raw.tm_pos;
+    out.base_rotation = QuatFromAxisAngle(raw.tm_rot_axis, raw.tm_rot_angle);
+
+    const Quat inv_base_rot = QuatConjugate(out.base_rotation);
+
+    const bool has_tfaces = !raw.tfaces.empty() && raw.tfaces.size() == raw.faces.size();
+    const bool has_tverts = !raw.texverts.empty();
+    if (has_tfaces && has_tverts) {
+      std::unordered_map<uint64_t, int> remap;
+      out.mesh.positions.reserve(raw.faces.size() * 3u);
+      out.mesh.texcoords.reserve(raw.faces.size() * 3u);
+      out.mesh.triangles.reserve(raw.faces.size());
+      for (size_t fi = 0; fi < raw.faces.size(); ++fi) {
+        const Face& f = raw.faces[fi];
+        const TFace& tf = raw.tfaces[fi];
+        const int vi[3] = {f.a, f.b, f.c};
+        const int ti[3] = {tf.a, tf.b, tf.c};
+        int tri_idx[3] = {-1, -1, -1};
+        for (int corner = 0; corner < 3; ++corner) {
+          const int v_idx = vi[corner];
+          const int t_idx = ti[corner];
+          if (v_idx < 0 || t_idx < 0 ||
+              v_idx >= static_cast<int>(raw.vertices_world.size()) ||
+              t_idx >= static_cast<int>(raw.texverts.size())) {
+            continue;
+          }
+          const uint64_t key =
+              (static_cast<uint64_t>(static_cast<uint32_t>(v_idx)) << 32u) |
+              static_cast<uint32_t>(t_idx);
+          auto it = remap.find(key);
+          if (it == remap.end()) {
+            const Vec3 local = RotateByQuat(raw.vertices_world[static_cast<size_t>(v_idx)] - raw.tm_pos,
+                                            inv_base_rot);
+            const TVert uv = raw.texverts[static_cast<size_t>(t_idx)];
+            const int new_idx = static_cast<int>(out.mesh.positions.size());
+            out.mesh.positions.push_back(local);
+            out.mesh.texcoords.emplace_back(uv.u, 1.0f - uv.v);
+            remap.emplace(key, new_idx);
+            tri_idx[corner] = new_idx;
+          } else {
+            tri_idx[corner] = it->second;
+          }
+        }
+        if (tri_idx[0] >= 0 && tri_idx[1] >= 0 && tri_idx[2] >= 0) {
+          out.mesh.triangles.push_back({tri_idx[0], tri_idx[1], tri_idx[2]});
+        }
+      }
+    } else {
+      out.mesh.positions.reserve(raw.vertices_world.size());
+      for (const Vec3& p_world : raw.vertices_world) {
+        const Vec3 local = RotateByQuat(p_world - raw.tm_pos, inv_base_rot);
+        out.mesh.positions.push_back(local);
+      }
+      out.mesh.triangles.reserve(raw.faces.size());
+      for (const Face& f : raw.faces) {
+        if (f.a < 0 || f.b < 0 || f.c < 0) {
+          continue;
+        }
+        if (f.a >= static_cast<int>(out.mesh.positions.size()) ||
+            f.b >= static_cast<int>(out.mesh.positions.size()) ||
+            f.c >= static_cast<int>(out.mesh.positions.size())) {
+          continue;
+        }
+        out.mesh.triangles.push_back({f.a, f.b, f.c});
+      }
+    }
+
+    if (out.mesh.positions.empty() || out.mesh.triangles.empty()) {
+      return;
+    }
+    out.mesh.RebuildVertexNormals();
+    if (out.mesh.Empty()) {
+      return;
+    }
+
+    std::sort(raw.pos_track.begin(), raw.pos_track.end(), [](const auto& a, const auto& b) {
+      return a.time_ms < b.time_ms;
+    });
+    out.position_track = std::move(raw.pos_track);
+
+    std::sort(raw.rot_track_delta.begin(),
+              raw.rot_track_delta.end(),
+              [](const auto& a, const auto& b) { return a.time_ms < b.time_ms; });
+    if (!raw.rot_track_delta.empty()) {
+      Quat accum{0.0f, 0.0f, 0.0f, 1.0f};
+      out.rotation_track.reserve(raw.rot_track_delta.size());
+      for (const RotDeltaKey& key : raw.rot_track_delta) {
+        const Quat delta = QuatFromAxisAngle(key.axis, key.angle);
+        // Java path accumulates rot samples by multiplying current sample with previous absolute.
+        accum = QuatNormalize(QuatMul(delta, accum));
+        out.rotation_track.push_back({key.time_ms, accum});
+      }
+    }
+
+    out_objects->push_back(std::move(out));
+  };
+
+  *out_scene = AseSceneData{};
+  RawObject current;
+
+  bool in_geom = false;
+  int geom_depth = 0;
+
+  bool in_node_tm = false;
+  int node_tm_depth = 0;
+
+  bool in_mesh = false;
+  int mesh_depth = 0;
+  bool in_vertex_list = false;
+  int vertex_list_depth = 0;
+  bool in_face_list = false;
+  int face_list_depth = 0;
+  bool in_tvert_list = false;
+  int tvert_list_depth = 0;
+  bool in_tface_list = false;
+  int tface_list_depth = 0;
+
+  bool in_tm_animation = false;
+  int tm_animation_depth = 0;
+  std::string_view active_track_node;
+
+  // Camera tracks live in *CAMERAOBJECT blocks, so they are followed with their own
+  // *TM_ANIMATION state independent of the geometry-object state above.
+  bool in_camera_animation = false;
+  int camera_animation_depth = 0;
+  std::string_view active_camera_node;
+
+  std::vector<std::string_view> tokens;
+  std::vector<std::string_view> tokens_colon;
+  const char* cursor = reinterpret_cast<const char*>(file.Data());
+  const char* const end = cursor + file.Size();
+  while (cursor < end) {
+    const char* newline =
+        static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+    const std::string_view line(cursor, static_cast<size_t>((newline ? newline : end) - cursor));
+    cursor = newline ? newline + 1 : end;
+    const int brace_delta = TokenizeAseLine(line, false, &tokens);
+
+    if (!tokens.empty()) {
+      if (tokens[0] == "*CAMERA_FOV" && tokens.size() >= 2) {
+        out_scene->camera_fov_degrees = AseFloat(tokens[1]) * (180.0f / kPi);
+        out_scene->has_camera_fov = true;
+      }
+      if (tokens[0] == "*TM_ANIMATION") {
+        in_camera_animation = true;
+        camera_animation_depth = 0;
+        active_camera_node = {};
+      }
+      if (in_camera_animation && tokens[0] == "*NODE_NAME") {
+        std::string_view quoted;
+        if (FindAseQuoted(line, &quoted)) {
+          active_camera_node = quoted;
+        }
+      }
+      if (in_camera_animation && tokens[0] == "*CONTROL_POS_SAMPLE" && tokens.size() >= 5) {
+        const AseTrackKey key{
+            AseDouble(tokens[1]), Vec3(AseFloat(tokens[2]), AseFloat(tokens[3]), AseFloat(tokens[4]))};
+        if (active_camera_node == "Camera01") {
+          out_scene->camera_track.push_back(key);
+        } else if (active_camera_node == "Camera01.Target" || active_camera_node == "Camera01.target") {
+          out_scene->target_track.push_back(key);
+        }
+      }
+    }
+    if (in_camera_animation) {
+      camera_animation_depth += brace_delta;
+      if (camera_animation_depth <= 0) {
+        in_camera_animation = false;
+        active_camera_node = {};
+      }
+    }
+    if (!object_names) {
+      continue;
+    }
+
+    if (!in_geom) {
+      if (!tokens.empty() && tokens[0] == "*GEOMOBJECT") {
+        in_geom = true;
+        geom_depth = 0;
+        current = RawObject{};
+      }
+    }
+
+    if (in_geom) {
+      if (!tokens.empty() && tokens[0] == "*NODE_NAME" && current.name.empty() && !in_node_tm &&
+          !in_tm_animation) {
+        std::string_view quoted;
+        FindAseQuoted(line, &quoted);
+        current.name = quoted;
+      }
+
+      if (!tokens.empty() && tokens[0] == "*NODE_TM") {
+        in_node_tm = true;
+        node_tm_depth = 0;
+      }
+      if (in_node_tm && !tokens.empty()) {
+        if (tokens[0] == "*TM_POS" && tokens.size() >= 4) {
+          current.tm_pos.Set(AseFloat(tokens[1]), AseFloat(tokens[2]), AseFloat(tokens[3]));
+        } else if (tokens[0] == "*TM_ROTAXIS" && tokens.size() >= 4) {
+          current.tm_rot_axis.Set(AseFloat(tokens[1]), AseFloat(tokens[2]), AseFloat(tokens[3]));
+        } else if (tokens[0] == "*TM_ROTANGLE" && tokens.size() >= 2) {
+          current.tm_rot_angle = AseFloat(tokens[1]);
+        }
+      }
+
+      if (!tokens.empty() && tokens[0] == "*MESH") {
+        in_mesh = true;
+        mesh_depth = 0;
+      }
+      if (in_mesh) {
+        if (!tokens.empty() && tokens[0] == "*MESH_VERTEX_LIST") {
+          in_vertex_list = true;
+          vertex_list_depth = 0;
+        }
+        if (!tokens.empty() && tokens[0] == "*MESH_FACE_LIST") {
+          in_face_list = true;
+          face_list_depth = 0;
+        }
+        if (!tokens.empty() && tokens[0] == "*MESH_TVERTLIST") {
+          in_tvert_list = true;
+          tvert_list_depth = 0;
+        }
+        if (!tokens.empty() && tokens[0] == "*MESH_TFACELIST") {
+          in_tface_list = true;
+          tface_list_depth = 0;
+        }
+        if (in_vertex_list && !tokens.empty() && tokens[0] == "*MESH_VERTEX" && tokens.size() >= 5) {
+          const int idx = AseInt(tokens[1]);
+          ensure_vec3_size(&current.vertices_world, idx);
+          if (idx >= 0) {
+            current.vertices_world[static_cast<size_t>(idx)] =
+                Vec3(AseFloat(tokens[2]), AseFloat(tokens[3]), AseFloat(tokens[4]));
+          }
+        }
+        if (in_face_list && !tokens.empty() && tokens[0] == "*MESH_FACE") {
+          TokenizeAseLine(line, true, &tokens_colon);
+          int idx = -1;
+          if (tokens_colon.size() >= 2) {
+            idx = AseInt(tokens_colon[1], -1);
+          }
+          Face face{};
+          if (idx >= 0 && parse_face(tokens_colon, &face)) {
+            ensure_face_size(&current.faces, idx);
+            current.faces[static_cast<size_t>(idx)] = face;
+          }
+        }
+        if (in_tvert_list && !tokens.empty() && tokens[0] == "*MESH_TVERT" && tokens.size() >= 4) {
+          const int idx = AseInt(tokens[1]);
+          ensure_tvert_size(&current.texverts, idx);
+          if (idx >= 0) {
+            current.texverts[static_cast<size_t>(idx)] = TVert{AseFloat(tokens[2]), AseFloat(tokens[3])};
+          }
+        }
+        if (in_tface_list && !tokens.empty() && tokens[0] == "*MESH_TFACE" && tokens.size() >= 5) {
+          const int idx = AseInt(tokens[1]);
+          ensure_tface_size(&current.tfaces, idx);
+          if (idx >= 0) {
+            current.tfaces[static_cast<size_t>(idx)] =
+                TFace{AseInt(tokens[2]), AseInt(tokens[3]), AseInt(tokens[4])};
+          }
+        }
+      }
+
+      if (!tokens.empty() && tokens[0] == "*TM_ANIMATION") {
+        in_tm_animation = true;
+        tm_animation_depth = 0;
+        active_track_node = {};
+      }
+      if (in_tm_animation && !tokens.empty()) {
+        if (tokens[0] == "*NODE_NAME") {
+          active_track_node = {};
+          FindAseQuoted(line, &active_track_node);
+        } else if (active_track_node == current.name && tokens[0] == "*CONTROL_POS_SAMPLE" &&
+                   tokens.size() >= 5) {
+          current.pos_track.push_back(
+              {AseDouble(tokens[1]), Vec3(AseFloat(tokens[2]), AseFloat(tokens[3]), AseFloat(tokens[4]))});
+        } else if (active_track_node == current.name && tokens[0] == "*CONTROL_ROT_SAMPLE" &&
+                   tokens.size() >= 6) {
+          current.rot_track_delta.push_back(
+              {AseDouble(tokens[1]),
+               Vec3(AseFloat(tokens[2]), AseFloat(tokens[3]), AseFloat(tokens[4])),
+               AseFloat(tokens[5])});
+        }
+      }
+    }
+
+    if (in_node_tm) {
+      node_tm_depth += brace_delta;
+      if (node_tm_depth <= 0) {
+        in_node_tm = false;
+      }
+    }
+    if (in_vertex_list) {
+      vertex_list_depth += brace_delta;
+      if (vertex_list_depth <= 0) {
+        in_vertex_list = false;
+      }
+    }
+    if (in_face_list) {
+      face_list_depth += brace_delta;
+      if (face_list_depth <= 0) {
+        in_face_list = false;
+      }
+    }
+    if (in_tvert_list) {
+      tvert_list_depth += brace_delta;
+      if (tvert_list_depth <= 0) {
+        in_tvert_list = false;
+      }
+    }
+    if (in_tface_list) {
+      tface_list_depth += brace_delta;
+      if (tface_list_depth <= 0) {
+        in_tface_list = false;
+      }
+    }
+    if (in_mesh) {
+      mesh_depth += brace_delta;
+      if (mesh_depth <= 0) {
+        in_mesh = false;
+      }
+    }
+    if (in_tm_animation) {
+      tm_animation_depth += brace_delta;
+      if (tm_animation_depth <= 0) {
+        in_tm_animation = false;
+        active_track_node = {};
+      }
+    }
+    if (in_geom) {
+      geom_depth += brace_delta;
+      if (geom_depth <= 0) {
+        in_geom = false;
+        finalize_object(std::move(current));
+      }
+    }
+  }
+
+  if (in_geom) {
+    finalize_object(std::move(current));
+  }
+  return true;
+}
+
+}  // namespace forward::core
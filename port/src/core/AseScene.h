@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Mesh.h"
+#include "Quat.h"
+#include "Vec3.h"
+
+namespace forward::core {
+
+struct AseTrackKey {
+  double time_ms = 0.0;
+  Vec3 value;
+};
+
+struct AseRotTrackKey {
+  double time_ms = 0.0;
+  Quat value;
+};
+
+// Geometry object with its mesh in object space plus its keyframed transform.
+struct AseAnimatedObject {
+  std::string name;
+  Mesh mesh;
+  Vec3 base_position;
+  Quat base_rotation;
+  std::vector<AseTrackKey> position_track;
+  std::vector<AseRotTrackKey> rotation_track;
+};
+
+struct AseSceneData {
+  float camera_fov_degrees = 80.0f;
+  bool has_camera_fov = false;
+  std::vector<AseTrackKey> camera_track;
+  std::vector<AseTrackKey> target_track;
+  std::vector<AseAnimatedObject> animated_objects;
+
+  bool HasCameraTracks() const { return !camera_track.empty() && !target_track.empty(); }
+};
+
+// Single pass over a memory-mapped ASE file collecting the Camera01 position/target
+// tracks, the camera FOV and, when `object_names` is non-null, the animated
+// geometry objects (an empty name list keeps every object).
+bool ParseAseScene(const std::string& path,
+                   const std::vector<std::string>* object_names,
+                   AseSceneData* out_scene);
+
+}  // namespace forward::core
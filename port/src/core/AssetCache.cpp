@@ -0,0 +1,255 @@
+#include "AssetCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace forward::core {
+namespace {
+
+constexpr uint32_t kEntryMagic = 0x43415746u;  // "FWAC"
+constexpr uint64_t kFnvPrime = 0x100000001b3ull;
+
+struct EntryHeader {
+  uint32_t magic = kEntryMagic;
+  uint32_t version = kAssetCacheVersion;
+  uint64_t content_hash = 0;
+  uint64_t payload_size = 0;
+};
+
+std::string SanitizeKey(const std::string& key) {
+  std::string out = key;
+  for (char& c : out) {
+    const bool keep = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                      c == '-' || c == '.';
+    if (!keep) {
+      c = '_';
+    }
+  }
+  return out;
+}
+
+bool IsValidEntry(const MappedFile& file, uint64_t content_hash) {
+  if (file.Size() < sizeof(EntryHeader)) {
+    return false;
+  }
+  EntryHeader header;
+  std::memcpy(&header, file.Data(), sizeof(header));
+  return header.magic == kEntryMagic && header.version == kAssetCacheVersion &&
+         header.content_hash == content_hash &&
+         header.payload_size == file.Size() - sizeof(EntryHeader);
+}
+
+// True for "<prefix><16 hex digits>.bin", the name EntryPath() gives every
+// entry of one key.
+bool IsEntryFileName(const std::string& name, const std::string& prefix) {
+  constexpr size_t kHashDigits = 16;
+  const std::string suffix = ".bin";
+  if (name.size() != prefix.size() + kHashDigits + suffix.size() ||
+      name.compare(0, prefix.size(), prefix) != 0 ||
+      name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+    return false;
+  }
+  for (size_t i = prefix.size(); i < prefix.size() + kHashDigits; ++i) {
+    const char c = name[i];
+    if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  uint64_t hash = seed;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+uint64_t HashString(const std::string& text, uint64_t seed) {
+  return HashBytes(text.data(), text.size(), seed);
+}
+
+bool HashFileContents(const std::string& path, uint64_t* out_hash, uint64_t seed) {
+  MappedFile file;
+  if (!out_hash || !file.Open(path, nullptr)) {
+    return false;
+  }
+  *out_hash = HashBytes(file.Data(), file.Size(), seed);
+  return true;
+}
+
+void AssetCacheWriter::WriteBytes(const void* data, size_t size) {
+  if (size == 0) {
+    return;
+  }
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  bytes_.insert(bytes_.end(), bytes, bytes + size);
+}
+
+void AssetCacheWriter::WriteString(const std::string& text) {
+  Write<uint64_t>(text.size());
+  WriteBytes(text.data(), text.size());
+}
+
+void AssetCacheWriter::WriteMesh(const Mesh& mesh) {
+  WriteVector(mesh.positions);
+  WriteVector(mesh.normals);
+  WriteVector(mesh.texcoords);
+  WriteVector(mesh.triangles);
+}
+
+void AssetCacheWriter::WriteImage(const Image32& image) {
+  Write<int32_t>(image.width);
+  Write<int32_t>(image.height);
+  WriteVector(image.pixels);
+}
+
+bool AssetCacheReader::ReadBytes(void* out, size_t size) {
+  if (failed_ || size > Remaining()) {
+    failed_ = true;
+    return false;
+  }
+  if (size > 0) {
+    std::memcpy(out, cursor_, size);
+    cursor_ += size;
+  }
+  return true;
+}
+
+bool AssetCacheReader::ReadString(std::string* out_text) {
+  uint64_t size = 0;
+  if (!Read(&size) || size > Remaining()) {
+    failed_ = true;
+    return false;
+  }
+  out_text->assign(reinterpret_cast<const char*>(cursor_), static_cast<size_t>(size));
+  cursor_ += size;
+  return true;
+}
+
+bool AssetCacheReader::ReadMesh(Mesh* out_mesh) {
+  return ReadVector(&out_mesh->positions) && ReadVector(&out_mesh->normals) &&
+         ReadVector(&out_mesh->texcoords) && ReadVector(&out_mesh->triangles);
+}
+
+bool AssetCacheReader::ReadImage(Image32* out_image) {
+  int32_t width = 0;
+  int32_t height = 0;
+  if (!Read(&width) || !Read(&height) || !ReadVector(&out_image->pixels)) {
+    return false;
+  }
+  out_image->width = width;
+  out_image->height = height;
+  return true;
+}
+
+std::string AssetCache::EntryPath(const std::string& key, uint64_t content_hash) const {
+  char hash_text[17] = {};
+  std::snprintf(hash_text, sizeof(hash_text), "%016llx", static_cast<unsigned long long>(content_hash));
+  return (std::filesystem::path(directory_) / (SanitizeKey(key) + "-" + hash_text + ".bin")).string();
+}
+
+bool AssetCache::Load(const std::string& key, uint64_t content_hash, AssetCacheReader* out_reader) {
+  if (!Enabled() || !out_reader) {
+    return false;
+  }
+  AssetCacheReader reader;
+  if (!reader.file_.Open(EntryPath(key, content_hash), nullptr) ||
+      !IsValidEntry(reader.file_, content_hash)) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  reader.cursor_ = reader.file_.Data() + sizeof(EntryHeader);
+  reader.end_ = reader.file_.Data() + reader.file_.Size();
+  *out_reader = std::move(reader);
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool AssetCache::Store(const std::string& key,
+                       uint64_t content_hash,
+                       const AssetCacheWriter& payload,
+                       std::string* out_error) {
+  if (!Enabled()) {
+    return false;
+  }
+  std::error_code ec;
+  std::filesystem::create_directories(directory_, ec);
+
+  // Write to a private temporary and rename it into place so a concurrent or
+  // interrupted run never observes a half-written entry.
+  const std::string path = EntryPath(key, content_hash);
+  std::lock_guard<std::mutex> lock(
+      publish_mutexes_[HashString(key) % publish_mutexes_.size()]);
+  {
+    // Another loader of the same source may have got here first.
+    MappedFile existing;
+    if (existing.Open(path, nullptr) && IsValidEntry(existing, content_hash)) {
+      return true;
+    }
+  }
+  const std::string temp_path =
+      path + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+  {
+    std::ofstream output(temp_path, std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+      if (out_error) {
+        *out_error = "unable to write cache entry: " + temp_path;
+      }
+      return false;
+    }
+    EntryHeader header;
+    header.content_hash = content_hash;
+    header.payload_size = payload.Bytes().size();
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(payload.Bytes().data()),
+                 static_cast<std::streamsize>(payload.Bytes().size()));
+    if (!output) {
+      if (out_error) {
+        *out_error = "unable to write cache entry: " + temp_path;
+      }
+      output.close();
+      std::filesystem::remove(temp_path, ec);
+      return false;
+    }
+  }
+  std::filesystem::rename(temp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    if (out_error) {
+      *out_error = "unable to publish cache entry: " + path;
+    }
+    return false;
+  }
+  RemoveStaleEntries(key, path);
+  return true;
+}
+
+void AssetCache::RemoveStaleEntries(const std::string& key, const std::string& current_path) {
+  const std::string prefix = SanitizeKey(key) + "-";
+  const std::filesystem::path current = std::filesystem::path(current_path).filename();
+  std::error_code ec;
+  std::vector<std::filesystem::path> stale;
+  for (std::filesystem::directory_iterator it(directory_, ec), end; !ec && it != end;
+       it.increment(ec)) {
+    const std::filesystem::path name = it->path().filename();
+    if (name != current && IsEntryFileName(name.string(), prefix)) {
+      stale.push_back(it->path());
+    }
+  }
+  // Best effort: an entry another process still has open may not be removable yet.
+  for (const std::filesystem::path& path : stale) {
+    std::filesystem::remove(path, ec);
+  }
+}
+
+}  // namespace forward::core
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Image32.h"
+#include "MappedFile.h"
+#include "Mesh.h"
+
+namespace forward::core {
+
+// Bump whenever the layout of any cached payload changes; older entries are
+// then treated as misses and rewritten.
+constexpr uint32_t kAssetCacheVersion = 1;
+
+constexpr uint64_t kAssetHashSeed = 0xcbf29ce484222325ull;
+
+// FNV-1a over raw bytes. Chain calls through `seed` to combine inputs.
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed = kAssetHashSeed);
+uint64_t HashString(const std::string& text, uint64_t seed = kAssetHashSeed);
+bool HashFileContents(const std::string& path, uint64_t* out_hash, uint64_t seed = kAssetHashSeed);
+
+class AssetCacheWriter {
+ public:
+  void WriteBytes(const void* data, size_t size);
+
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    WriteBytes(&value, sizeof(T));
+  }
+
+  template <typename T>
+  void WriteVector(const std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    Write<uint64_t>(values.size());
+    WriteBytes(values.data(), values.size() * sizeof(T));
+  }
+
+  void WriteString(const std::string& text);
+  void WriteMesh(const Mesh& mesh);
+  void WriteImage(const Image32& image);
+
+  const std::vector<uint8_t>& Bytes() const { return bytes_; }
+
+ private:
+  std::vector<uint8_t> bytes_;
+};
+
+// Cursor over a mapped cache entry. Every read is bounds-checked; a failed read
+// leaves the reader in a failed state so callers can check once at the end.
+class AssetCacheReader {
+ public:
+  bool ReadBytes(void* out, size_t size);
+
+  template <typename T>
+  bool Read(T* out_value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    return ReadBytes(out_value, sizeof(T));
+  }
+
+  template <typename T>
+  bool ReadVector(std::vector<T>* out_values) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    uint64_t count = 0;
+    if (!Read(&count) || count > Remaining() / (sizeof(T) > 0 ? sizeof(T) : 1)) {
+      failed_ = true;
+      return false;
+    }
+    out_values->resize(static_cast<size_t>(count));
+    return ReadBytes(out_values->data(), static_cast<size_t>(count) * sizeof(T));
+  }
+
+  bool ReadString(std::string* out_text);
+  bool ReadMesh(Mesh* out_mesh);
+  bool ReadImage(Image32* out_image);
+
+  size_t Remaining() const { return static_cast<size_t>(end_ - cursor_); }
+  bool Ok() const { return !failed_; }
+
+ private:
+  friend class AssetCache;
+
+  MappedFile file_;
+  const uint8_t* cursor_ = nullptr;
+  const uint8_t* end_ = nullptr;
+  bool failed_ = false;
+};
+
+// Versioned, content-hashed on-disk cache of parsed and derived assets. Each
+// entry lives in its own file named after its key and the hash of the sources
+// it was built from; publishing an entry deletes the key's older files. Load
+// and Store are safe to call from several loader threads, also for the same
+// key: publishes of one key are serialised and the first one wins.
+class AssetCache {
+ public:
+  // An empty directory disables the cache.
+  void SetDirectory(std::string directory) { directory_ = std::move(directory); }
+  const std::string& Directory() const { return directory_; }
+  bool Enabled() const { return !directory_.empty(); }
+
+  bool Load(const std::string& key, uint64_t content_hash, AssetCacheReader* out_reader);
+  bool Store(const std::string& key,
+             uint64_t content_hash,
+             const AssetCacheWriter& payload,
+             std::string* out_error);
+
+  size_t Hits() const { return hits_.load(std::memory_order_relaxed); }
+  size_t Misses() const { return misses_.load(std::memory_order_relaxed); }
+
+ private:
+  std::string EntryPath(const std::string& key, uint64_t content_hash) const;
+  void RemoveStaleEntries(const std::string& key, const std::string& current_path);
+
+  std::string directory_;
+  // Striped by key hash; held while an entry is written, renamed and pruned.
+  std::array<std::mutex, 16> publish_mutexes_;
+  std::atomic<size_t> hits_{0};
+  std::atomic<size_t> misses_{0};
+};
+
+}  // namespace forward::core
@@ -0,0 +1,199 @@
+#include "BenchReport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <string_view>
+
+#include "TextScan.h"
+
+namespace forward::core {
+namespace {
+
+void SetError(std::string* out_error, const std::string& value) {
+  if (out_error) {
+    *out_error = value;
+  }
+}
+
+double NearestRank(const std::vector<double>& sorted, double percentile) {
+  const double rank = std::ceil(percentile / 100.0 * static_cast<double>(sorted.size()));
+  const size_t index = static_cast<size_t>(std::max(1.0, rank)) - 1;
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+
+// Value of `"key": ...` inside one flat JSON object, without the quotes of a
+// string value.
+std::string_view FindJsonValue(std::string_view object, std::string_view key) {
+  const std::string quoted = "\"" + std::string(key) + "\"";
+  size_t at = object.find(quoted);
+  if (at == std::string_view::npos) {
+    return {};
+  }
+  at = object.find(':', at + quoted.size());
+  if (at == std::string_view::npos) {
+    return {};
+  }
+  at = object.find_first_not_of(" \t\r\n", at + 1);
+  if (at == std::string_view::npos) {
+    return {};
+  }
+  if (object[at] == '"') {
+    const size_t end = object.find('"', at + 1);
+    return (end == std::string_view::npos) ? std::string_view()
+                                           : object.substr(at + 1, end - at - 1);
+  }
+  const size_t end = object.find_first_of(",}\r\n", at);
+  return object.substr(at, end == std::string_view::npos ? std::string_view::npos : end - at);
+}
+
+double JsonNumber(std::string_view object, std::string_view key) {
+  return ParseNumberPrefix<double>(FindJsonValue(object, key), 0.0);
+}
+
+}  // namespace
+
+void FrameTimeHistogram::Add(double frame_ms) {
+  size_t bucket = 0;
+  while (bucket < kFrameTimeBucketsMs.size() && frame_ms > kFrameTimeBucketsMs[bucket]) {
+    ++bucket;
+  }
+  ++counts[bucket];
+}
+
+FrameTimeSummary SummarizeFrameTimes(std::span<const double> frame_ms) {
+  FrameTimeSummary summary;
+  summary.frames = frame_ms.size();
+  if (frame_ms.empty()) {
+    return summary;
+  }
+  std::vector<double> sorted(frame_ms.begin(), frame_ms.end());
+  std::sort(sorted.begin(), sorted.end());
+  summary.mean_ms =
+      std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+  summary.p50_ms = NearestRank(sorted, 50.0);
+  summary.p95_ms = NearestRank(sorted, 95.0);
+  summary.p99_ms = NearestRank(sorted, 99.0);
+  summary.max_ms = sorted.back();
+  summary.fps = (summary.mean_ms > 0.0) ? 1000.0 / summary.mean_ms : 0.0;
+  return summary;
+}
+
+std::string FormatBenchJson(const std::string& suite, std::span<const BenchResult> results) {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(4);
+  out << "{\n  \"suite\": \"" << suite << "\",\n  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const FrameTimeSummary& s = results[i].summary;
+    out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << results[i].name
+        << "\", \"frames\": " << s.frames << ", \"mean_ms\": " << s.mean_ms
+        << ", \"p50_ms\": " << s.p50_ms << ", \"p95_ms\": " << s.p95_ms
+        << ", \"p99_ms\": " << s.p99_ms << ", \"max_ms\": " << s.max_ms << ", \"fps\": " << s.fps
+        << ", \"allocations\": " << results[i].allocations
+        << ", \"allocated_bytes\": " << results[i].allocated_bytes << "}";
+  }
+  out << "\n  ]\n}\n";
+  return out.str();
+}
+
+bool WriteBenchJson(const std::string& path,
+                    const std::string& suite,
+                    std::span<const BenchResult> results,
+                    std::string* out_error) {
+  std::ofstream out(path, std::ios::binary);
+  if (!out.is_open()) {
+    SetError(out_error, "cannot open " + path);
+    return false;
+  }
+  out << FormatBenchJson(suite, results);
+  if (!out.good()) {
+    SetError(out_error, "write failed: " + path);
+    return false;
+  }
+  return true;
+}
+
+bool ReadBenchJson(const std::string& path,
+                   std::vector<BenchResult>* out_results,
+                   std::string* out_error) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) {
+    SetError(out_error, "cannot open " + path);
+    return false;
+  }
+  std::ostringstream buffer;
+  buffer << in.rdbuf();
+  const std::string text = buffer.str();
+  const size_t array = text.find("\"benchmarks\"");
+  if (array == std::string::npos) {
+    SetError(out_error, "no \"benchmarks\" array in " + path);
+    return false;
+  }
+
+  std::vector<BenchResult> results;
+  size_t at = text.find('[', array);
+  while (at != std::string::npos) {
+    const size_t open = text.find_first_of("{]", at + 1);
+    if (open == std::string::npos || text[open] == ']') {
+      break;
+    }
+    const size_t close = text.find('}', open);
+    if (close == std::string::npos) {
+      SetError(out_error, "unterminated record in " + path);
+      return false;
+    }
+    const std::string_view object(text.data() + open, close - open + 1);
+    BenchResult result;
+    result.name = std::string(FindJsonValue(object, "name"));
+    FrameTimeSummary& s = result.summary;
+    s.frames = static_cast<size_t>(JsonNumber(object, "frames"));
+    s.mean_ms = JsonNumber(object, "mean_ms");
+    s.p50_ms = JsonNumber(object, "p50_ms");
+    s.p95_ms = JsonNumber(object, "p95_ms");
+    s.p99_ms = JsonNumber(object, "p99_ms");
+    s.max_ms = JsonNumber(object, "max_ms");
+    s.fps = JsonNumber(object, "fps");
+    result.allocations = static_cast<uint64_t>(JsonNumber(object, "allocations"));
+    result.allocated_bytes = static_cast<uint64_t>(JsonNumber(object, "allocated_bytes"));
+    if (!result.name.empty()) {
+      results.push_back(std::move(result));
+    }
+    at = close;
+  }
+  if (out_results) {
+    *out_results = std::move(results);
+  }
+  return true;
+}
+
+std::vector<BenchRegression> CompareToBaseline(std::span<const BenchResult> current,
+                                               std::span<const BenchResult> baseline,
+                                               double threshold_percent) {
+  std::vector<BenchRegression> regressions;
+  const double limit = 1.0 + std::max(0.0, threshold_percent) / 100.0;
+  for (const BenchResult& result : current) {
+    const auto it = std::find_if(baseline.begin(), baseline.end(), [&](const BenchResult& base) {
+      return base.name == result.name;
+    });
+    if (it == baseline.end()) {
+      continue;
+    }
+    const std::pair<const char*, double FrameTimeSummary::*> metrics[] = {
+        {"mean_ms", &FrameTimeSummary::mean_ms},
+        {"p95_ms", &FrameTimeSummary::p95_ms},
+    };
+    for (const auto& [metric, field] : metrics) {
+      const double base_ms = it->summary.*field;
+      const double current_ms = result.summary.*field;
+      if (base_ms > 0.0 && current_ms > base_ms * limit) {
+        regressions.push_back({result.name, metric, base_ms, current_ms});
+      }
+    }
+  }
+  return regressions;
+}
+
+}  // namespace forward::core
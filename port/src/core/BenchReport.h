@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace forward::core {
+
+struct FrameTimeSummary {
+  size_t frames = 0;
+  double mean_ms = 0.0;
+  double p50_ms = 0.0;
+  double p95_ms = 0.0;
+  double p99_ms = 0.0;
+  double max_ms = 0.0;
+  double fps = 0.0;
+};
+
+// Upper bucket edges in milliseconds; one more bucket counts everything slower.
+inline constexpr std::array<double, 8> kFrameTimeBucketsMs = {4.0,  8.0,  16.7,  20.0,
+                                                              33.3, 50.0, 100.0, 250.0};
+
+struct FrameTimeHistogram {
+  std::array<size_t, kFrameTimeBucketsMs.size() + 1> counts{};
+
+  void Add(double frame_ms);
+  void Clear() { counts.fill(0); }
+};
+
+struct BenchResult {
+  std::string name;
+  FrameTimeSummary summary;
+  // Heap allocations over the timed frames.
+  uint64_t allocations = 0;
+  uint64_t allocated_bytes = 0;
+};
+
+// A metric of one benchmark that grew past the allowed threshold.
+struct BenchRegression {
+  std::string name;
+  std::string metric;
+  double baseline_ms = 0.0;
+  double current_ms = 0.0;
+};
+
+// Nearest-rank percentiles of the frame times, in milliseconds.
+FrameTimeSummary SummarizeFrameTimes(std::span<const double> frame_ms);
+
+// One JSON object with a "benchmarks" array holding a record per result.
+std::string FormatBenchJson(const std::string& suite, std::span<const BenchResult> results);
+bool WriteBenchJson(const std::string& path,
+                    const std::string& suite,
+                    std::span<const BenchResult> results,
+                    std::string* out_error);
+
+// Reads the records back from FormatBenchJson() output. Only that layout is
+// understood; unknown keys are ignored.
+bool ReadBenchJson(const std::string& path,
+                   std::vector<BenchResult>* out_results,
+                   std::string* out_error);
+
+// Mean and p95 of every result that also appears in `baseline` are compared;
+// growth beyond `threshold_percent` is a regression.
+std::vector<BenchRegression> CompareToBaseline(std::span<const BenchResult> current,
+                                               std::span<const BenchResult> baseline,
+                                               double threshold_percent);
+
+}  // namespace forward::core
@@ -0,0 +1,130 @@
+#include "EffectKernels.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include "LegacyPacked10.h"
+
+namespace forward::core {
+
+void WatercubeWaveStep(const std::vector<uint32_t>& src,
+                       std::vector<uint32_t>* dst,
+                       int width,
+                       int height) {
+  if (!dst || src.empty() || dst->empty() || width < 4 || height < 4) {
+    return;
+  }
+
+  const int n3_start = width * 2;
+  const int n4 = width + width;
+  const int n5 = static_cast<int>(legacy10::kCarryMask);
+  const int n6 = n4 - 2;
+  const int n7 = n4 + 2;
+  const int n8 = n4 + n4;
+
+  int n3 = n3_start;
+  for (int n9 = 2; n9 < height - 2; n9 += 2) {
+    int n10 = n3 - n4 + 1;
+    int n11 = n3 + 1;
+    for (int n12 = 1; n12 < width - 1; n12 += 2) {
+      const int n14 = static_cast<int>(src[static_cast<size_t>(n10)]) +
+                      static_cast<int>(src[static_cast<size_t>(n10 + n6)]) +
+                      static_cast<int>(src[static_cast<size_t>(n10 + n7)]) +
+                      static_cast<int>(src[static_cast<size_t>(n10 + n8)]);
+      const int n15 = static_cast<int>((*dst)[static_cast<size_t>(n11)]);
+      const int n16 = (n14 >> 1) + n5 - n15;
+      const int n17 = n16 & n5;
+      const int n13 = n16 & (n17 - (n17 >> 8));
+      (*dst)[static_cast<size_t>(n11 - width)] = static_cast<uint32_t>(n13);
+      (*dst)[static_cast<size_t>(n11 - width + 1)] = static_cast<uint32_t>(n13);
+      (*dst)[static_cast<size_t>(n11++)] = static_cast<uint32_t>(n13);
+      (*dst)[static_cast<size_t>(n11++)] = static_cast<uint32_t>(n13);
+      n10 += 2;
+    }
+    n3 += 2 * width;
+  }
+}
+
+void ApplyFetaIndexedComposite(uint32_t* argb,
+                               int width,
+                               int height,
+                               const uint8_t* src_indices,
+                               uint8_t* dst_indices,
+                               const uint8_t* mesh_mask,
+                               const std::array<uint32_t, 256>& palette_packed10,
+                               uint32_t* packed_frame,
+                               double blackfeta_start_seconds,
+                               double blackmuna_start_seconds,
+                               double scene_seconds) {
+  if (!argb || !src_indices || !dst_indices || !mesh_mask || !packed_frame || width <= 0 ||
+      height <= 0) {
+    return;
+  }
+
+  const size_t pixel_count = static_cast<size_t>(width) * static_cast<size_t>(height);
+  for (size_t i = 0; i < pixel_count; ++i) {
+    const uint32_t c = argb[i];
+    packed_frame[i] = legacy10::PackRgb8To10(static_cast<uint8_t>((c >> 16u) & 0xFFu),
+                                             static_cast<uint8_t>((c >> 8u) & 0xFFu),
+                                             static_cast<uint8_t>(c & 0xFFu));
+  }
+
+  const double scale = 1.0 / 1.100000023841858;
+  const int n26 = static_cast<int>(scale * 65536.0);
+  const int n27 = 0;
+  const int n28 = 0;
+  const int n29 = static_cast<int>(scale * 65536.0);
+  const int cx = width / 2;
+  const int cy = height / 2;
+  int row_u = static_cast<int>((-(cx * scale) * 65536.0) + (cx * 65536.0));
+  int row_v = static_cast<int>((-(cy * scale) * 65536.0) + (cy * 65536.0));
+
+  const bool masked_mode = blackfeta_start_seconds == 0.0;
+  size_t dst_index = 0;
+  for (int y = 0; y < height; ++y) {
+    int u = row_u;
+    int v = row_v;
+    for (int x = 0; x < width; ++x) {
+      if (masked_mode && mesh_mask[dst_index] != 0u) {
+        dst_indices[dst_index] = 255u;
+      } else {
+        const int sx = (u >> 16) & (width - 1);
+        const int sy = (v >> 16) & (height - 1);
+        const uint8_t idx = static_cast<uint8_t>(
+            src_indices[static_cast<size_t>(sy) * static_cast<size_t>(width) +
+                        static_cast<size_t>(sx)] >>
+            1u);
+        dst_indices[dst_index] = idx;
+        if (idx != 0u) {
+          packed_frame[dst_index] =
+              legacy10::AddSaturating(packed_frame[dst_index], palette_packed10[idx]);
+        }
+      }
+      ++dst_index;
+      u += n26;
+      v += n27;
+    }
+    row_u += n28;
+    row_v += n29;
+  }
+
+  if (blackfeta_start_seconds != 0.0) {
+    const int n = static_cast<int>(
+        std::min(255.0, std::max(0.0, (scene_seconds - blackfeta_start_seconds) * 0.7 * 255.0)));
+    int n2 = 0;
+    if (blackmuna_start_seconds != 0.0) {
+      n2 = static_cast<int>(std::min(
+          255.0, std::max(0.0, (scene_seconds - blackmuna_start_seconds) * 0.4 * 255.0)));
+    }
+    const uint32_t dark_feta = legacy10::PackColor24To10(static_cast<uint32_t>(n * 65793));
+    const uint32_t dark_muna = legacy10::PackColor24To10(static_cast<uint32_t>(n2 * 65793));
+    for (size_t i = 0; i < pixel_count; ++i) {
+      const uint32_t dark = (mesh_mask[i] != 0u) ? dark_feta : dark_muna;
+      packed_frame[i] = legacy10::SubSaturating(packed_frame[i], dark);
+    }
+  }
+
+  legacy10::ConvertBufferToArgb(packed_frame, argb, pixel_count);
+}
+
+}  // namespace forward::core
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace forward::core {
+
+// One step of Watercube's ripple propagation between two packed 10-bit height
+// fields of `width` x `height`, writing 2x2 blocks into `dst`.
+void WatercubeWaveStep(const std::vector<uint32_t>& src,
+                       std::vector<uint32_t>* dst,
+                       int width,
+                       int height);
+
+// Feta's indexed feedback composite over a power-of-two `width` x `height`
+// frame: zooms `src_indices` into `dst_indices` (pinning masked pixels to 255
+// while `blackfeta_start_seconds` is zero), adds their palette colors to the
+// frame, applies the blackfeta/blackmuna fades and writes the result back to
+// `argb`. `packed_frame` is scratch of one word per pixel.
+void ApplyFetaIndexedComposite(uint32_t* argb,
+                               int width,
+                               int height,
+                               const uint8_t* src_indices,
+                               uint8_t* dst_indices,
+                               const uint8_t* mesh_mask,
+                               const std::array<uint32_t, 256>& palette_packed10,
+                               uint32_t* packed_frame,
+                               double blackfeta_start_seconds,
+                               double blackmuna_start_seconds,
+                               double scene_seconds);
+
+}  // namespace forward::core
@@ -0,0 +1,66 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+
+namespace forward::core {
+namespace {
+
+constexpr size_t kMinBlockBytes = size_t{64} << 10;
+
+}  // namespace
+
+FrameArena::FrameArena(size_t initial_bytes) {
+  if (initial_bytes > 0) {
+    AddBlock(initial_bytes);
+  }
+}
+
+void* FrameArena::Allocate(size_t bytes, size_t alignment) {
+  while (block_index_ < blocks_.size()) {
+    Block& block = blocks_[block_index_];
+    const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+    const uintptr_t aligned = (base + offset_ + alignment - 1) & ~(uintptr_t{alignment} - 1);
+    const size_t begin = static_cast<size_t>(aligned - base);
+    if (begin <= block.size && bytes <= block.size - begin) {
+      used_ += begin + bytes - offset_;
+      offset_ = begin + bytes;
+      return block.data.get() + begin;
+    }
+    ++block_index_;
+    offset_ = 0;
+  }
+  AddBlock(bytes + alignment);
+  return Allocate(bytes, alignment);
+}
+
+void FrameArena::Reset() {
+  high_water_ = std::max(high_water_, used_);
+  if (block_index_ > 0) {
+    const size_t total = Capacity();
+    blocks_.clear();
+    AddBlock(total);
+  }
+  block_index_ = 0;
+  offset_ = 0;
+  used_ = 0;
+}
+
+size_t FrameArena::Capacity() const {
+  size_t total = 0;
+  for (const Block& block : blocks_) {
+    total += block.size;
+  }
+  return total;
+}
+
+size_t FrameArena::HighWater() const { return std::max(high_water_, used_); }
+
+void FrameArena::AddBlock(size_t min_bytes) {
+  const size_t previous = blocks_.empty() ? 0 : blocks_.back().size;
+  const size_t size = std::max({min_bytes, previous * 2, kMinBlockBytes});
+  blocks_.push_back(Block{std::make_unique_for_overwrite<std::byte[]>(size), size});
+  block_index_ = blocks_.size() - 1;
+  offset_ = 0;
+}
+
+}  // namespace forward::core
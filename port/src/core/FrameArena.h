@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace forward::core {
+
+// Bump allocator for data that lives no longer than one frame. Allocation is
+// an aligned pointer increment and nothing is freed before Reset(), which
+// keeps the memory. A frame that overflows into extra blocks makes Reset()
+// replace them all with one block of the combined size, so steady-state frames
+// run in a single contiguous block without touching the heap. Not thread-safe.
+class FrameArena {
+ public:
+  explicit FrameArena(size_t initial_bytes = 0);
+  FrameArena(const FrameArena&) = delete;
+  FrameArena& operator=(const FrameArena&) = delete;
+  FrameArena(FrameArena&&) noexcept = default;
+  FrameArena& operator=(FrameArena&&) noexcept = default;
+
+  void* Allocate(size_t bytes, size_t alignment);
+  void Reset();
+
+  size_t BytesUsed() const { return used_; }
+  size_t Capacity() const;
+  // Most bytes any frame has used.
+  size_t HighWater() const;
+
+ private:
+  struct Block {
+    std::unique_ptr<std::byte[]> data;
+    size_t size = 0;
+  };
+
+  void AddBlock(size_t min_bytes);
+
+  std::vector<Block> blocks_;
+  size_t block_index_ = 0;
+  size_t offset_ = 0;
+  size_t used_ = 0;
+  size_t high_water_ = 0;
+};
+
+// Standard allocator drawing from a FrameArena; deallocate() is a no-op. With
+// no arena it falls back to the heap, so one container type serves both.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  ArenaAllocator() noexcept = default;
+  explicit ArenaAllocator(FrameArena* arena) noexcept : arena_(arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+  T* allocate(size_t count) {
+    if (count > static_cast<size_t>(-1) / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    if (!arena_) {
+      return std::allocator<T>().allocate(count);
+    }
+    return static_cast<T*>(arena_->Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* pointer, size_t count) noexcept {
+    if (!arena_) {
+      std::allocator<T>().deallocate(pointer, count);
+    }
+  }
+
+  // Elements created without a value are default-initialised, so scratch
+  // buffers sized up front are not zero-filled first.
+  template <typename U>
+  void construct(U* pointer) noexcept(noexcept(::new(static_cast<void*>(pointer)) U)) {
+    ::new (static_cast<void*>(pointer)) U;
+  }
+  template <typename U, typename... Args>
+  void construct(U* pointer, Args&&... args) {
+    ::new (static_cast<void*>(pointer)) U(std::forward<Args>(args)...);
+  }
+
+  FrameArena* arena() const noexcept { return arena_; }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ == other.arena();
+  }
+
+ private:
+  FrameArena* arena_ = nullptr;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+}  // namespace forward::core
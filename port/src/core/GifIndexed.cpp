@@ -4,33 +4,16 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
-#include <fstream>
 #include <string>
 #include <vector>
 
+#include "Image32.h"
+#include "MappedFile.h"
+
 namespace forward::core {
 namespace {
 
-bool ReadFileBytes(const std::string& path, std::vector<uint8_t>* out_bytes) {
-  if (!out_bytes) {
-    return false;
-  }
-  std::ifstream input(path, std::ios::binary);
-  if (!input.is_open()) {
-    return false;
-  }
-  input.seekg(0, std::ios::end);
-  const std::streamoff size = input.tellg();
-  if (size <= 0) {
-    return false;
-  }
-  input.seekg(0, std::ios::beg);
-  out_bytes->resize(static_cast<size_t>(size));
-  input.read(reinterpret_cast<char*>(out_bytes->data()), size);
-  return input.good() || input.gcount() == size;
-}
-
-bool ReadU16LE(const std::vector<uint8_t>& bytes, size_t* offset, uint16_t* out_value) {
+bool ReadU16LE(std::span<const uint8_t> bytes, size_t* offset, uint16_t* out_value) {
   if (!offset || !out_value || *offset + 2 > bytes.size()) {
     return false;
   }
@@ -41,7 +24,7 @@ bool ReadU16LE(const std::vector<uint8_t>& bytes, size_t* offset, uint16_t* out_
   return true;
 }
 
-bool SkipGifSubBlocks(const std::vector<uint8_t>& bytes, size_t* offset) {
+bool SkipGifSubBlocks(std::span<const uint8_t> bytes, size_t* offset) {
   if (!offset) {
     return false;
   }
@@ -59,7 +42,7 @@ bool SkipGifSubBlocks(const std::vector<uint8_t>& bytes, size_t* offset) {
   return false;
 }
 
-bool ReadColorTable(const std::vector<uint8_t>& bytes,
+bool ReadColorTable(std::span<const uint8_t> bytes,
                     size_t* offset,
                     int color_count,
                     std::array<uint8_t, 256>* out_r,
@@ -82,157 +65,53 @@ bool ReadColorTable(const std::vector<uint8_t>& bytes,
   return true;
 }
 
-bool DecodeGifLzw(const std::vector<uint8_t>& compressed,
-                  int min_code_size,
-                  size_t expected_pixels,
-                  std::vector<uint8_t>* out_indices,
-                  std::string* out_error) {
-  if (!out_indices || min_code_size < 2 || min_code_size > 8) {
+bool ReadGifFile(const std::string& path,
+                 const char* caller,
+                 MappedFile* out_file,
+                 GifLzwFrame* out_frame,
+                 std::string* out_error) {
+  if (!out_file->Open(path, nullptr)) {
     if (out_error) {
-      *out_error = "unsupported GIF LZW minimum code size";
+      *out_error = std::string(caller) + ": unable to read " + path;
     }
     return false;
   }
+  return ReadGifFirstFrameLzw(
+      std::span<const uint8_t>(out_file->Data(), out_file->Size()), out_frame, out_error);
+}
 
-  constexpr int kMaxCodes = 4096;
-  const int clear_code = 1 << min_code_size;
-  const int end_code = clear_code + 1;
-
-  std::array<uint16_t, kMaxCodes> prefix{};
-  std::array<uint8_t, kMaxCodes> suffix{};
-  std::array<uint8_t, kMaxCodes> stack{};
-
-  for (int i = 0; i < clear_code; ++i) {
-    suffix[static_cast<size_t>(i)] = static_cast<uint8_t>(i);
-  }
-
-  int code_size = min_code_size + 1;
-  int next_code = end_code + 1;
-  size_t bit_pos = 0;
-
-  auto read_code = [&]() -> int {
-    if (bit_pos + static_cast<size_t>(code_size) > compressed.size() * 8u) {
-      return -1;
-    }
-    int value = 0;
-    for (int i = 0; i < code_size; ++i) {
-      const size_t bit_index = bit_pos + static_cast<size_t>(i);
-      const size_t byte_index = bit_index >> 3u;
-      const int bit_in_byte = static_cast<int>(bit_index & 7u);
-      value |= ((compressed[byte_index] >> bit_in_byte) & 1u) << i;
-    }
-    bit_pos += static_cast<size_t>(code_size);
-    return value;
-  };
-
-  out_indices->clear();
-  out_indices->reserve(expected_pixels);
-
-  int old_code = -1;
-  uint8_t first_char = 0;
-
-  while (out_indices->size() < expected_pixels) {
-    const int code = read_code();
-    if (code < 0) {
-      break;
-    }
-
-    if (code == clear_code) {
-      code_size = min_code_size + 1;
-      next_code = end_code + 1;
-      old_code = -1;
-      continue;
-    }
-    if (code == end_code) {
-      break;
-    }
-
-    if (old_code == -1) {
-      if (code >= clear_code) {
-        if (out_error) {
-          *out_error = "GIF LZW stream has invalid first code";
-        }
-        return false;
-      }
-      first_char = suffix[static_cast<size_t>(code)];
-      out_indices->push_back(first_char);
-      old_code = code;
-      continue;
-    }
-
-    int in_code = code;
-    int stack_size = 0;
-    int traverse_code = code;
-
-    if (traverse_code >= next_code) {
-      stack[static_cast<size_t>(stack_size++)] = first_char;
-      traverse_code = old_code;
-    }
-
-    while (traverse_code >= clear_code) {
-      if (traverse_code < 0 || traverse_code >= next_code || stack_size >= kMaxCodes) {
-        if (out_error) {
-          *out_error = "GIF LZW stream traversal failed";
-        }
-        return false;
-      }
-      stack[static_cast<size_t>(stack_size++)] = suffix[static_cast<size_t>(traverse_code)];
-      traverse_code = static_cast<int>(prefix[static_cast<size_t>(traverse_code)]);
-    }
-
-    if (traverse_code < 0 || traverse_code >= clear_code || stack_size >= kMaxCodes) {
-      if (out_error) {
-        *out_error = "GIF LZW stream root code failed";
-      }
-      return false;
-    }
-    first_char = suffix[static_cast<size_t>(traverse_code)];
-    stack[static_cast<size_t>(stack_size++)] = first_char;
-
-    while (stack_size > 0 && out_indices->size() < expected_pixels) {
-      out_indices->push_back(stack[static_cast<size_t>(--stack_size)]);
-    }
-
-    if (next_code < kMaxCodes) {
-      prefix[static_cast<size_t>(next_code)] = static_cast<uint16_t>(old_code);
-      suffix[static_cast<size_t>(next_code)] = first_char;
-      ++next_code;
-      if (next_code == (1 << code_size) && code_size < 12) {
-        ++code_size;
+// Copies stream-order rows of an interlaced frame to their display rows.
+void DeinterlaceRows(const uint8_t* src,
+                     int width,
+                     int height,
+                     uint8_t* dst,
+                     size_t dst_stride,
+                     int dst_width,
+                     int dst_height) {
+  const int copy_w = std::min(width, dst_width);
+  size_t src_row = 0;
+  auto write_pass = [&](int start_row, int step) {
+    for (int y = start_row; y < height; y += step) {
+      if (y < dst_height && copy_w > 0) {
+        std::copy_n(src + src_row * static_cast<size_t>(width),
+                    copy_w,
+                    dst + static_cast<size_t>(y) * dst_stride);
       }
+      ++src_row;
     }
-
-    old_code = in_code;
-  }
-
-  if (out_indices->size() < expected_pixels) {
-    if (out_error) {
-      *out_error = "GIF LZW stream ended before expected pixel count";
-    }
-    return false;
-  }
-  if (out_indices->size() > expected_pixels) {
-    out_indices->resize(expected_pixels);
-  }
-  return true;
+  };
+  write_pass(0, 8);
+  write_pass(4, 8);
+  write_pass(2, 4);
+  write_pass(1, 2);
 }
 
 }  // namespace
 
-bool LoadGifIndexed8FirstFrame(const std::string& path,
-                               IndexedImage8* out_image,
-                               std::string* out_error) {
-  if (!out_image) {
+bool ReadGifFirstFrameLzw(std::span<const uint8_t> bytes, GifLzwFrame* out_frame, std::string* out_error) {
+  if (!out_frame) {
     if (out_error) {
-      *out_error = "LoadGifIndexed8FirstFrame: out_image is null";
-    }
-    return false;
-  }
-
-  std::vector<uint8_t> bytes;
-  if (!ReadFileBytes(path, &bytes)) {
-    if (out_error) {
-      *out_error = "LoadGifIndexed8FirstFrame: unable to read " + path;
+      *out_error = "ReadGifFirstFrameLzw: out_frame is null";
     }
     return false;
   }
@@ -265,6 +144,7 @@ bool LoadGifIndexed8FirstFrame(const std::string& path,
     return false;
   }
   const uint8_t packed = bytes[offset++];
+  const uint8_t background_index = bytes[offset];
   offset += 2;  // background color index + pixel aspect ratio.
 
   std::array<uint8_t, 256> global_r{};
@@ -282,6 +162,7 @@ bool LoadGifIndexed8FirstFrame(const std::string& path,
     }
   }
 
+  int transparent_index = -1;
   while (offset < bytes.size()) {
     const uint8_t block_id = bytes[offset++];
     if (block_id == 0x3Bu) {  // Trailer
@@ -291,7 +172,11 @@ bool LoadGifIndexed8FirstFrame(const std::string& path,
       if (offset >= bytes.size()) {
         break;
       }
-      offset += 1;  // Extension label
+      const uint8_t label = bytes[offset++];
+      // Graphic control extension: block size 4, then flags, delay, transparent index.
+      if (label == 0xF9u && offset + 5 <= bytes.size() && bytes[offset] == 4u) {
+        transparent_index = (bytes[offset + 1] & 0x01u) != 0u ? bytes[offset + 4] : -1;
+      }
       if (!SkipGifSubBlocks(bytes, &offset)) {
         if (out_error) {
           *out_error = "LoadGifIndexed8FirstFrame: invalid extension sub-blocks";
@@ -326,23 +211,26 @@ bool LoadGifIndexed8FirstFrame(const std::string& path,
     }
     const uint8_t image_packed = bytes[offset++];
     const bool has_local_table = (image_packed & 0x80u) != 0u;
-    const bool is_interlaced = (image_packed & 0x40u) != 0u;
-
-    std::array<uint8_t, 256> palette_r = global_r;
-    std::array<uint8_t, 256> palette_g = global_g;
-    std::array<uint8_t, 256> palette_b = global_b;
-    int palette_count = global_color_count;
 
+    out_frame->palette_r = global_r;
+    out_frame->palette_g = global_g;
+    out_frame->palette_b = global_b;
+    out_frame->palette_count = global_color_count;
     if (has_local_table) {
-      palette_count = 1 << ((image_packed & 0x07u) + 1);
-      if (!ReadColorTable(bytes, &offset, palette_count, &palette_r, &palette_g, &palette_b)) {
+      out_frame->palette_count = 1 << ((image_packed & 0x07u) + 1);
+      if (!ReadColorTable(bytes,
+                          &offset,
+                          out_frame->palette_count,
+                          &out_frame->palette_r,
+                          &out_frame->palette_g,
+                          &out_frame->palette_b)) {
         if (out_error) {
           *out_error = "LoadGifIndexed8FirstFrame: invalid local color table";
         }
         return false;
       }
     }
-    if (palette_count <= 0) {
+    if (out_frame->palette_count <= 0) {
       if (out_error) {
         *out_error = "LoadGifIndexed8FirstFrame: no palette available";
       }
@@ -354,9 +242,10 @@ bool LoadGifIndexed8FirstFrame(const std::string& path,
       }
       return false;
     }
-    const int min_code_size = static_cast<int>(bytes[offset++]);
+    out_frame->min_code_size = static_cast<int>(bytes[offset++]);
 
-    std::vector<uint8_t> compressed;
+    out_frame->compressed.clear();
+    out_frame->compressed.reserve(bytes.size() - offset);
     while (offset < bytes.size()) {
       const uint8_t block_size = bytes[offset++];
       if (block_size == 0) {
@@ -368,63 +257,295 @@ bool LoadGifIndexed8FirstFrame(const std::string& path,
         }
         return false;
       }
-      compressed.insert(
-          compressed.end(), bytes.begin() + static_cast<std::ptrdiff_t>(offset),
-          bytes.begin() + static_cast<std::ptrdiff_t>(offset + block_size));
+      const std::span<const uint8_t> block = bytes.subspan(offset, block_size);
+      out_frame->compressed.insert(out_frame->compressed.end(), block.begin(), block.end());
       offset += block_size;
     }
 
-    const size_t pixel_count =
-        static_cast<size_t>(std::max<uint16_t>(1, image_width)) *
-        static_cast<size_t>(std::max<uint16_t>(1, image_height));
-    std::vector<uint8_t> decoded;
-    if (!DecodeGifLzw(compressed, min_code_size, pixel_count, &decoded, out_error)) {
+    out_frame->width = static_cast<int>(image_width);
+    out_frame->height = static_cast<int>(image_height);
+    out_frame->interlaced = (image_packed & 0x40u) != 0u;
+    out_frame->left = static_cast<int>(image_left);
+    out_frame->top = static_cast<int>(image_top);
+    out_frame->screen_width = static_cast<int>(logical_width);
+    out_frame->screen_height = static_cast<int>(logical_height);
+    out_frame->transparent_index = transparent_index;
+    out_frame->background_argb =
+        background_index > 0
+            ? 0xFF000000u | (static_cast<uint32_t>(global_r[background_index]) << 16u) |
+                  (static_cast<uint32_t>(global_g[background_index]) << 8u) |
+                  static_cast<uint32_t>(global_b[background_index])
+            : 0u;
+    return true;
+  }
+
+  if (out_error) {
+    *out_error = "LoadGifIndexed8FirstFrame: no image frame found";
+  }
+  return false;
+}
+
+bool DecodeGifLzw(std::span<const uint8_t> compressed,
+                  int min_code_size,
+                  uint8_t* out_indices,
+                  size_t pixel_count,
+                  std::string* out_error) {
+  if (!out_indices || min_code_size < 2 || min_code_size > 8) {
+    if (out_error) {
+      *out_error = "unsupported GIF LZW minimum code size";
+    }
+    return false;
+  }
+
+  constexpr int kMaxCodes = 4096;
+  const int clear_code = 1 << min_code_size;
+  const int end_code = clear_code + 1;
+
+  // Each dictionary entry stores its length and first byte so strings can be
+  // written back-to-front straight into the output, without a reversal stack.
+  std::array<uint16_t, kMaxCodes> prefix{};
+  std::array<uint16_t, kMaxCodes> length{};
+  std::array<uint8_t, kMaxCodes> suffix{};
+  std::array<uint8_t, kMaxCodes> first{};
+  for (int i = 0; i < clear_code; ++i) {
+    suffix[static_cast<size_t>(i)] = static_cast<uint8_t>(i);
+    first[static_cast<size_t>(i)] = static_cast<uint8_t>(i);
+    length[static_cast<size_t>(i)] = 1;
+  }
+
+  int code_size = min_code_size + 1;
+  uint32_t code_mask = (1u << code_size) - 1u;
+  int next_code = end_code + 1;
+
+  // Codes are packed LSB-first; keep up to 64 bits buffered and refill a byte at
+  // a time only when fewer bits than one code remain.
+  const uint8_t* in = compressed.data();
+  const size_t in_size = compressed.size();
+  size_t in_pos = 0;
+  uint64_t bits = 0;
+  int bit_count = 0;
+
+  size_t out_pos = 0;
+  int old_code = -1;
+
+  while (out_pos < pixel_count) {
+    if (bit_count < code_size) {
+      while (bit_count <= 56 && in_pos < in_size) {
+        bits |= static_cast<uint64_t>(in[in_pos++]) << bit_count;
+        bit_count += 8;
+      }
+      if (bit_count < code_size) {
+        break;
+      }
+    }
+    const int code = static_cast<int>(static_cast<uint32_t>(bits) & code_mask);
+    bits >>= code_size;
+    bit_count -= code_size;
+
+    if (code == clear_code) {
+      code_size = min_code_size + 1;
+      code_mask = (1u << code_size) - 1u;
+      next_code = end_code + 1;
+      old_code = -1;
+      continue;
+    }
+    if (code == end_code) {
+      break;
+    }
+
+    if (old_code == -1) {
+      if (code >= clear_code) {
+        if (out_error) {
+          *out_error = "GIF LZW stream has invalid first code";
+        }
+        return false;
+      }
+      out_indices[out_pos++] = suffix[static_cast<size_t>(code)];
+      old_code = code;
+      continue;
+    }
+    if (code > next_code) {
+      if (out_error) {
+        *out_error = "GIF LZW stream traversal failed";
+      }
+      return false;
+    }
+
+    // code == next_code is the KwKwK case: the string of old_code followed by its
+    // own first byte.
+    const bool repeat_first = code == next_code;
+    const int string_code = repeat_first ? old_code : code;
+    const size_t string_length = length[static_cast<size_t>(string_code)];
+    const size_t room = pixel_count - out_pos;
+    uint8_t* dst = out_indices + out_pos;
+    if (repeat_first && string_length < room) {
+      dst[string_length] = first[static_cast<size_t>(old_code)];
+    }
+    int walk = string_code;
+    size_t i = string_length;
+    while (i > room) {
+      walk = prefix[static_cast<size_t>(walk)];
+      --i;
+    }
+    while (i > 0) {
+      dst[--i] = suffix[static_cast<size_t>(walk)];
+      walk = prefix[static_cast<size_t>(walk)];
+    }
+    out_pos += std::min(string_length + (repeat_first ? 1u : 0u), room);
+
+    if (next_code < kMaxCodes) {
+      const size_t entry = static_cast<size_t>(next_code);
+      prefix[entry] = static_cast<uint16_t>(old_code);
+      suffix[entry] = first[static_cast<size_t>(string_code)];
+      first[entry] = first[static_cast<size_t>(old_code)];
+      length[entry] = static_cast<uint16_t>(length[static_cast<size_t>(old_code)] + 1u);
+      ++next_code;
+      if (next_code == (1 << code_size) && code_size < 12) {
+        ++code_size;
+        code_mask = (1u << code_size) - 1u;
+      }
+    }
+
+    old_code = code;
+  }
+
+  if (out_pos < pixel_count) {
+    if (out_error) {
+      *out_error = "GIF LZW stream ended before expected pixel count";
+    }
+    return false;
+  }
+  return true;
+}
+
+bool LoadGifIndexed8FirstFrame(const std::string& path,
+                               IndexedImage8* out_image,
+                               std::string* out_error) {
+  if (!out_image) {
+    if (out_error) {
+      *out_error = "LoadGifIndexed8FirstFrame: out_image is null";
+    }
+    return false;
+  }
+
+  MappedFile file;
+  GifLzwFrame frame;
+  if (!ReadGifFile(path, "LoadGifIndexed8FirstFrame", &file, &frame, out_error)) {
+    return false;
+  }
+
+  const size_t pixel_count = frame.PixelCount();
+  if (frame.interlaced) {
+    std::vector<uint8_t> decoded(pixel_count);
+    if (!DecodeGifLzw(frame.compressed, frame.min_code_size, decoded.data(), pixel_count, out_error)) {
       if (out_error && out_error->empty()) {
         *out_error = "LoadGifIndexed8FirstFrame: GIF LZW decode failed";
       }
       return false;
     }
-
-    out_image->width = static_cast<int>(image_width);
-    out_image->height = static_cast<int>(image_height);
     out_image->indices.assign(pixel_count, 0u);
+    DeinterlaceRows(decoded.data(),
+                    frame.width,
+                    frame.height,
+                    out_image->indices.data(),
+                    static_cast<size_t>(std::max(0, frame.width)),
+                    frame.width,
+                    frame.height);
+  } else {
+    out_image->indices.resize(pixel_count);
+    if (!DecodeGifLzw(
+            frame.compressed, frame.min_code_size, out_image->indices.data(), pixel_count, out_error)) {
+      if (out_error && out_error->empty()) {
+        *out_error = "LoadGifIndexed8FirstFrame: GIF LZW decode failed";
+      }
+      return false;
+    }
+  }
 
-    if (is_interlaced) {
-      size_t src_index = 0;
-      auto write_pass = [&](int start_row, int step) {
-        for (int y = start_row; y < out_image->height; y += step) {
-          const size_t row_offset = static_cast<size_t>(y) * static_cast<size_t>(out_image->width);
-          for (int x = 0; x < out_image->width && src_index < decoded.size(); ++x) {
-            out_image->indices[row_offset + static_cast<size_t>(x)] = decoded[src_index++];
-          }
-        }
-      };
-      write_pass(0, 8);
-      write_pass(4, 8);
-      write_pass(2, 4);
-      write_pass(1, 2);
-    } else {
-      out_image->indices = std::move(decoded);
-    }
-
-    for (int i = 0; i < 256; ++i) {
-      const int palette_index = std::min(i, palette_count - 1);
-      out_image->palette_r[static_cast<size_t>(i)] = palette_r[static_cast<size_t>(palette_index)];
-      out_image->palette_g[static_cast<size_t>(i)] = palette_g[static_cast<size_t>(palette_index)];
-      out_image->palette_b[static_cast<size_t>(i)] = palette_b[static_cast<size_t>(palette_index)];
-    }
-    (void)logical_width;
-    (void)logical_height;
-    (void)image_left;
-    (void)image_top;
-    return true;
+  out_image->width = frame.width;
+  out_image->height = frame.height;
+  for (int i = 0; i < 256; ++i) {
+    const int palette_index = std::min(i, frame.palette_count - 1);
+    out_image->palette_r[static_cast<size_t>(i)] = frame.palette_r[static_cast<size_t>(palette_index)];
+    out_image->palette_g[static_cast<size_t>(i)] = frame.palette_g[static_cast<size_t>(palette_index)];
+    out_image->palette_b[static_cast<size_t>(i)] = frame.palette_b[static_cast<size_t>(palette_index)];
   }
+  return true;
+}
 
-  if (out_error) {
-    *out_error = "LoadGifIndexed8FirstFrame: no image frame found";
+bool LoadGifFirstFrame32(const std::string& path, Image32* out_image, std::string* out_error) {
+  if (!out_image) {
+    if (out_error) {
+      *out_error = "LoadGifFirstFrame32: out_image is null";
+    }
+    return false;
   }
-  return false;
+
+  MappedFile file;
+  GifLzwFrame frame;
+  if (!ReadGifFile(path, "LoadGifFirstFrame32", &file, &frame, out_error)) {
+    return false;
+  }
+  if (frame.screen_width <= 0 || frame.screen_height <= 0) {
+    if (out_error) {
+      *out_error = "LoadGifFirstFrame32: empty logical screen in " + path;
+    }
+    return false;
+  }
+
+  const size_t pixel_count = frame.PixelCount();
+  std::vector<uint8_t> indices(pixel_count);
+  std::vector<uint8_t> decoded;
+  uint8_t* target = indices.data();
+  if (frame.interlaced) {
+    decoded.resize(pixel_count);
+    target = decoded.data();
+  }
+  if (!DecodeGifLzw(frame.compressed, frame.min_code_size, target, pixel_count, out_error)) {
+    if (out_error && out_error->empty()) {
+      *out_error = "LoadGifFirstFrame32: GIF LZW decode failed";
+    }
+    return false;
+  }
+  if (frame.interlaced) {
+    DeinterlaceRows(decoded.data(),
+                    frame.width,
+                    frame.height,
+                    indices.data(),
+                    static_cast<size_t>(std::max(0, frame.width)),
+                    frame.width,
+                    frame.height);
+  }
+
+  // Entries past the colour table and the transparent index are not drawn.
+  std::array<uint32_t, 256> argb{};
+  for (int i = 0; i < frame.palette_count; ++i) {
+    const size_t entry = static_cast<size_t>(i);
+    argb[entry] = 0xFF000000u | (static_cast<uint32_t>(frame.palette_r[entry]) << 16u) |
+                  (static_cast<uint32_t>(frame.palette_g[entry]) << 8u) |
+                  static_cast<uint32_t>(frame.palette_b[entry]);
+  }
+  if (frame.transparent_index >= 0) {
+    argb[static_cast<size_t>(frame.transparent_index)] = 0u;
+  }
+
+  out_image->width = frame.screen_width;
+  out_image->height = frame.screen_height;
+  out_image->pixels.assign(
+      static_cast<size_t>(frame.screen_width) * static_cast<size_t>(frame.screen_height), frame.background_argb);
+  const int x0 = std::min(frame.left, frame.screen_width);
+  const int x1 = std::min(frame.left + frame.width, frame.screen_width);
+  const int y1 = std::min(frame.top + frame.height, frame.screen_height);
+  for (int y = frame.top; y < y1; ++y) {
+    const uint8_t* src = indices.data() + static_cast<size_t>(y - frame.top) *
+                                              static_cast<size_t>(frame.width);
+    uint32_t* dst = out_image->pixels.data() + static_cast<size_t>(y) *
+                                                   static_cast<size_t>(frame.screen_width);
+    for (int x = x0; x < x1; ++x) {
+      dst[x] = argb[src[x - frame.left]];
+    }
+  }
+  return true;
 }
 
 }  // namespace forward::core
-
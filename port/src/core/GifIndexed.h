@@ -1,12 +1,16 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace forward::core {
 
+struct Image32;
+
 struct IndexedImage8 {
   int width = 0;
   int height = 0;
@@ -18,10 +22,50 @@ struct IndexedImage8 {
   bool Empty() const { return width <= 0 || height <= 0 || indices.empty(); }
 };
 
-// Loads first GIF image block as palette-indexed 8-bit data.
+// First image block of a GIF with its sub-block framing stripped, ready for
+// DecodeGifLzw. The palette is the local table if present, else the global one.
+// `transparent_index` is -1 unless a graphic control extension precedes the image;
+// `background_argb` is the global table's background entry, or 0 for index 0.
+struct GifLzwFrame {
+  int width = 0;
+  int height = 0;
+  int left = 0;
+  int top = 0;
+  int screen_width = 0;
+  int screen_height = 0;
+  int transparent_index = -1;
+  uint32_t background_argb = 0;
+  bool interlaced = false;
+  int min_code_size = 0;
+  std::vector<uint8_t> compressed;
+  int palette_count = 0;
+  std::array<uint8_t, 256> palette_r{};
+  std::array<uint8_t, 256> palette_g{};
+  std::array<uint8_t, 256> palette_b{};
+
+  size_t PixelCount() const {
+    return static_cast<size_t>(width > 0 ? width : 1) * static_cast<size_t>(height > 0 ? height : 1);
+  }
+};
+
+bool ReadGifFirstFrameLzw(std::span<const uint8_t> bytes, GifLzwFrame* out_frame, std::string* out_error);
+
+// Decodes a GIF LZW stream into exactly `pixel_count` indices at `out_indices`,
+// in stream order (no de-interlacing).
+bool DecodeGifLzw(std::span<const uint8_t> compressed,
+                  int min_code_size,
+                  uint8_t* out_indices,
+                  size_t pixel_count,
+                  std::string* out_error);
+
+// Loads first GIF image block as palette-indexed 8-bit data. The image's index
+// buffer is decoded into in place, so reusing an image reuses its storage.
 bool LoadGifIndexed8FirstFrame(const std::string& path,
                                IndexedImage8* out_image,
                                std::string* out_error);
 
-}  // namespace forward::core
+// Loads the first GIF frame as ARGB on its logical screen, as stb_image does:
+// pixels outside the frame take `background_argb` and transparent ones stay 0.
+bool LoadGifFirstFrame32(const std::string& path, Image32* out_image, std::string* out_error);
 
+}  // namespace forward::core
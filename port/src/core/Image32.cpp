@@ -1,13 +1,35 @@
 #include "Image32.h"
 
+#include <algorithm>
+#include <cctype>
 #include <string>
 
+#include "GifIndexed.h"
+
 #define STB_IMAGE_IMPLEMENTATION
 #include "../../third_party/stb_image.h"
 
 namespace forward::core {
+namespace {
+
+bool HasGifExtension(const std::string& path) {
+  if (path.size() < 4) {
+    return false;
+  }
+  return std::equal(path.end() - 4, path.end(), ".gif", [](char a, char b) {
+    return std::tolower(static_cast<unsigned char>(a)) == b;
+  });
+}
+
+}  // namespace
 
 bool LoadImage32(const std::string& path, Image32& out_image, std::string* out_error) {
+  // GIFs take the indexed LZW decoder; stb_image stays as the fallback for
+  // anything it rejects.
+  if (HasGifExtension(path) && LoadGifFirstFrame32(path, &out_image, nullptr)) {
+    return true;
+  }
+
   int width = 0;
   int height = 0;
   int channels = 0;
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "Image32.h"
+
+namespace forward::core {
+
+// Non-owning view of ARGB pixels. `stride` is the distance between rows in
+// pixels, so a view can cover a sub-rectangle of a larger image without
+// copying it. The viewed pixels must outlive the view.
+struct ImageView {
+  const uint32_t* pixels = nullptr;
+  int width = 0;
+  int height = 0;
+  int stride = 0;
+
+  ImageView() = default;
+  ImageView(const uint32_t* view_pixels, int view_width, int view_height, int view_stride)
+      : pixels(view_pixels), width(view_width), height(view_height), stride(view_stride) {}
+  ImageView(const uint32_t* view_pixels, int view_width, int view_height)
+      : ImageView(view_pixels, view_width, view_height, view_width) {}
+  // Implicit so an Image32 can be passed anywhere a view is expected.
+  ImageView(const Image32& image)
+      : pixels(image.Empty() ? nullptr : image.pixels.data()),
+        width(image.Empty() ? 0 : image.width),
+        height(image.Empty() ? 0 : image.height),
+        stride(image.Empty() ? 0 : image.width) {}
+
+  bool Empty() const { return !pixels || width <= 0 || height <= 0; }
+
+  const uint32_t* Row(int y) const {
+    return pixels + static_cast<size_t>(y) * static_cast<size_t>(stride);
+  }
+  uint32_t At(int x, int y) const { return Row(y)[x]; }
+
+  // Clipped to the view; an out-of-range rectangle yields an empty view.
+  ImageView SubRect(int x, int y, int w, int h) const {
+    if (Empty()) {
+      return {};
+    }
+    const int x0 = std::clamp(x, 0, width);
+    const int y0 = std::clamp(y, 0, height);
+    const int x1 = std::clamp(x + w, x0, width);
+    const int y1 = std::clamp(y + h, y0, height);
+    if (x1 <= x0 || y1 <= y0) {
+      return {};
+    }
+    return ImageView(Row(y0) + x0, x1 - x0, y1 - y0, stride);
+  }
+
+  ImageView TopHalf() const { return SubRect(0, 0, width, height / 2); }
+  // For odd heights the middle row belongs to neither half.
+  ImageView BottomHalf() const { return SubRect(0, height - height / 2, width, height / 2); }
+};
+
+}  // namespace forward::core
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstddef>
 
+#include "Profiler.h"
 #include "Surface32.h"
 
 namespace forward::core {
@@ -110,6 +111,7 @@ void IndexedSurface8::BlitImageAt(const IndexedImage8& src, int dst_x, int dst_y
 }
 
 void IndexedSurface8::PresentToBack(Surface32& destination) const {
+  FORWARD_PROFILE_ZONE("IndexedSurface8::PresentToBack");
   if (width_ <= 0 || height_ <= 0 || destination.width() <= 0 || destination.height() <= 0) {
     return;
   }
@@ -16,6 +16,7 @@ class IndexedSurface8 {
 
   int width() const { return width_; }
   int height() const { return height_; }
+  uint8_t* IndicesMutable() { return indices_.data(); }
 
   void SetPalette(const std::array<uint8_t, 256>& r,
                   const std::array<uint8_t, 256>& g,
@@ -0,0 +1,160 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace forward::core {
+
+MappedFile::~MappedFile() { Close(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    Close();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    open_ = std::exchange(other.open_, false);
+#if defined(_WIN32)
+    file_handle_ = std::exchange(other.file_handle_, nullptr);
+    mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+#endif
+  }
+  return *this;
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::Open(const std::string& path, std::string* out_error) {
+  Close();
+  HANDLE file = CreateFileA(path.c_str(),
+                            GENERIC_READ,
+                            FILE_SHARE_READ,
+                            nullptr,
+                            OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    if (out_error) {
+      *out_error = "unable to open file: " + path;
+    }
+    return false;
+  }
+  LARGE_INTEGER file_size{};
+  if (!GetFileSizeEx(file, &file_size)) {
+    CloseHandle(file);
+    if (out_error) {
+      *out_error = "unable to stat file: " + path;
+    }
+    return false;
+  }
+
+  file_handle_ = file;
+  open_ = true;
+  size_ = static_cast<size_t>(file_size.QuadPart);
+  if (size_ == 0) {
+    return true;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    Close();
+    if (out_error) {
+      *out_error = "unable to map file: " + path;
+    }
+    return false;
+  }
+  mapping_handle_ = mapping;
+  data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!data_) {
+    Close();
+    if (out_error) {
+      *out_error = "unable to map file: " + path;
+    }
+    return false;
+  }
+  return true;
+}
+
+void MappedFile::Close() {
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_handle_) {
+    CloseHandle(static_cast<HANDLE>(mapping_handle_));
+  }
+  if (file_handle_) {
+    CloseHandle(static_cast<HANDLE>(file_handle_));
+  }
+  data_ = nullptr;
+  size_ = 0;
+  open_ = false;
+  file_handle_ = nullptr;
+  mapping_handle_ = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path, std::string* out_error) {
+  Close();
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    if (out_error) {
+      *out_error = "unable to open file: " + path;
+    }
+    return false;
+  }
+  struct stat info {};
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    if (out_error) {
+      *out_error = "unable to stat file: " + path;
+    }
+    return false;
+  }
+
+  size_ = static_cast<size_t>(info.st_size);
+  if (size_ > 0) {
+    void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+      ::close(fd);
+      size_ = 0;
+      if (out_error) {
+        *out_error = "unable to map file: " + path;
+      }
+      return false;
+    }
+    data_ = static_cast<const uint8_t*>(mapped);
+  }
+  // The mapping keeps its own reference to the file.
+  ::close(fd);
+  open_ = true;
+  return true;
+}
+
+void MappedFile::Close() {
+  if (data_) {
+    ::munmap(const_cast<uint8_t*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  open_ = false;
+}
+
+#endif
+
+}  // namespace forward::core
@@ -24,12 +24,10 @@ float Mesh::BoundingRadius() const {
   return std::sqrt(radius_sq);
 }
 
-void Mesh::RebuildVertexNormals() {
-  normals.assign(positions.size(), Vec3{});
-  if (positions.empty() || triangles.empty()) {
-    return;
-  }
-
+void ComputeVertexNormals(std::span<const Vec3> positions,
+                          std::span<const Triangle> triangles,
+                          std::span<Vec3> out_normals) {
+  std::fill(out_normals.begin(), out_normals.end(), Vec3{});
   for (const Triangle& tri : triangles) {
     const size_t ia = static_cast<size_t>(tri.a);
     const size_t ib = static_cast<size_t>(tri.b);
@@ -42,14 +40,22 @@ void Mesh::RebuildVertexNormals() {
     const Vec3& b = positions[ib];
     const Vec3& c = positions[ic];
     const Vec3 face = (b - a).Cross(c - a);
-    normals[ia] = normals[ia] + face;
-    normals[ib] = normals[ib] + face;
-    normals[ic] = normals[ic] + face;
+    out_normals[ia] = out_normals[ia] + face;
+    out_normals[ib] = out_normals[ib] + face;
+    out_normals[ic] = out_normals[ic] + face;
   }
 
-  for (Vec3& n : normals) {
+  for (Vec3& n : out_normals) {
     n = n.Normalized();
   }
 }
 
+void Mesh::RebuildVertexNormals() {
+  normals.assign(positions.size(), Vec3{});
+  if (positions.empty() || triangles.empty()) {
+    return;
+  }
+  ComputeVertexNormals(positions, triangles, normals);
+}
+
 }  // namespace forward::core
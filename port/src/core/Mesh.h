@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <vector>
 
 #include "Vec2.h"
@@ -13,6 +14,11 @@ struct Triangle {
   int c = 0;
 };
 
+// Area-weighted smooth normals; `out_normals` must hold one entry per position.
+void ComputeVertexNormals(std::span<const Vec3> positions,
+                          std::span<const Triangle> triangles,
+                          std::span<Vec3> out_normals);
+
 class Mesh {
  public:
   void Clear();
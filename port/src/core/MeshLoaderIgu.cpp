@@ -1,12 +1,15 @@
 #include "MeshLoaderIgu.h"
 
-#include <cerrno>
-#include <cstdlib>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
 #include <cstring>
-#include <fstream>
 #include <sstream>
-#include <utility>
-#include <vector>
+#include <string_view>
+#include <system_error>
+
+#include "MappedFile.h"
+#include "TextScan.h"
 
 namespace forward::core {
 namespace {
@@ -18,42 +21,35 @@ enum class ParseBlock {
   kFaces,
 };
 
-std::vector<float> ExtractFloats(const std::string& line) {
-  std::vector<float> values;
-  const char* p = line.c_str();
-  while (*p != '\0') {
-    errno = 0;
-    char* end = nullptr;
-    const float value = std::strtof(p, &end);
-    if (end != p) {
-      if (errno == 0) {
-        values.push_back(value);
-      }
-      p = end;
-      continue;
-    }
-    ++p;
-  }
-  return values;
+bool IsNumberStart(char c) {
+  return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.';
 }
 
-std::vector<int> ExtractInts(const std::string& line) {
-  std::vector<int> values;
-  const char* p = line.c_str();
-  while (*p != '\0') {
-    errno = 0;
-    char* end = nullptr;
-    const long value = std::strtol(p, &end, 0);
-    if (end != p) {
-      if (errno == 0) {
-        values.push_back(static_cast<int>(value));
-      }
-      p = end;
+// Pulls up to `max_count` numbers out of `line`, skipping any labels or
+// punctuation in between ("X: 1.0, Y: 2.0", "A 3, B 4, C 5"). Out-of-range
+// values are skipped like the strtof/strtol path used to.
+template <typename T>
+size_t ExtractNumbers(std::string_view line, T* out_values, size_t max_count) {
+  const char* p = line.data();
+  const char* const end = p + line.size();
+  size_t count = 0;
+  while (p < end && count < max_count) {
+    if (!IsNumberStart(*p)) {
+      ++p;
       continue;
     }
-    ++p;
+    T value{};
+    const std::from_chars_result result = ScanNumber(p, end, &value);
+    if (result.ptr == p) {
+      ++p;
+      continue;
+    }
+    if (result.ec == std::errc()) {
+      out_values[count++] = value;
+    }
+    p = result.ptr;
   }
-  return values;
+  return count;
 }
 
 std::string MakeError(const std::string& path, int line_no, const std::string& message) {
@@ -64,12 +60,13 @@ std::string MakeError(const std::string& path, int line_no, const std::string& m
 
 }  // namespace
 
-bool LoadIguMesh(const std::string& path, Mesh& out_mesh, std::string* out_error) {
-  std::ifstream input(path);
-  if (!input.is_open()) {
-    if (out_error) {
-      *out_error = "unable to open file: " + path;
-    }
+bool LoadIguMesh(const std::string& path,
+                 Mesh& out_mesh,
+                 std::string* out_error,
+                 IguLoadStats* out_stats) {
+  const auto begin_time = std::chrono::steady_clock::now();
+  MappedFile file;
+  if (!file.Open(path, out_error)) {
     return false;
   }
 
@@ -80,15 +77,21 @@ bool LoadIguMesh(const std::string& path, Mesh& out_mesh, std::string* out_error
   int vertex_block_count = 0;
   int line_no = 0;
 
-  std::string line;
-  while (std::getline(input, line)) {
+  const char* cursor = reinterpret_cast<const char*>(file.Data());
+  const char* const end = cursor + file.Size();
+  while (cursor < end) {
+    const char* newline =
+        static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+    const char* line_end = newline ? newline : end;
+    const std::string_view line(cursor, static_cast<size_t>(line_end - cursor));
+    cursor = newline ? newline + 1 : end;
     ++line_no;
 
     if (lines_remaining > 0) {
       switch (block) {
         case ParseBlock::kPositions: {
-          const std::vector<float> values = ExtractFloats(line);
-          if (values.size() < 3) {
+          float values[3];
+          if (ExtractNumbers(line, values, 3) < 3) {
             if (out_error) {
               *out_error = MakeError(path, line_no, "invalid vertex line");
             }
@@ -98,8 +101,8 @@ bool LoadIguMesh(const std::string& path, Mesh& out_mesh, std::string* out_error
           break;
         }
         case ParseBlock::kTexcoords: {
-          const std::vector<float> values = ExtractFloats(line);
-          if (values.size() < 2) {
+          float values[2];
+          if (ExtractNumbers(line, values, 2) < 2) {
             if (out_error) {
               *out_error = MakeError(path, line_no, "invalid texcoord line");
             }
@@ -109,8 +112,8 @@ bool LoadIguMesh(const std::string& path, Mesh& out_mesh, std::string* out_error
           break;
         }
         case ParseBlock::kFaces: {
-          const std::vector<int> values = ExtractInts(line);
-          if (values.size() < 3) {
+          int values[3];
+          if (ExtractNumbers(line, values, 3) < 3) {
             if (out_error) {
               *out_error = MakeError(path, line_no, "invalid face line");
             }
@@ -130,30 +133,30 @@ bool LoadIguMesh(const std::string& path, Mesh& out_mesh, std::string* out_error
       continue;
     }
 
-    if (line.find("Vertices:") != std::string::npos) {
-      const std::vector<int> values = ExtractInts(line);
-      if (values.empty()) {
+    if (line.find("Vertices:") != std::string_view::npos) {
+      int count = 0;
+      if (ExtractNumbers(line, &count, 1) == 0) {
         continue;
       }
-      lines_remaining = values.front();
+      lines_remaining = count;
       ++vertex_block_count;
       block = (vertex_block_count == 1) ? ParseBlock::kPositions : ParseBlock::kTexcoords;
       if (block == ParseBlock::kPositions) {
-        out_mesh.positions.reserve(static_cast<size_t>(lines_remaining));
+        out_mesh.positions.reserve(static_cast<size_t>(std::max(0, lines_remaining)));
       } else {
-        out_mesh.texcoords.reserve(static_cast<size_t>(lines_remaining));
+        out_mesh.texcoords.reserve(static_cast<size_t>(std::max(0, lines_remaining)));
       }
       continue;
     }
 
-    if (line.find("Faces:") != std::string::npos) {
-      const std::vector<int> values = ExtractInts(line);
-      if (values.empty()) {
+    if (line.find("Faces:") != std::string_view::npos) {
+      int count = 0;
+      if (ExtractNumbers(line, &count, 1) == 0) {
         continue;
       }
-      lines_remaining = values.front();
+      lines_remaining = count;
       block = ParseBlock::kFaces;
-      out_mesh.triangles.reserve(static_cast<size_t>(lines_remaining));
+      out_mesh.triangles.reserve(static_cast<size_t>(std::max(0, lines_remaining)));
       continue;
     }
   }
@@ -178,6 +181,11 @@ bool LoadIguMesh(const std::string& path, Mesh& out_mesh, std::string* out_error
 
   out_mesh.RebuildVertexNormals();
 
+  if (out_stats) {
+    out_stats->bytes = file.Size();
+    out_stats->seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - begin_time).count();
+  }
   return true;
 }
 
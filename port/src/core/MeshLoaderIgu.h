@@ -1,11 +1,25 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 #include "Mesh.h"
 
 namespace forward::core {
 
-bool LoadIguMesh(const std::string& path, Mesh& out_mesh, std::string* out_error);
+struct IguLoadStats {
+  size_t bytes = 0;
+  double seconds = 0.0;
+
+  double MegabytesPerSecond() const {
+    return seconds > 0.0 ? static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds : 0.0;
+  }
+};
+
+// Parses a `3DSRDR` text dump straight out of a read-only mapping of the file.
+bool LoadIguMesh(const std::string& path,
+                 Mesh& out_mesh,
+                 std::string* out_error,
+                 IguLoadStats* out_stats = nullptr);
 
 }  // namespace forward::core
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstddef>
+
+namespace forward::core {
+
+// Resident set size of this process in bytes, or 0 where it cannot be read.
+size_t ResidentSetBytes();
+
+}  // namespace forward::core
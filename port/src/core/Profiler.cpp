@@ -0,0 +1,184 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+#include "SpscQueue.h"
+
+namespace forward::core {
+namespace {
+
+constexpr size_t kRingCapacity = size_t{1} << 14;
+
+void SetError(std::string* out_error, const std::string& value) {
+  if (out_error) {
+    *out_error = value;
+  }
+}
+
+struct ThreadRing {
+  SpscQueue<ProfileEvent> events;
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadRing>> rings;
+  // Rings of exited threads, handed to the next thread that is named.
+  std::vector<ThreadRing*> free_rings;
+  // Indexed by thread id - 1.
+  std::vector<std::string> thread_names;
+  std::unordered_set<std::string> interned;
+  std::atomic<size_t> dropped{0};
+};
+
+// Never destroyed, so threads still recording during static destruction are safe.
+Registry& GetRegistry() {
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+struct ThreadSlot {
+  ThreadRing* ring = nullptr;
+  uint32_t id = 0;
+  std::string name;
+
+  ~ThreadSlot() {
+    if (ring) {
+      Registry& registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      registry.free_rings.push_back(ring);
+    }
+  }
+};
+
+thread_local ThreadSlot t_slot;
+
+// Called with the registry mutex held.
+void AttachRing(Registry& registry, ThreadSlot* slot) {
+  slot->id = static_cast<uint32_t>(registry.thread_names.size() + 1);
+  registry.thread_names.push_back(slot->name);
+  if (!registry.free_rings.empty()) {
+    slot->ring = registry.free_rings.back();
+    registry.free_rings.pop_back();
+    return;
+  }
+  registry.rings.push_back(std::make_unique<ThreadRing>());
+  slot->ring = registry.rings.back().get();
+  slot->ring->events.Reset(kRingCapacity);
+}
+
+void WriteJsonString(std::ostream& out, std::string_view text) {
+  out << '"';
+  for (const char c : text) {
+    if (c == '"' || c == '\\') {
+      out << '\\';
+    }
+    out << c;
+  }
+  out << '"';
+}
+
+}  // namespace
+
+void Profiler::SetEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+uint64_t Profiler::NowNs() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
+void Profiler::Record(const char* name, uint64_t begin_ns, uint64_t end_ns) {
+  ThreadSlot& slot = t_slot;
+  // Threads that never named themselves have no ring; their zones count as lost
+  // rather than taking the registry lock here.
+  if (!slot.ring || !slot.ring->events.TryPush(ProfileEvent{name, slot.id, begin_ns, end_ns})) {
+    GetRegistry().dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void Profiler::SetThreadName(std::string_view name) {
+  ThreadSlot& slot = t_slot;
+  slot.name = std::string(name);
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if (!slot.ring) {
+    AttachRing(registry, &slot);
+    return;
+  }
+  registry.thread_names[slot.id - 1] = slot.name;
+}
+
+const char* Profiler::Intern(std::string_view name) {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.interned.emplace(name).first->c_str();
+}
+
+size_t Profiler::Collect(std::vector<ProfileEvent>* out_events) {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  ProfileEvent event;
+  for (const std::unique_ptr<ThreadRing>& ring : registry.rings) {
+    while (ring->events.TryPop(&event)) {
+      if (out_events) {
+        out_events->push_back(event);
+      }
+    }
+  }
+  return registry.dropped.exchange(0, std::memory_order_relaxed);
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path,
+                                const std::vector<ProfileEvent>& events,
+                                std::string* out_error) {
+  std::ofstream out(path, std::ios::binary);
+  if (!out.is_open()) {
+    SetError(out_error, "cannot open " + path);
+    return false;
+  }
+
+  uint64_t base_ns = events.empty() ? 0 : events.front().begin_ns;
+  for (const ProfileEvent& event : events) {
+    base_ns = std::min(base_ns, event.begin_ns);
+  }
+
+  std::vector<std::string> thread_names;
+  {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    thread_names = registry.thread_names;
+  }
+
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  bool first = true;
+  for (size_t i = 0; i < thread_names.size(); ++i) {
+    out << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, "
+        << "\"tid\": " << (i + 1) << ", \"args\": {\"name\": ";
+    WriteJsonString(out, thread_names[i]);
+    out << "}}";
+    first = false;
+  }
+  for (const ProfileEvent& event : events) {
+    out << (first ? "\n" : ",\n") << "{\"name\": ";
+    WriteJsonString(out, event.name ? event.name : "");
+    out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << event.thread_id
+        << ", \"ts\": " << static_cast<double>(event.begin_ns - base_ns) / 1000.0
+        << ", \"dur\": " << static_cast<double>(event.end_ns - event.begin_ns) / 1000.0 << "}";
+    first = false;
+  }
+  out << "\n]}\n";
+  if (!out.good()) {
+    SetError(out_error, "write failed: " + path);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace forward::core
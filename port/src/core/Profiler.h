@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef FORWARD_PROFILING
+#define FORWARD_PROFILING 0
+#endif
+
+namespace forward::core {
+
+struct ProfileEvent {
+  // A string literal or a Profiler::Intern() result; never freed.
+  const char* name = nullptr;
+  uint32_t thread_id = 0;
+  uint64_t begin_ns = 0;
+  uint64_t end_ns = 0;
+};
+
+// Process-wide recorder for scoped timing zones. Every thread pushes finished
+// zones into its own lock-free ring, so recording never blocks or allocates;
+// one consumer thread drains all rings with Collect() often enough that they do
+// not fill. A thread gets its ring from SetThreadName(), which it must call
+// before its first zone; zones from unnamed threads count as lost. Nothing is
+// recorded until SetEnabled(true).
+class Profiler {
+ public:
+  static bool Enabled() { return enabled_.load(std::memory_order_relaxed); }
+  static void SetEnabled(bool enabled);
+
+  static uint64_t NowNs();
+  static void Record(const char* name, uint64_t begin_ns, uint64_t end_ns);
+
+  // Names the calling thread in exported traces and attaches its ring. Call at
+  // thread start, not from latency-sensitive code.
+  static void SetThreadName(std::string_view name);
+  // Returns a stable copy of `name` for zones named at run time.
+  static const char* Intern(std::string_view name);
+
+  // Appends every recorded zone to `out_events`. Returns the number of zones
+  // lost to full rings since the previous call.
+  static size_t Collect(std::vector<ProfileEvent>* out_events);
+
+  // Chrome/Perfetto trace-event JSON, one complete ("X") event per zone.
+  static bool WriteChromeTrace(const std::string& path,
+                               const std::vector<ProfileEvent>& events,
+                               std::string* out_error);
+
+ private:
+  static inline std::atomic<bool> enabled_{false};
+};
+
+class ProfileZone {
+ public:
+  explicit ProfileZone(const char* name)
+      : name_(Profiler::Enabled() ? name : nullptr), begin_ns_(name_ ? Profiler::NowNs() : 0) {}
+  ~ProfileZone() {
+    if (name_) {
+      Profiler::Record(name_, begin_ns_, Profiler::NowNs());
+    }
+  }
+
+  ProfileZone(const ProfileZone&) = delete;
+  ProfileZone& operator=(const ProfileZone&) = delete;
+
+ private:
+  const char* name_;
+  uint64_t begin_ns_;
+};
+
+}  // namespace forward::core
+
+// Zones compile to nothing unless the build defines FORWARD_PROFILING=1.
+#if FORWARD_PROFILING
+#define FORWARD_PROFILE_CONCAT_INNER(a, b) a##b
+#define FORWARD_PROFILE_CONCAT(a, b) FORWARD_PROFILE_CONCAT_INNER(a, b)
+#define FORWARD_PROFILE_ZONE(name) \
+  const ::forward::core::ProfileZone FORWARD_PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#define FORWARD_PROFILE_THREAD(name) ::forward::core::Profiler::SetThreadName(name)
+#else
+#define FORWARD_PROFILE_ZONE(name) static_cast<void>(0)
+#define FORWARD_PROFILE_THREAD(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cmath>
+
+#include "Vec3.h"
+
+namespace forward::core {
+
+// Rotation quaternion; the default value is the identity.
+struct Quat {
+  float x = 0.0f;
+  float y = 0.0f;
+  float z = 0.0f;
+  float w = 1.0f;
+};
+
+inline Quat QuatNormalize(const Quat& q) {
+  const float len_sq = q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
+  if (len_sq <= 1e-12f) {
+    return {};
+  }
+  const float inv_len = 1.0f / std::sqrt(len_sq);
+  return Quat{q.x * inv_len, q.y * inv_len, q.z * inv_len, q.w * inv_len};
+}
+
+inline Quat QuatConjugate(const Quat& q) { return Quat{-q.x, -q.y, -q.z, q.w}; }
+
+inline Quat QuatMul(const Quat& a, const Quat& b) {
+  return Quat{
+      a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+      a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+      a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+      a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+  };
+}
+
+inline Quat QuatFromAxisAngle(const Vec3& axis, float angle_radians) {
+  Vec3 n = axis.Normalized();
+  if (n.LengthSq() <= 1e-12f) {
+    n = Vec3(0.0f, 0.0f, 1.0f);
+  }
+  const float half = angle_radians * 0.5f;
+  const float s = std::sin(half);
+  return QuatNormalize(Quat{n.x * s, n.y * s, n.z * s, std::cos(half)});
+}
+
+inline Vec3 RotateByQuat(const Vec3& v, const Quat& q) {
+  const Quat p{v.x, v.y, v.z, 0.0f};
+  const Quat out = QuatMul(QuatMul(q, p), QuatConjugate(q));
+  return Vec3(out.x, out.y, out.z);
+}
+
+}  // namespace forward::core
@@ -0,0 +1,153 @@
+#include "RenderPassGraph.h"
+
+#include <algorithm>
+
+#include "Profiler.h"
+
+namespace forward::core {
+
+RenderPassGraph::RenderPassGraph(int target_width, int target_height, int worker_count) {
+  for (int i = 0; i < worker_count; ++i) {
+    contexts_.push_back(std::make_unique<Renderer3D>(target_width, target_height));
+  }
+  for (const std::unique_ptr<Renderer3D>& context : contexts_) {
+    workers_.emplace_back(&RenderPassGraph::WorkerLoop, this, std::ref(*context));
+  }
+}
+
+RenderPassGraph::~RenderPassGraph() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  work_cv_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void RenderPassGraph::AddPassRecord(const char* name,
+                                    std::initializer_list<const void*> reads,
+                                    std::initializer_list<const void*> writes,
+                                    void* closure,
+                                    Invoke invoke) {
+  Pass pass;
+  pass.name = name;
+  pass.closure = closure;
+  pass.invoke = invoke;
+  pass.reads_begin = resources_.size();
+  resources_.insert(resources_.end(), reads.begin(), reads.end());
+  pass.writes_begin = resources_.size();
+  resources_.insert(resources_.end(), writes.begin(), writes.end());
+  pass.writes_end = resources_.size();
+  passes_.push_back(pass);
+}
+
+bool RenderPassGraph::Conflicts(const Pass& earlier, const Pass& later) const {
+  const auto touches = [this](size_t begin, size_t end, const void* resource) {
+    return std::find(resources_.begin() + static_cast<ptrdiff_t>(begin),
+                     resources_.begin() + static_cast<ptrdiff_t>(end),
+                     resource) != resources_.begin() + static_cast<ptrdiff_t>(end);
+  };
+  for (size_t i = earlier.writes_begin; i < earlier.writes_end; ++i) {
+    if (touches(later.reads_begin, later.writes_end, resources_[i])) {
+      return true;
+    }
+  }
+  for (size_t i = earlier.reads_begin; i < earlier.writes_begin; ++i) {
+    if (touches(later.writes_begin, later.writes_end, resources_[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void RenderPassGraph::BuildDependencies() {
+  dependents_.clear();
+  for (size_t earlier = 0; earlier < passes_.size(); ++earlier) {
+    passes_[earlier].dependents_begin = dependents_.size();
+    for (size_t later = earlier + 1; later < passes_.size(); ++later) {
+      if (Conflicts(passes_[earlier], passes_[later])) {
+        dependents_.push_back(later);
+        ++passes_[later].pending;
+      }
+    }
+    passes_[earlier].dependents_end = dependents_.size();
+  }
+}
+
+void RenderPassGraph::Execute(Renderer3D& renderer) {
+  if (workers_.empty() || renderer.OverdrawView()) {
+    for (const Pass& pass : passes_) {
+      FORWARD_PROFILE_ZONE(pass.name);
+      pass.invoke(pass.closure, renderer);
+    }
+  } else if (!passes_.empty()) {
+    BuildDependencies();
+    for (const std::unique_ptr<Renderer3D>& context : contexts_) {
+      context->BeginFrame();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_.clear();
+    ready_head_ = 0;
+    completed_ = 0;
+    for (size_t i = 0; i < passes_.size(); ++i) {
+      if (passes_[i].pending == 0) {
+        ready_.push_back(i);
+      }
+    }
+    work_cv_.notify_all();
+    while (completed_ < passes_.size()) {
+      if (ready_head_ < ready_.size()) {
+        RunPass(ready_[ready_head_++], renderer, lock);
+      } else {
+        done_cv_.wait(lock);
+      }
+    }
+    lock.unlock();
+    for (const std::unique_ptr<Renderer3D>& context : contexts_) {
+      renderer.AddFrameStats(context->FrameStats());
+    }
+  }
+  passes_.clear();
+  resources_.clear();
+  closures_.Reset();
+}
+
+void RenderPassGraph::RunPass(size_t index,
+                              Renderer3D& renderer,
+                              std::unique_lock<std::mutex>& lock) {
+  const Pass& pass = passes_[index];
+  lock.unlock();
+  {
+    FORWARD_PROFILE_ZONE(pass.name);
+    pass.invoke(pass.closure, renderer);
+  }
+  lock.lock();
+  ++completed_;
+  bool queued = false;
+  for (size_t i = pass.dependents_begin; i < pass.dependents_end; ++i) {
+    if (--passes_[dependents_[i]].pending == 0) {
+      ready_.push_back(dependents_[i]);
+      queued = true;
+    }
+  }
+  if (queued) {
+    work_cv_.notify_all();
+  }
+  done_cv_.notify_one();
+}
+
+void RenderPassGraph::WorkerLoop(Renderer3D& renderer) {
+  FORWARD_PROFILE_THREAD("render worker");
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    work_cv_.wait(lock, [this] { return stopping_ || ready_head_ < ready_.size(); });
+    if (stopping_) {
+      return;
+    }
+    RunPass(ready_[ready_head_++], renderer, lock);
+  }
+}
+
+}  // namespace forward::core
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "FrameArena.h"
+#include "Renderer3D.h"
+
+namespace forward::core {
+
+// One frame's passes and the resources they touch. A pass runs after every
+// earlier pass that writes what it reads or writes, or reads what it writes;
+// passes with no such conflict run concurrently on the worker threads and the
+// calling thread. Resources are any object addresses: surfaces, textures,
+// scene buffers. Each thread draws through its own Renderer3D, so passes must
+// not share one.
+class RenderPassGraph {
+ public:
+  // `worker_count` threads besides the caller; 0 runs every pass in order on
+  // the calling thread.
+  RenderPassGraph(int target_width, int target_height, int worker_count);
+  ~RenderPassGraph();
+  RenderPassGraph(const RenderPassGraph&) = delete;
+  RenderPassGraph& operator=(const RenderPassGraph&) = delete;
+
+  // `name` must outlive Execute(). `run` is copied into per-frame storage and
+  // never destroyed, so it may only capture trivially destructible state.
+  template <typename Run>
+  void AddPass(const char* name,
+               std::initializer_list<const void*> reads,
+               std::initializer_list<const void*> writes,
+               Run run) {
+    static_assert(std::is_trivially_destructible_v<Run>, "pass closures are never destroyed");
+    void* storage = closures_.Allocate(sizeof(Run), alignof(Run));
+    Run* copy = ::new (storage) Run(std::move(run));
+    AddPassRecord(name, reads, writes, copy, [](void* closure, Renderer3D& renderer) {
+      (*static_cast<Run*>(closure))(renderer);
+    });
+  }
+
+  // Runs and forgets every pass added since the last call. `renderer` is the
+  // calling thread's context and collects the frame's RenderStats from all of
+  // them. With its overdraw view on, passes run in order on it alone, so the
+  // heat map sees every pass.
+  void Execute(Renderer3D& renderer);
+
+  int WorkerCount() const { return static_cast<int>(workers_.size()); }
+
+ private:
+  using Invoke = void (*)(void* closure, Renderer3D& renderer);
+
+  struct Pass {
+    const char* name = nullptr;
+    void* closure = nullptr;
+    Invoke invoke = nullptr;
+    size_t reads_begin = 0;
+    size_t writes_begin = 0;
+    size_t writes_end = 0;
+    size_t dependents_begin = 0;
+    size_t dependents_end = 0;
+    int pending = 0;
+  };
+
+  void AddPassRecord(const char* name,
+                     std::initializer_list<const void*> reads,
+                     std::initializer_list<const void*> writes,
+                     void* closure,
+                     Invoke invoke);
+  bool Conflicts(const Pass& earlier, const Pass& later) const;
+  void BuildDependencies();
+  // Runs `index` and queues the passes it unblocks; `lock` is held on entry
+  // and exit but not while the pass runs.
+  void RunPass(size_t index, Renderer3D& renderer, std::unique_lock<std::mutex>& lock);
+  void WorkerLoop(Renderer3D& renderer);
+
+  std::vector<Pass> passes_;
+  std::vector<const void*> resources_;
+  std::vector<size_t> dependents_;
+  FrameArena closures_;
+
+  std::vector<std::thread> workers_;
+  std::vector<std::unique_ptr<Renderer3D>> contexts_;
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  std::vector<size_t> ready_;
+  size_t ready_head_ = 0;
+  size_t completed_ = 0;
+  bool stopping_ = false;
+};
+
+}  // namespace forward::core
@@ -0,0 +1,76 @@
+#include "RenderTargetPool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace forward::core {
+
+RenderTargetPool::Lease::Lease(Lease&& other) noexcept
+    : pool_(std::exchange(other.pool_, nullptr)), surface_(std::exchange(other.surface_, nullptr)) {}
+
+RenderTargetPool::Lease& RenderTargetPool::Lease::operator=(Lease&& other) noexcept {
+  if (this != &other) {
+    if (pool_) {
+      pool_->Release(surface_);
+    }
+    pool_ = std::exchange(other.pool_, nullptr);
+    surface_ = std::exchange(other.surface_, nullptr);
+  }
+  return *this;
+}
+
+RenderTargetPool::Lease::~Lease() {
+  if (pool_) {
+    pool_->Release(surface_);
+  }
+}
+
+RenderTargetPool::RenderTargetPool(int idle_frames) : idle_frames_(std::max(1, idle_frames)) {}
+
+RenderTargetPool::Lease RenderTargetPool::Acquire(int width, int height) {
+  Target* found = nullptr;
+  for (Target& target : targets_) {
+    if (!target.in_use && target.surface->width() == width && target.surface->height() == height) {
+      found = &target;
+      break;
+    }
+  }
+  if (!found) {
+    targets_.push_back(Target{std::make_unique<Surface32>(width, height, false)});
+    found = &targets_.back();
+  }
+  found->in_use = true;
+  found->last_used_frame = frame_;
+  peak_in_use_ = std::max(peak_in_use_, ++in_use_);
+  return Lease(this, found->surface.get());
+}
+
+void RenderTargetPool::EndFrame() {
+  ++frame_;
+  std::erase_if(targets_, [this](const Target& target) {
+    return !target.in_use &&
+           frame_ - target.last_used_frame > static_cast<uint64_t>(idle_frames_);
+  });
+}
+
+size_t RenderTargetPool::ResidentBytes() const {
+  size_t bytes = 0;
+  for (const Target& target : targets_) {
+    bytes += static_cast<size_t>(target.surface->width()) *
+             static_cast<size_t>(target.surface->height()) * sizeof(uint32_t);
+  }
+  return bytes;
+}
+
+void RenderTargetPool::Release(Surface32* surface) {
+  for (Target& target : targets_) {
+    if (target.surface.get() == surface) {
+      target.in_use = false;
+      target.last_used_frame = frame_;
+      --in_use_;
+      return;
+    }
+  }
+}
+
+}  // namespace forward::core
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Surface32.h"
+
+namespace forward::core {
+
+// Single-buffered offscreen surfaces handed out for the length of one pass.
+// A target released by one pass is the next same-sized pass's target, within
+// a frame and across scenes, so only as many surfaces exist as are in use at
+// once. Targets no pass has acquired for `idle_frames` EndFrame() calls are
+// freed. Acquired contents are undefined; clear before reading.
+class RenderTargetPool {
+ public:
+  // Returns its surface to the pool when destroyed.
+  class Lease {
+   public:
+    Lease() = default;
+    Lease(Lease&& other) noexcept;
+    Lease& operator=(Lease&& other) noexcept;
+    ~Lease();
+
+    Surface32& operator*() const { return *surface_; }
+    Surface32* operator->() const { return surface_; }
+    Surface32* get() const { return surface_; }
+
+   private:
+    friend class RenderTargetPool;
+    Lease(RenderTargetPool* pool, Surface32* surface) : pool_(pool), surface_(surface) {}
+
+    RenderTargetPool* pool_ = nullptr;
+    Surface32* surface_ = nullptr;
+  };
+
+  explicit RenderTargetPool(int idle_frames = 120);
+  RenderTargetPool(const RenderTargetPool&) = delete;
+  RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+  Lease Acquire(int width, int height);
+  void EndFrame();
+
+  size_t TargetCount() const { return targets_.size(); }
+  size_t ResidentBytes() const;
+  // Most targets leased at the same time since the pool was created.
+  size_t PeakInUse() const { return peak_in_use_; }
+
+ private:
+  struct Target {
+    std::unique_ptr<Surface32> surface;
+    bool in_use = false;
+    uint64_t last_used_frame = 0;
+  };
+
+  void Release(Surface32* surface);
+
+  std::vector<Target> targets_;
+  int idle_frames_ = 0;
+  uint64_t frame_ = 0;
+  size_t in_use_ = 0;
+  size_t peak_in_use_ = 0;
+};
+
+}  // namespace forward::core
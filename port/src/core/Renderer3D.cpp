@@ -1,12 +1,11 @@
 #include "Renderer3D.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <limits>
 #include <vector>
 
-#include "Image32.h"
-
 namespace forward::core {
 namespace {
 
@@ -56,7 +55,7 @@ uint32_t ModulateColor(uint32_t base, float intensity) {
   return PackArgb(r, g, b);
 }
 
-uint32_t SampleTexture(const Image32& image, float u, float v, bool wrap) {
+uint32_t SampleTexture(const ImageView& image, float u, float v, bool wrap) {
   if (image.Empty()) {
     return 0xFFFFFFFFu;
   }
@@ -76,33 +75,71 @@ uint32_t SampleTexture(const Image32& image, float u, float v, bool wrap) {
   const int y = std::clamp(static_cast<int>(sv * static_cast<float>(image.height - 1)),
                            0,
                            image.height - 1);
-  return image.pixels[static_cast<size_t>(y) * static_cast<size_t>(image.width) +
-                      static_cast<size_t>(x)];
+  return image.At(x, y);
 }
 
+// Writes 1..8+ from cold to hot.
+constexpr std::array<uint32_t, 8> kOverdrawColors = {
+    0xFF102080u, 0xFF1060E0u, 0xFF10B040u, 0xFF90D010u,
+    0xFFF0D010u, 0xFFF08010u, 0xFFE01010u, 0xFFFFFFFFu,
+};
+
 }  // namespace
 
+void RenderStats::Add(const RenderStats& other) {
+  draws += other.draws;
+  triangles_submitted += other.triangles_submitted;
+  triangles_near_rejected += other.triangles_near_rejected;
+  triangles_near_clipped += other.triangles_near_clipped;
+  triangles_backface_culled += other.triangles_backface_culled;
+  triangles_zero_area += other.triangles_zero_area;
+  pixels_tested += other.pixels_tested;
+  pixels_depth_rejected += other.pixels_depth_rejected;
+  pixels_shaded += other.pixels_shaded;
+}
+
 Renderer3D::Renderer3D(int target_width, int target_height)
     : target_width_(target_width), target_height_(target_height) {}
 
+void Renderer3D::BeginFrame() {
+  frame_stats_ = RenderStats{};
+  std::fill(overdraw_counts_.begin(), overdraw_counts_.end(), uint8_t{0});
+}
+
+void Renderer3D::DrawMesh(Surface32& target,
+                          const Mesh& mesh,
+                          const Camera& camera,
+                          const RenderInstance& instance) {
+  DrawMesh(target, mesh, mesh.positions, mesh.normals, camera, instance);
+}
+
 void Renderer3D::DrawMesh(Surface32& target,
                           const Mesh& mesh,
+                          std::span<const Vec3> positions,
+                          std::span<const Vec3> normals,
                           const Camera& camera,
                           const RenderInstance& instance) {
-  if (mesh.Empty()) {
+  draw_stats_ = RenderStats{};
+  if (positions.empty() || mesh.triangles.empty()) {
     return;
   }
+  scratch_.Reset();
+  viewport_width_ = target.width();
+  viewport_height_ = target.height();
   EnsureDepthBuffer();
   ClearDepthBuffer();
+  draw_stats_.draws = 1;
+  draw_stats_.triangles_submitted = mesh.triangles.size();
 
   const float half_fov = (camera.fov_degrees * (kPi / 180.0f)) * 0.5f;
-  const float focal_length = (0.5f * static_cast<float>(target_width_)) / std::tan(half_fov);
-  const float center_x = (static_cast<float>(target_width_) - 1.0f) * 0.5f;
-  const float center_y = (static_cast<float>(target_height_) - 1.0f) * 0.5f;
-
-  std::vector<ProjectedVertex> transformed(mesh.positions.size());
-  for (size_t i = 0; i < mesh.positions.size(); ++i) {
-    Vec3 v = mesh.positions[i] * instance.uniform_scale;
+  const float focal_length = (0.5f * static_cast<float>(viewport_width_)) / std::tan(half_fov);
+  const float center_x = (static_cast<float>(viewport_width_) - 1.0f) * 0.5f;
+  const float center_y = (static_cast<float>(viewport_height_) - 1.0f) * 0.5f;
+
+  ArenaVector<ProjectedVertex> transformed(positions.size(),
+                                           ArenaAllocator<ProjectedVertex>(&scratch_));
+  for (size_t i = 0; i < positions.size(); ++i) {
+    Vec3 v = positions[i] * instance.uniform_scale;
     if (instance.use_basis_rotation) {
       v = instance.basis_x * v.x + instance.basis_y * v.y + instance.basis_z * v.z;
     } else {
@@ -114,8 +151,7 @@ void Renderer3D::DrawMesh(Surface32& target,
     transformed[i].view_pos = view;
     transformed[i].z = view.z;
 
-    Vec3 normal = (mesh.normals.size() == mesh.positions.size()) ? mesh.normals[i]
-                                                                  : mesh.positions[i].Normalized();
+    Vec3 normal = (normals.size() == positions.size()) ? normals[i] : positions[i].Normalized();
     if (instance.use_basis_rotation) {
       normal =
           (instance.basis_x * normal.x + instance.basis_y * normal.y + instance.basis_z * normal.z)
@@ -128,8 +164,8 @@ void Renderer3D::DrawMesh(Surface32& target,
                                       normal.Dot(camera.forward))
                                      .Normalized();
 
-    if (instance.texture) {
-      if (instance.use_mesh_uv && mesh.texcoords.size() == mesh.positions.size()) {
+    if (!instance.texture.Empty()) {
+      if (instance.use_mesh_uv && mesh.texcoords.size() == positions.size()) {
         transformed[i].u = mesh.texcoords[i].x;
         transformed[i].v = mesh.texcoords[i].y;
       } else {
@@ -141,25 +177,32 @@ void Renderer3D::DrawMesh(Surface32& target,
     }
   }
 
-  const float winding_sign = ComputeMeshWindingSign(mesh);
+  const float winding_sign = ComputeMeshWindingSign(positions, mesh.triangles);
 
   for (const Triangle& tri : mesh.triangles) {
     const ProjectedVertex& a = transformed[static_cast<size_t>(tri.a)];
     const ProjectedVertex& b = transformed[static_cast<size_t>(tri.b)];
     const ProjectedVertex& c = transformed[static_cast<size_t>(tri.c)];
 
-    std::vector<ProjectedVertex> clipped =
-        ClipTriangleAgainstNearPlane(a, b, c, camera.near_plane);
-    if (clipped.size() < 3) {
+    ProjectedVertex clipped[4];
+    const size_t clipped_count = ClipTriangleAgainstNearPlane(a, b, c, camera.near_plane, clipped);
+    if (clipped_count < 3) {
+      ++draw_stats_.triangles_near_rejected;
       continue;
     }
+    if (a.view_pos.z < camera.near_plane || b.view_pos.z < camera.near_plane ||
+        c.view_pos.z < camera.near_plane) {
+      ++draw_stats_.triangles_near_clipped;
+    }
 
     if (instance.enable_backface_culling &&
         !IsFrontFacing(clipped[0], clipped[1], clipped[2], winding_sign)) {
+      ++draw_stats_.triangles_backface_culled;
       continue;
     }
 
-    for (ProjectedVertex& v : clipped) {
+    for (size_t i = 0; i < clipped_count; ++i) {
+      ProjectedVertex& v = clipped[i];
       const float inv_z = 1.0f / v.view_pos.z;
       v.fx = center_x + v.view_pos.x * focal_length * inv_z;
       v.fy = center_y - v.view_pos.y * focal_length * inv_z;
@@ -170,39 +213,49 @@ void Renderer3D::DrawMesh(Surface32& target,
     }
 
     if (instance.draw_fill) {
-      for (size_t i = 1; i + 1 < clipped.size(); ++i) {
+      for (size_t i = 1; i + 1 < clipped_count; ++i) {
         DrawFilledTriangle(target, clipped[0], clipped[i], clipped[i + 1], instance);
       }
     }
 
-    if (instance.draw_wire) {
-      for (size_t i = 0; i < clipped.size(); ++i) {
+    if (instance.draw_wire && !overdraw_view_) {
+      for (size_t i = 0; i < clipped_count; ++i) {
         const ProjectedVertex& p0 = clipped[i];
-        const ProjectedVertex& p1 = clipped[(i + 1) % clipped.size()];
+        const ProjectedVertex& p1 = clipped[(i + 1) % clipped_count];
         DrawLine(target, p0.x, p0.y, p1.x, p1.y, instance.wire_color);
       }
     }
   }
+  frame_stats_.Add(draw_stats_);
 }
 
 void Renderer3D::EnsureDepthBuffer() {
-  const size_t target_size =
+  const size_t viewport_size =
+      static_cast<size_t>(viewport_width_) * static_cast<size_t>(viewport_height_);
+  if (depth_buffer_.size() < viewport_size) {
+    depth_buffer_.resize(viewport_size, std::numeric_limits<float>::infinity());
+  }
+  const size_t screen_size =
       static_cast<size_t>(target_width_) * static_cast<size_t>(target_height_);
-  if (depth_buffer_.size() != target_size) {
-    depth_buffer_.resize(target_size, std::numeric_limits<float>::infinity());
+  if (overdraw_view_ && overdraw_counts_.size() != screen_size) {
+    overdraw_counts_.assign(screen_size, 0);
   }
 }
 
 void Renderer3D::ClearDepthBuffer() {
-  std::fill(depth_buffer_.begin(), depth_buffer_.end(), std::numeric_limits<float>::infinity());
+  // Only the part the current target covers; smaller targets leave the rest alone.
+  const size_t viewport_size =
+      static_cast<size_t>(viewport_width_) * static_cast<size_t>(viewport_height_);
+  std::fill_n(depth_buffer_.begin(), viewport_size, std::numeric_limits<float>::infinity());
 }
 
-float Renderer3D::ComputeMeshWindingSign(const Mesh& mesh) const {
+float Renderer3D::ComputeMeshWindingSign(std::span<const Vec3> positions,
+                                         std::span<const Triangle> triangles) const {
   float accum = 0.0f;
-  for (const Triangle& tri : mesh.triangles) {
-    const Vec3& a = mesh.positions[static_cast<size_t>(tri.a)];
-    const Vec3& b = mesh.positions[static_cast<size_t>(tri.b)];
-    const Vec3& c = mesh.positions[static_cast<size_t>(tri.c)];
+  for (const Triangle& tri : triangles) {
+    const Vec3& a = positions[static_cast<size_t>(tri.a)];
+    const Vec3& b = positions[static_cast<size_t>(tri.b)];
+    const Vec3& c = positions[static_cast<size_t>(tri.c)];
     const Vec3 n = (b - a).Cross(c - a);
     const Vec3 centroid = (a + b + c) * (1.0f / 3.0f);
     accum += n.Dot(centroid);
@@ -210,11 +263,11 @@ float Renderer3D::ComputeMeshWindingSign(const Mesh& mesh) const {
   return (accum >= 0.0f) ? 1.0f : -1.0f;
 }
 
-std::vector<Renderer3D::ProjectedVertex> Renderer3D::ClipTriangleAgainstNearPlane(
-    const ProjectedVertex& a,
-    const ProjectedVertex& b,
-    const ProjectedVertex& c,
-    float near_plane) const {
+size_t Renderer3D::ClipTriangleAgainstNearPlane(const ProjectedVertex& a,
+                                                const ProjectedVertex& b,
+                                                const ProjectedVertex& c,
+                                                float near_plane,
+                                                ProjectedVertex* out) const {
   auto inside = [near_plane](const ProjectedVertex& v) { return v.view_pos.z >= near_plane; };
   auto intersect = [near_plane](const ProjectedVertex& s, const ProjectedVertex& e) {
     ProjectedVertex out;
@@ -231,26 +284,25 @@ std::vector<Renderer3D::ProjectedVertex> Renderer3D::ClipTriangleAgainstNearPlan
     return out;
   };
 
-  std::vector<ProjectedVertex> input = {a, b, c};
-  std::vector<ProjectedVertex> output;
-  output.reserve(4);
+  const ProjectedVertex* input[3] = {&a, &b, &c};
+  size_t count = 0;
 
-  for (size_t i = 0; i < input.size(); ++i) {
-    const ProjectedVertex& s = input[i];
-    const ProjectedVertex& e = input[(i + 1) % input.size()];
+  for (size_t i = 0; i < 3; ++i) {
+    const ProjectedVertex& s = *input[i];
+    const ProjectedVertex& e = *input[(i + 1) % 3];
     const bool s_inside = inside(s);
     const bool e_inside = inside(e);
 
     if (s_inside && e_inside) {
-      output.push_back(e);
+      out[count++] = e;
     } else if (s_inside && !e_inside) {
-      output.push_back(intersect(s, e));
+      out[count++] = intersect(s, e);
     } else if (!s_inside && e_inside) {
-      output.push_back(intersect(s, e));
-      output.push_back(e);
+      out[count++] = intersect(s, e);
+      out[count++] = e;
     }
   }
-  return output;
+  return count;
 }
 
 bool Renderer3D::IsFrontFacing(const ProjectedVertex& a,
@@ -270,22 +322,27 @@ void Renderer3D::DrawFilledTriangle(Surface32& target,
                                     const RenderInstance& instance) {
   const float area = EdgeFunction(a.fx, a.fy, b.fx, b.fy, c.fx, c.fy);
   if (std::abs(area) < 1e-6f) {
+    ++draw_stats_.triangles_zero_area;
     return;
   }
 
   const int min_x = std::max(
       0, static_cast<int>(std::floor(std::min({a.fx, b.fx, c.fx}))));
   const int max_x = std::min(
-      target_width_ - 1, static_cast<int>(std::ceil(std::max({a.fx, b.fx, c.fx}))));
+      viewport_width_ - 1, static_cast<int>(std::ceil(std::max({a.fx, b.fx, c.fx}))));
   const int min_y = std::max(
       0, static_cast<int>(std::floor(std::min({a.fy, b.fy, c.fy}))));
   const int max_y = std::min(
-      target_height_ - 1, static_cast<int>(std::ceil(std::max({a.fy, b.fy, c.fy}))));
+      viewport_height_ - 1, static_cast<int>(std::ceil(std::max({a.fy, b.fy, c.fy}))));
 
   if (min_x > max_x || min_y > max_y) {
     return;
   }
 
+  // Counted in locals; the member would be reloaded after every pixel store.
+  uint64_t pixels_tested = 0;
+  uint64_t pixels_depth_rejected = 0;
+  uint64_t pixels_shaded = 0;
   for (int y = min_y; y <= max_y; ++y) {
     const float py = static_cast<float>(y) + 0.5f;
     for (int x = min_x; x <= max_x; ++x) {
@@ -299,32 +356,50 @@ void Renderer3D::DrawFilledTriangle(Surface32& target,
         continue;
       }
 
+      ++pixels_tested;
       const float z = w0 * a.z + w1 * b.z + w2 * c.z;
       const size_t index =
-          static_cast<size_t>(y) * static_cast<size_t>(target_width_) + static_cast<size_t>(x);
+          static_cast<size_t>(y) * static_cast<size_t>(viewport_width_) + static_cast<size_t>(x);
       if (z >= depth_buffer_[index]) {
+        ++pixels_depth_rejected;
         continue;
       }
 
       depth_buffer_[index] = z;
+      ++pixels_shaded;
+      if (overdraw_view_) {
+        // Reduced-size targets count at the screen position their pixel covers.
+        const size_t screen_index =
+            static_cast<size_t>(y * target_height_ / viewport_height_) *
+                static_cast<size_t>(target_width_) +
+            static_cast<size_t>(x * target_width_ / viewport_width_);
+        uint8_t& count = overdraw_counts_[screen_index];
+        count = static_cast<uint8_t>(std::min<int>(count + 1, kOverdrawColors.size()));
+        target.SetBackPixel(x, y, kOverdrawColors[count - 1u]);
+        continue;
+      }
 
+      const bool textured = !instance.texture.Empty();
       uint32_t base_color = instance.fill_color;
-      if (instance.texture) {
+      if (textured) {
         const float u = w0 * a.u + w1 * b.u + w2 * c.u;
         const float v = w0 * a.v + w1 * b.v + w2 * c.v;
-        base_color = SampleTexture(*instance.texture, u, v, instance.texture_wrap);
+        base_color = SampleTexture(instance.texture, u, v, instance.texture_wrap);
       }
       const Vec3 interp_normal =
           (a.view_normal * w0 + b.view_normal * w1 + c.view_normal * w2).Normalized();
       const float ndotv = std::abs(interp_normal.z);
       const float light_intensity = instance.texture_unlit
                                         ? 1.0f
-                                        : (instance.texture ? (0.78f + 0.22f * ndotv)
-                                                            : (0.22f + 0.78f * ndotv));
+                                        : (textured ? (0.78f + 0.22f * ndotv)
+                                                    : (0.22f + 0.78f * ndotv));
       const uint32_t shaded_color = ModulateColor(base_color, light_intensity);
       target.SetBackPixel(x, y, shaded_color);
     }
   }
+  draw_stats_.pixels_tested += pixels_tested;
+  draw_stats_.pixels_depth_rejected += pixels_depth_rejected;
+  draw_stats_.pixels_shaded += pixels_shaded;
 }
 
 void Renderer3D::DrawLine(Surface32& target,
@@ -1,17 +1,18 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 #include "Camera.h"
+#include "FrameArena.h"
+#include "ImageView.h"
 #include "Mesh.h"
 #include "Surface32.h"
 #include "Vec3.h"
 
 namespace forward::core {
 
-struct Image32;
-
 struct RenderInstance {
   Vec3 rotation_radians{0.0f, 0.0f, 0.0f};
   Vec3 basis_x{1.0f, 0.0f, 0.0f};
@@ -21,7 +22,7 @@ struct RenderInstance {
   float uniform_scale = 1.0f;
   uint32_t fill_color = 0xFFB0D0FFu;
   uint32_t wire_color = 0xFFFFFFFFu;
-  const Image32* texture = nullptr;
+  ImageView texture;
   bool use_mesh_uv = true;
   bool texture_wrap = true;
   bool texture_unlit = false;
@@ -31,6 +32,29 @@ struct RenderInstance {
   bool use_basis_rotation = false;
 };
 
+// Work done by DrawMesh(). A triangle cut by the near plane is rasterized as
+// a fan of up to two pieces; zero-area rejects and the pixel counts are per
+// piece.
+struct RenderStats {
+  uint64_t draws = 0;
+  uint64_t triangles_submitted = 0;
+  // Entirely behind the near plane.
+  uint64_t triangles_near_rejected = 0;
+  // Partly behind the near plane and cut down to the visible part.
+  uint64_t triangles_near_clipped = 0;
+  uint64_t triangles_backface_culled = 0;
+  uint64_t triangles_zero_area = 0;
+  // Pixels inside a triangle that reached the depth test.
+  uint64_t pixels_tested = 0;
+  uint64_t pixels_depth_rejected = 0;
+  uint64_t pixels_shaded = 0;
+
+  void Add(const RenderStats& other);
+};
+
+// Projects onto whatever target DrawMesh() is given, so a target at a fraction
+// of the screen size renders the same view at that resolution. The size passed
+// in is the screen's, used by the overdraw view.
 class Renderer3D {
  public:
   Renderer3D(int target_width, int target_height);
@@ -39,6 +63,28 @@ class Renderer3D {
                 const Mesh& mesh,
                 const Camera& camera,
                 const RenderInstance& instance);
+  // Draws `mesh`'s triangles and texcoords over per-draw vertex data, such as
+  // positions deformed for this frame. Normals are optional; an empty span
+  // falls back to normalized positions.
+  void DrawMesh(Surface32& target,
+                const Mesh& mesh,
+                std::span<const Vec3> positions,
+                std::span<const Vec3> normals,
+                const Camera& camera,
+                const RenderInstance& instance);
+
+  // Starts a new frame of FrameStats() and of the overdraw counts.
+  void BeginFrame();
+  const RenderStats& LastDrawStats() const { return draw_stats_; }
+  const RenderStats& FrameStats() const { return frame_stats_; }
+  // Folds work drawn through another context into this frame's stats.
+  void AddFrameStats(const RenderStats& stats) { frame_stats_.Add(stats); }
+
+  // Instead of shading, each written pixel shows how often that screen
+  // position has been written since BeginFrame(), over every target, from
+  // blue (once) to white (8 times or more). Wireframes are not drawn.
+  void SetOverdrawView(bool enabled) { overdraw_view_ = enabled; }
+  bool OverdrawView() const { return overdraw_view_; }
 
  private:
   struct ProjectedVertex {
@@ -56,12 +102,15 @@ class Renderer3D {
 
   void EnsureDepthBuffer();
   void ClearDepthBuffer();
-  float ComputeMeshWindingSign(const Mesh& mesh) const;
+  float ComputeMeshWindingSign(std::span<const Vec3> positions,
+                               std::span<const Triangle> triangles) const;
 
-  std::vector<ProjectedVertex> ClipTriangleAgainstNearPlane(const ProjectedVertex& a,
-                                                            const ProjectedVertex& b,
-                                                            const ProjectedVertex& c,
-                                                            float near_plane) const;
+  // Writes up to four vertices to `out` and returns how many.
+  size_t ClipTriangleAgainstNearPlane(const ProjectedVertex& a,
+                                      const ProjectedVertex& b,
+                                      const ProjectedVertex& c,
+                                      float near_plane,
+                                      ProjectedVertex* out) const;
 
   bool IsFrontFacing(const ProjectedVertex& a,
                      const ProjectedVertex& b,
@@ -78,7 +127,16 @@ class Renderer3D {
 
   int target_width_ = 0;
   int target_height_ = 0;
+  // Size of the target being drawn; the depth buffer covers the largest seen.
+  int viewport_width_ = 0;
+  int viewport_height_ = 0;
   std::vector<float> depth_buffer_;
+  RenderStats draw_stats_;
+  RenderStats frame_stats_;
+  bool overdraw_view_ = false;
+  std::vector<uint8_t> overdraw_counts_;
+  // Per-draw vertex scratch, reset at the start of every DrawMesh().
+  FrameArena scratch_;
 };
 
 }  // namespace forward::core
@@ -0,0 +1,278 @@
+#include "ScriptTimeline.h"
+
+#include <algorithm>
+#include <charconv>
+#include <system_error>
+
+#include "TextScan.h"
+
+namespace forward::core {
+namespace {
+
+bool IsScriptSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+std::string_view TrimScript(std::string_view text) {
+  while (!text.empty() && IsScriptSpace(text.front())) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && IsScriptSpace(text.back())) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+size_t SplitScriptTokens(std::string_view text, std::string_view* out_tokens, size_t max_tokens) {
+  size_t count = 0;
+  size_t i = 0;
+  while (i < text.size() && count < max_tokens) {
+    while (i < text.size() && IsScriptSpace(text[i])) {
+      ++i;
+    }
+    const size_t begin = i;
+    while (i < text.size() && !IsScriptSpace(text[i])) {
+      ++i;
+    }
+    if (i > begin) {
+      out_tokens[count++] = text.substr(begin, i - begin);
+    }
+  }
+  return count;
+}
+
+// "_900" sets the wait row, "__10" advances it; both are hexadecimal packed
+// order-rows. Returns false (leaving the row untouched) on a malformed prefix.
+bool ParseWaitPrefix(std::string_view prefix, int* inout_row) {
+  const size_t underscores = (prefix.size() > 1 && prefix[1] == '_') ? 2 : 1;
+  int value = 0;
+  const char* first = prefix.data() + underscores;
+  const char* last = prefix.data() + prefix.size();
+  const std::from_chars_result result = std::from_chars(first, last, value, 16);
+  if (result.ptr == first || result.ec != std::errc()) {
+    return false;
+  }
+  *inout_row = (underscores == 2) ? *inout_row + value : value;
+  return true;
+}
+
+}  // namespace
+
+ScriptTimeline::ScriptTimeline(std::span<const std::string_view> vocabulary) {
+  for (std::string_view symbol : vocabulary) {
+    Intern(symbol);
+  }
+}
+
+uint16_t ScriptTimeline::Intern(std::string_view symbol) {
+  const std::string key(symbol);
+  const auto it = symbol_ids_.find(key);
+  if (it != symbol_ids_.end()) {
+    return it->second;
+  }
+  if (symbols_.size() >= kNoScriptSymbol) {
+    return kNoScriptSymbol;
+  }
+  const uint16_t id = static_cast<uint16_t>(symbols_.size());
+  symbols_.push_back(key);
+  symbol_ids_.emplace(key, id);
+  return id;
+}
+
+uint16_t ScriptTimeline::Find(std::string_view symbol) const {
+  const auto it = symbol_ids_.find(std::string(symbol));
+  return (it != symbol_ids_.end()) ? it->second : kNoScriptSymbol;
+}
+
+const std::string& ScriptTimeline::SymbolName(uint16_t id) const {
+  static const std::string kEmpty;
+  return (id < symbols_.size()) ? symbols_[id] : kEmpty;
+}
+
+void ScriptTimeline::Compile(const std::vector<std::string>& entries) {
+  events_.clear();
+  int module = 0;
+  int wait_row = 0;
+  int current_row = 0;
+
+  for (const std::string& entry : entries) {
+    std::string_view line = TrimScript(entry);
+    if (line.empty() || line.front() == '#') {
+      continue;
+    }
+    if (line.front() == '_') {
+      const size_t space = line.find(' ');
+      ParseWaitPrefix(line.substr(0, space), &wait_row);
+      current_row = std::max(current_row, wait_row);
+      line = (space == std::string_view::npos) ? std::string_view()
+                                               : TrimScript(line.substr(space));
+    }
+
+    std::string_view tokens[8];
+    const size_t count = SplitScriptTokens(line, tokens, std::size(tokens));
+    if (count == 0) {
+      continue;
+    }
+    const std::string_view verb = tokens[0];
+    if (verb == "mod") {
+      module = (count >= 2) ? ParseNumberPrefix<int>(tokens[1], module) : module;
+      current_row = 0;
+      continue;
+    }
+
+    ScriptEvent event;
+    event.order_row = current_row;
+    event.module = static_cast<uint8_t>(std::clamp(module, 0, 255));
+    if (verb == "init" || verb == "show" || verb == "kill") {
+      event.op = (verb == "init") ? ScriptOp::kInit
+                                  : (verb == "show" ? ScriptOp::kShow : ScriptOp::kKill);
+      event.target = (count >= 2) ? Intern(tokens[1]) : kNoScriptSymbol;
+    } else if (verb == "msg") {
+      event.op = ScriptOp::kMessage;
+      event.target = (count >= 2) ? Intern(tokens[1]) : kNoScriptSymbol;
+      event.message = (count >= 3) ? Intern(tokens[2]) : kNoScriptSymbol;
+      event.argument = (count >= 4) ? ParseNumberPrefix<float>(tokens[3]) : 0.0f;
+    } else if (verb == "go") {
+      event.op = ScriptOp::kGo;
+      event.argument = (count >= 2) ? ParseNumberPrefix<float>(tokens[1]) : 0.0f;
+    } else {
+      event.op = ScriptOp::kCommand;
+      event.message = Intern(verb);
+      event.argument = (count >= 2) ? ParseNumberPrefix<float>(tokens[1]) : 0.0f;
+    }
+    events_.push_back(event);
+  }
+
+  BuildIndex();
+}
+
+void ScriptTimeline::BuildIndex() {
+  std::stable_sort(events_.begin(), events_.end(), [](const ScriptEvent& a, const ScriptEvent& b) {
+    return (a.module != b.module) ? a.module < b.module : a.order_row < b.order_row;
+  });
+
+  modules_.clear();
+  if (events_.empty()) {
+    return;
+  }
+  modules_.resize(static_cast<size_t>(events_.back().module) + 1);
+  size_t i = 0;
+  while (i < events_.size()) {
+    ModuleIndex& index = modules_[events_[i].module];
+    index.begin = i;
+    size_t end = i;
+    while (end < events_.size() && events_[end].module == events_[i].module) {
+      ++end;
+    }
+    index.end = end;
+
+    const int last_row = std::max(0, events_[end - 1].order_row);
+    index.row_first.resize(static_cast<size_t>(last_row) + 1);
+    size_t cursor = i;
+    for (int row = 0; row <= last_row; ++row) {
+      while (cursor < end && events_[cursor].order_row < row) {
+        ++cursor;
+      }
+      index.row_first[static_cast<size_t>(row)] = static_cast<uint32_t>(cursor);
+    }
+    i = end;
+  }
+  // Modules without events sit at the end of their predecessor.
+  size_t previous_end = 0;
+  for (ModuleIndex& index : modules_) {
+    if (index.end == 0 && index.row_first.empty()) {
+      index.begin = previous_end;
+      index.end = previous_end;
+    }
+    previous_end = index.end;
+  }
+}
+
+size_t ScriptTimeline::ModuleBegin(int module) const {
+  if (module < 0 || module >= static_cast<int>(modules_.size())) {
+    return events_.size();
+  }
+  return modules_[static_cast<size_t>(module)].begin;
+}
+
+size_t ScriptTimeline::ModuleEnd(int module) const {
+  if (module < 0 || module >= static_cast<int>(modules_.size())) {
+    return events_.size();
+  }
+  return modules_[static_cast<size_t>(module)].end;
+}
+
+size_t ScriptTimeline::FirstAtOrAfter(int module, int order_row) const {
+  if (module < 0 || module >= static_cast<int>(modules_.size())) {
+    return events_.size();
+  }
+  const ModuleIndex& index = modules_[static_cast<size_t>(module)];
+  if (order_row <= 0 || index.row_first.empty()) {
+    return index.begin;
+  }
+  if (order_row >= static_cast<int>(index.row_first.size())) {
+    return index.end;
+  }
+  return index.row_first[static_cast<size_t>(order_row)];
+}
+
+int ScriptTimeline::FindRow(int module, ScriptOp op, uint16_t target) const {
+  for (size_t i = ModuleBegin(module); i < ModuleEnd(module); ++i) {
+    if (events_[i].op == op && events_[i].target == target) {
+      return events_[i].order_row;
+    }
+  }
+  return -1;
+}
+
+int ScriptTimeline::NextShowRow(int module, int order_row) const {
+  for (size_t i = FirstAtOrAfter(module, order_row + 1); i < ModuleEnd(module); ++i) {
+    if (events_[i].op == ScriptOp::kShow) {
+      return events_[i].order_row;
+    }
+  }
+  return -1;
+}
+
+ScriptCursor::ScriptCursor(const ScriptTimeline* timeline,
+                           int module,
+                           uint16_t target,
+                           bool catch_up)
+    : timeline_(timeline), module_(module), target_(target), catch_up_(catch_up) {
+  if (timeline_) {
+    position_ = timeline_->ModuleBegin(module_);
+    due_end_ = position_;
+  }
+}
+
+void ScriptCursor::Advance(int order_row) {
+  if (!timeline_ || order_row < 0) {
+    return;
+  }
+  if (last_order_row_ < 0) {
+    if (!catch_up_) {
+      position_ = std::max(position_, timeline_->FirstAtOrAfter(module_, order_row));
+    }
+    due_end_ = timeline_->FirstAtOrAfter(module_, order_row + 1);
+  } else if (order_row < last_order_row_) {
+    due_end_ = timeline_->ModuleEnd(module_);
+  } else {
+    due_end_ = timeline_->FirstAtOrAfter(module_, order_row + 1);
+  }
+  due_end_ = std::max(due_end_, position_);
+  last_order_row_ = order_row;
+}
+
+const ScriptEvent* ScriptCursor::Next() {
+  if (!timeline_) {
+    return nullptr;
+  }
+  const std::vector<ScriptEvent>& events = timeline_->Events();
+  while (position_ < due_end_) {
+    const ScriptEvent& event = events[position_++];
+    if (event.op == ScriptOp::kMessage && event.target == target_) {
+      return &event;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace forward::core
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace forward::core {
+
+constexpr uint16_t kNoScriptSymbol = 0xFFFFu;
+
+enum class ScriptOp : uint8_t {
+  kInit,
+  kShow,
+  kKill,
+  kMessage,
+  kGo,
+  kCommand,
+};
+
+// One compiled script line. `target` is the interned scene name of
+// init/show/kill/msg; `message` is the interned first word of a msg payload
+// (or the verb of a generic command) and `argument` its numeric operand.
+struct ScriptEvent {
+  int order_row = 0;
+  uint8_t module = 0;
+  ScriptOp op = ScriptOp::kCommand;
+  uint16_t target = kNoScriptSymbol;
+  uint16_t message = kNoScriptSymbol;
+  float argument = 0.0f;
+};
+
+// The demo script (the `kkAmajA` string table of the original applet) compiled
+// once into typed events, sorted by module and packed order-row, with a
+// per-module row index so the events due at any row are found in O(1).
+//
+// Symbols listed in the vocabulary get their index as ID, so callers can map
+// them onto an enum and dispatch with a switch; any other word is interned
+// after them.
+//
+// Lines wait for their `_row` / `__delta` prefix like the applet did: a line
+// whose row lies behind the previous wait fires straight after it, so the
+// compiled rows never decrease within a module.
+class ScriptTimeline {
+ public:
+  explicit ScriptTimeline(std::span<const std::string_view> vocabulary = {});
+
+  void Compile(const std::vector<std::string>& entries);
+
+  uint16_t Intern(std::string_view symbol);
+  uint16_t Find(std::string_view symbol) const;
+  const std::string& SymbolName(uint16_t id) const;
+
+  bool Empty() const { return events_.empty(); }
+  const std::vector<ScriptEvent>& Events() const { return events_; }
+
+  // Range of a module's events, as indices into Events().
+  size_t ModuleBegin(int module) const;
+  size_t ModuleEnd(int module) const;
+  // Index of the module's first event at or after `order_row`.
+  size_t FirstAtOrAfter(int module, int order_row) const;
+
+  // Row of the first `op` event for `target` in `module`, or -1.
+  int FindRow(int module, ScriptOp op, uint16_t target) const;
+  // Row of the first show event in `module` after `order_row`, or -1.
+  int NextShowRow(int module, int order_row) const;
+
+ private:
+  struct ModuleIndex {
+    size_t begin = 0;
+    size_t end = 0;
+    // row_first[r]: first event with order_row >= r, for r in [0, last row].
+    std::vector<uint32_t> row_first;
+  };
+
+  void BuildIndex();
+
+  std::vector<std::string> symbols_;
+  std::unordered_map<std::string, uint16_t> symbol_ids_;
+  std::vector<ScriptEvent> events_;
+  std::vector<ModuleIndex> modules_;
+};
+
+// Per-scene read position in a ScriptTimeline. Each Advance() call selects the
+// events that became due since the previous call; Next() then walks the msg
+// events addressed to the cursor's target. With `catch_up`, the first call
+// also replays everything before the starting row; otherwise playback starts
+// at the current row. A backwards jump (module wrap) flushes the rest of the
+// module, and the cursor never replays events.
+class ScriptCursor {
+ public:
+  ScriptCursor() = default;
+  ScriptCursor(const ScriptTimeline* timeline, int module, uint16_t target, bool catch_up);
+
+  void Advance(int order_row);
+  const ScriptEvent* Next();
+
+  bool Bound() const { return timeline_ != nullptr; }
+  size_t Position() const { return position_; }
+  int LastOrderRow() const { return last_order_row_; }
+
+ private:
+  const ScriptTimeline* timeline_ = nullptr;
+  int module_ = 0;
+  uint16_t target_ = kNoScriptSymbol;
+  bool catch_up_ = false;
+  size_t position_ = 0;
+  size_t due_end_ = 0;
+  int last_order_row_ = -1;
+};
+
+}  // namespace forward::core
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace forward::core {
+
+// Sequence lock publishing a small trivially copyable value from one writer at
+// a time to any number of readers. Readers never block the writer and always
+// see a value from a single Store(); they retry while a store is in flight.
+// The payload lives in relaxed atomic words so concurrent access stays
+// well-defined.
+template <typename T>
+class SeqLock {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+ public:
+  SeqLock() { Store(T{}); }
+
+  void Store(const T& value) {
+    std::array<uint64_t, kWords> words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+    const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kWords; ++i) {
+      words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  T Load() const {
+    std::array<uint64_t, kWords> words{};
+    while (true) {
+      const uint32_t before = sequence_.load(std::memory_order_acquire);
+      if ((before & 1u) != 0) {
+        continue;
+      }
+      for (size_t i = 0; i < kWords; ++i) {
+        words[i] = words_[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence_.load(std::memory_order_relaxed) == before) {
+        break;
+      }
+    }
+    T value;
+    std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+    return value;
+  }
+
+ private:
+  static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  std::atomic<uint32_t> sequence_{0};
+  std::array<std::atomic<uint64_t>, kWords> words_{};
+};
+
+}  // namespace forward::core
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace forward::core {
+
+// Single-producer/single-consumer ring of fixed-size byte blocks, each carrying
+// a small trivially copyable tag. One thread writes, one thread reads, neither
+// ever blocks or allocates. Reset() must only be called while neither side is
+// running.
+template <typename Tag>
+class SpscBlockRing {
+ public:
+  // The block count is rounded up to a power of two.
+  void Reset(size_t block_count, size_t block_bytes) {
+    size_t capacity = 1;
+    while (capacity < block_count) {
+      capacity <<= 1;
+    }
+    mask_ = capacity - 1;
+    block_bytes_ = block_bytes;
+    storage_.assign(capacity * block_bytes, 0);
+    tags_.assign(capacity, Tag{});
+    write_index_.store(0, std::memory_order_relaxed);
+    read_index_.store(0, std::memory_order_relaxed);
+  }
+
+  size_t Capacity() const { return tags_.size(); }
+  size_t BlockBytes() const { return block_bytes_; }
+
+  // Blocks currently queued; exact on either side, a snapshot elsewhere.
+  size_t Size() const {
+    return write_index_.load(std::memory_order_acquire) -
+           read_index_.load(std::memory_order_acquire);
+  }
+
+  // Producer side. Returns nullptr while the ring is full.
+  uint8_t* AcquireWrite(Tag** out_tag) {
+    const size_t write = write_index_.load(std::memory_order_relaxed);
+    if (tags_.empty() || write - read_index_.load(std::memory_order_acquire) > mask_) {
+      return nullptr;
+    }
+    const size_t slot = write & mask_;
+    *out_tag = &tags_[slot];
+    return storage_.data() + slot * block_bytes_;
+  }
+  void CommitWrite() { write_index_.fetch_add(1, std::memory_order_release); }
+
+  // Consumer side. Returns nullptr while the ring is empty.
+  const uint8_t* AcquireRead(const Tag** out_tag) const {
+    const size_t read = read_index_.load(std::memory_order_relaxed);
+    if (read == write_index_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    const size_t slot = read & mask_;
+    *out_tag = &tags_[slot];
+    return storage_.data() + slot * block_bytes_;
+  }
+  void ReleaseRead() { read_index_.fetch_add(1, std::memory_order_release); }
+
+ private:
+  std::vector<uint8_t> storage_;
+  std::vector<Tag> tags_;
+  size_t mask_ = 0;
+  size_t block_bytes_ = 0;
+  alignas(64) std::atomic<size_t> write_index_{0};
+  alignas(64) std::atomic<size_t> read_index_{0};
+};
+
+}  // namespace forward::core
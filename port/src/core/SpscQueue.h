@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace forward::core {
+
+// Bounded single-producer/single-consumer queue of trivially copyable values.
+// Neither side blocks or allocates; a push into a full queue fails. Reset()
+// must only be called while neither side is running.
+template <typename T>
+class SpscQueue {
+ public:
+  // The capacity is rounded up to a power of two.
+  void Reset(size_t capacity) {
+    size_t rounded = 1;
+    while (rounded < capacity) {
+      rounded <<= 1;
+    }
+    mask_ = rounded - 1;
+    items_.assign(rounded, T{});
+    write_index_.store(0, std::memory_order_relaxed);
+    read_index_.store(0, std::memory_order_relaxed);
+  }
+
+  size_t Capacity() const { return items_.size(); }
+
+  // Producer side.
+  bool TryPush(const T& value) {
+    const size_t write = write_index_.load(std::memory_order_relaxed);
+    if (items_.empty() || write - read_index_.load(std::memory_order_acquire) > mask_) {
+      return false;
+    }
+    items_[write & mask_] = value;
+    write_index_.store(write + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side.
+  bool TryPop(T* out_value) {
+    const size_t read = read_index_.load(std::memory_order_relaxed);
+    if (read == write_index_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    *out_value = items_[read & mask_];
+    read_index_.store(read + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  std::vector<T> items_;
+  size_t mask_ = 0;
+  alignas(64) std::atomic<size_t> write_index_{0};
+  alignas(64) std::atomic<size_t> read_index_{0};
+};
+
+}  // namespace forward::core
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 
+#include "Profiler.h"
+
 namespace forward::core {
 namespace {
 
@@ -25,7 +27,8 @@ Surface32::Surface32(int width, int height, bool double_buffered)
     : width_(width),
       height_(height),
       double_buffered_(double_buffered),
-      front_(static_cast<size_t>(width) * static_cast<size_t>(height), 0xFF000000u),
+      front_(double_buffered ? static_cast<size_t>(width) * static_cast<size_t>(height) : 0,
+             0xFF000000u),
       back_(static_cast<size_t>(width) * static_cast<size_t>(height), 0xFF000000u) {}
 
 void Surface32::ClearBack(uint32_t argb) {
@@ -33,7 +36,8 @@ void Surface32::ClearBack(uint32_t argb) {
 }
 
 void Surface32::ClearFront(uint32_t argb) {
-  std::fill(front_.begin(), front_.end(), argb);
+  std::vector<uint32_t>& pixels = double_buffered_ ? front_ : back_;
+  std::fill(pixels.begin(), pixels.end(), argb);
 }
 
 void Surface32::SetBackPixel(int x, int y, uint32_t argb) {
@@ -63,14 +67,15 @@ void Surface32::SubBackRgb(uint8_t sub_r, uint8_t sub_g, uint8_t sub_b) {
   }
 }
 
-void Surface32::BlitToBack(const Surface32& src,
+void Surface32::BlitToBack(const ImageView& src,
                            int src_x,
                            int src_y,
                            int dst_x,
                            int dst_y,
                            int w,
                            int h) {
-  if (w <= 0 || h <= 0) {
+  FORWARD_PROFILE_ZONE("Surface32::BlitToBack");
+  if (src.Empty() || w <= 0 || h <= 0) {
     return;
   }
 
@@ -102,8 +107,8 @@ void Surface32::BlitToBack(const Surface32& src,
     copy_dst_y = 0;
   }
 
-  copy_w = std::min(copy_w, src.width_ - copy_src_x);
-  copy_h = std::min(copy_h, src.height_ - copy_src_y);
+  copy_w = std::min(copy_w, src.width - copy_src_x);
+  copy_h = std::min(copy_h, src.height - copy_src_y);
   copy_w = std::min(copy_w, width_ - copy_dst_x);
   copy_h = std::min(copy_h, height_ - copy_dst_y);
 
@@ -112,17 +117,14 @@ void Surface32::BlitToBack(const Surface32& src,
   }
 
   for (int row = 0; row < copy_h; ++row) {
-    const uint32_t* src_row =
-        src.front_.data() + static_cast<size_t>(copy_src_y + row) * src.width_ + copy_src_x;
+    const uint32_t* src_row = src.Row(copy_src_y + row) + copy_src_x;
     uint32_t* dst_row =
         back_.data() + static_cast<size_t>(copy_dst_y + row) * width_ + copy_dst_x;
     std::copy_n(src_row, copy_w, dst_row);
   }
 }
 
-void Surface32::AlphaBlitToBack(const uint32_t* src_pixels,
-                                int src_width,
-                                int src_height,
+void Surface32::AlphaBlitToBack(const ImageView& source,
                                 int src_x,
                                 int src_y,
                                 int dst_x,
@@ -130,8 +132,8 @@ void Surface32::AlphaBlitToBack(const uint32_t* src_pixels,
                                 int w,
                                 int h,
                                 uint8_t global_alpha) {
-  if (!src_pixels || src_width <= 0 || src_height <= 0 || w <= 0 || h <= 0 ||
-      global_alpha == 0) {
+  FORWARD_PROFILE_ZONE("Surface32::AlphaBlitToBack");
+  if (source.Empty() || w <= 0 || h <= 0 || global_alpha == 0) {
     return;
   }
 
@@ -163,8 +165,8 @@ void Surface32::AlphaBlitToBack(const uint32_t* src_pixels,
     copy_dst_y = 0;
   }
 
-  copy_w = std::min(copy_w, src_width - copy_src_x);
-  copy_h = std::min(copy_h, src_height - copy_src_y);
+  copy_w = std::min(copy_w, source.width - copy_src_x);
+  copy_h = std::min(copy_h, source.height - copy_src_y);
   copy_w = std::min(copy_w, width_ - copy_dst_x);
   copy_h = std::min(copy_h, height_ - copy_dst_y);
 
@@ -173,8 +175,7 @@ void Surface32::AlphaBlitToBack(const uint32_t* src_pixels,
   }
 
   for (int row = 0; row < copy_h; ++row) {
-    const uint32_t* src_row = src_pixels +
-                              static_cast<size_t>(copy_src_y + row) * src_width + copy_src_x;
+    const uint32_t* src_row = source.Row(copy_src_y + row) + copy_src_x;
     uint32_t* dst_row =
         back_.data() + static_cast<size_t>(copy_dst_y + row) * width_ + copy_dst_x;
     for (int col = 0; col < copy_w; ++col) {
@@ -206,9 +207,7 @@ void Surface32::AlphaBlitToBack(const uint32_t* src_pixels,
   }
 }
 
-void Surface32::AdditiveBlitToBack(const uint32_t* src_pixels,
-                                   int src_width,
-                                   int src_height,
+void Surface32::AdditiveBlitToBack(const ImageView& source,
                                    int src_x,
                                    int src_y,
                                    int dst_x,
@@ -216,7 +215,8 @@ void Surface32::AdditiveBlitToBack(const uint32_t* src_pixels,
                                    int w,
                                    int h,
                                    uint8_t intensity) {
-  if (!src_pixels || src_width <= 0 || src_height <= 0 || w <= 0 || h <= 0 || intensity == 0) {
+  FORWARD_PROFILE_ZONE("Surface32::AdditiveBlitToBack");
+  if (source.Empty() || w <= 0 || h <= 0 || intensity == 0) {
     return;
   }
 
@@ -248,8 +248,8 @@ void Surface32::AdditiveBlitToBack(const uint32_t* src_pixels,
     copy_dst_y = 0;
   }
 
-  copy_w = std::min(copy_w, src_width - copy_src_x);
-  copy_h = std::min(copy_h, src_height - copy_src_y);
+  copy_w = std::min(copy_w, source.width - copy_src_x);
+  copy_h = std::min(copy_h, source.height - copy_src_y);
   copy_w = std::min(copy_w, width_ - copy_dst_x);
   copy_h = std::min(copy_h, height_ - copy_dst_y);
 
@@ -258,8 +258,7 @@ void Surface32::AdditiveBlitToBack(const uint32_t* src_pixels,
   }
 
   for (int row = 0; row < copy_h; ++row) {
-    const uint32_t* src_row = src_pixels +
-                              static_cast<size_t>(copy_src_y + row) * src_width + copy_src_x;
+    const uint32_t* src_row = source.Row(copy_src_y + row) + copy_src_x;
     uint32_t* dst_row =
         back_.data() + static_cast<size_t>(copy_dst_y + row) * width_ + copy_dst_x;
     for (int col = 0; col < copy_w; ++col) {
@@ -278,16 +277,84 @@ void Surface32::AdditiveBlitToBack(const uint32_t* src_pixels,
   }
 }
 
-void Surface32::AdditiveBlitScaledToBack(const uint32_t* src_pixels,
-                                         int src_width,
-                                         int src_height,
+void Surface32::AlphaBlitScaledToBack(const ImageView& source,
+                                      int dst_x,
+                                      int dst_y,
+                                      int dst_w,
+                                      int dst_h,
+                                      uint8_t global_alpha) {
+  FORWARD_PROFILE_ZONE("Surface32::AlphaBlitScaledToBack");
+  if (source.Empty() || dst_w <= 0 || dst_h <= 0 || global_alpha == 0) {
+    return;
+  }
+
+  const int clip_x0 = std::max(0, dst_x);
+  const int clip_y0 = std::max(0, dst_y);
+  const int clip_x1 = std::min(width_, dst_x + dst_w);
+  const int clip_y1 = std::min(height_, dst_y + dst_h);
+  if (clip_x0 >= clip_x1 || clip_y0 >= clip_y1) {
+    return;
+  }
+
+  // Each destination pixel in [x0, x1) takes source pixel `src`.
+  const auto blend_run = [global_alpha](uint32_t src, uint32_t* dst_row, int x0, int x1) {
+    const int src_a = (static_cast<int>(ChannelA(src)) * global_alpha) / 255;
+    if (src_a <= 0) {
+      return;
+    }
+    if (src_a >= 255) {
+      std::fill(dst_row + x0, dst_row + x1, (0xFFu << 24u) | (src & 0x00FFFFFFu));
+      return;
+    }
+    const int inv_a = 255 - src_a;
+    const int src_r = static_cast<int>(ChannelR(src)) * src_a;
+    const int src_g = static_cast<int>(ChannelG(src)) * src_a;
+    const int src_b = static_cast<int>(ChannelB(src)) * src_a;
+    for (int x = x0; x < x1; ++x) {
+      const uint32_t dst = dst_row[x];
+      const int r = (src_r + static_cast<int>(ChannelR(dst)) * inv_a) / 255;
+      const int g = (src_g + static_cast<int>(ChannelG(dst)) * inv_a) / 255;
+      const int b = (src_b + static_cast<int>(ChannelB(dst)) * inv_a) / 255;
+      dst_row[x] =
+          PackArgb(static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b));
+    }
+  };
+
+  const int factor = dst_w / source.width;
+  const bool whole_factor = dst_w == source.width * factor && dst_h == source.height * factor;
+  for (int y = clip_y0; y < clip_y1; ++y) {
+    const int rel_y = y - dst_y;
+    const int src_y_nearest =
+        std::clamp((rel_y * source.height) / dst_h, 0, source.height - 1);
+    const uint32_t* src_row = source.Row(src_y_nearest);
+    uint32_t* dst_row = back_.data() + static_cast<size_t>(y) * width_;
+    if (whole_factor) {
+      // Every source pixel covers `factor` columns and is weighted once for all of them.
+      const int src_x0 = (clip_x0 - dst_x) / factor;
+      const int src_x1 = (clip_x1 - dst_x + factor - 1) / factor;
+      for (int src_x = src_x0; src_x < src_x1; ++src_x) {
+        const int run_x = dst_x + src_x * factor;
+        blend_run(src_row[src_x], dst_row, std::max(clip_x0, run_x),
+                  std::min(clip_x1, run_x + factor));
+      }
+      continue;
+    }
+    for (int x = clip_x0; x < clip_x1; ++x) {
+      const int src_x_nearest =
+          std::clamp(((x - dst_x) * source.width) / dst_w, 0, source.width - 1);
+      blend_run(src_row[src_x_nearest], dst_row, x, x + 1);
+    }
+  }
+}
+
+void Surface32::AdditiveBlitScaledToBack(const ImageView& source,
                                          int dst_x,
                                          int dst_y,
                                          int dst_w,
                                          int dst_h,
                                          uint8_t intensity) {
-  if (!src_pixels || src_width <= 0 || src_height <= 0 || dst_w <= 0 || dst_h <= 0 ||
-      intensity == 0) {
+  FORWARD_PROFILE_ZONE("Surface32::AdditiveBlitScaledToBack");
+  if (source.Empty() || dst_w <= 0 || dst_h <= 0 || intensity == 0) {
     return;
   }
 
@@ -299,17 +366,41 @@ void Surface32::AdditiveBlitScaledToBack(const uint32_t* src_pixels,
     return;
   }
 
+  const int factor = dst_w / source.width;
+  const bool whole_factor = dst_w == source.width * factor && dst_h == source.height * factor;
   for (int y = clip_y0; y < clip_y1; ++y) {
     const int rel_y = y - dst_y;
     const int src_y_nearest =
-        std::clamp((rel_y * src_height) / dst_h, 0, src_height - 1);
+        std::clamp((rel_y * source.height) / dst_h, 0, source.height - 1);
+    const uint32_t* src_row = source.Row(src_y_nearest);
     uint32_t* dst_row = back_.data() + static_cast<size_t>(y) * width_;
+    if (whole_factor) {
+      // As in AlphaBlitScaledToBack(), each source pixel is weighted once per run.
+      const int src_x0 = (clip_x0 - dst_x) / factor;
+      const int src_x1 = (clip_x1 - dst_x + factor - 1) / factor;
+      for (int src_x = src_x0; src_x < src_x1; ++src_x) {
+        const uint32_t src = src_row[src_x];
+        const int add_r = (static_cast<int>(ChannelR(src)) * intensity) / 255;
+        const int add_g = (static_cast<int>(ChannelG(src)) * intensity) / 255;
+        const int add_b = (static_cast<int>(ChannelB(src)) * intensity) / 255;
+        const int run_x = dst_x + src_x * factor;
+        const int run_end = std::min(clip_x1, run_x + factor);
+        for (int x = std::max(clip_x0, run_x); x < run_end; ++x) {
+          const uint32_t dst = dst_row[x];
+          const int r = std::min(255, static_cast<int>(ChannelR(dst)) + add_r);
+          const int g = std::min(255, static_cast<int>(ChannelG(dst)) + add_g);
+          const int b = std::min(255, static_cast<int>(ChannelB(dst)) + add_b);
+          dst_row[x] = PackArgb(static_cast<uint8_t>(r), static_cast<uint8_t>(g),
+                                static_cast<uint8_t>(b));
+        }
+      }
+      continue;
+    }
     for (int x = clip_x0; x < clip_x1; ++x) {
       const int rel_x = x - dst_x;
       const int src_x_nearest =
-          std::clamp((rel_x * src_width) / dst_w, 0, src_width - 1);
-      const uint32_t src =
-          src_pixels[static_cast<size_t>(src_y_nearest) * src_width + src_x_nearest];
+          std::clamp((rel_x * source.width) / dst_w, 0, source.width - 1);
+      const uint32_t src = src_row[src_x_nearest];
       const uint32_t dst = dst_row[x];
 
       const int r = ClampToByte(static_cast<int>(ChannelR(dst)) +
@@ -327,8 +418,6 @@ void Surface32::AdditiveBlitScaledToBack(const uint32_t* src_pixels,
 void Surface32::SwapBuffers() {
   if (double_buffered_) {
     std::swap(front_, back_);
-  } else {
-    front_ = back_;
   }
 }
 
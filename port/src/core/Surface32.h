@@ -3,8 +3,12 @@
 #include <cstdint>
 #include <vector>
 
+#include "ImageView.h"
+
 namespace forward::core {
 
+// A single-buffered surface keeps one pixel array: the front views show the
+// back buffer and SwapBuffers() does nothing.
 class Surface32 {
  public:
   Surface32(int width, int height, bool double_buffered);
@@ -19,16 +23,16 @@ class Surface32 {
   void AddBackRgb(uint8_t add_r, uint8_t add_g, uint8_t add_b);
   void SubBackRgb(uint8_t sub_r, uint8_t sub_g, uint8_t sub_b);
 
-  void BlitToBack(const Surface32& src,
+  // Source pixels are read through views, so sub-rectangles of larger images
+  // and other surfaces can be blitted without copying them first.
+  void BlitToBack(const ImageView& src,
                   int src_x,
                   int src_y,
                   int dst_x,
                   int dst_y,
                   int w,
                   int h);
-  void AlphaBlitToBack(const uint32_t* src_pixels,
-                       int src_width,
-                       int src_height,
+  void AlphaBlitToBack(const ImageView& source,
                        int src_x,
                        int src_y,
                        int dst_x,
@@ -36,9 +40,7 @@ class Surface32 {
                        int w,
                        int h,
                        uint8_t global_alpha);
-  void AdditiveBlitToBack(const uint32_t* src_pixels,
-                          int src_width,
-                          int src_height,
+  void AdditiveBlitToBack(const ImageView& source,
                           int src_x,
                           int src_y,
                           int dst_x,
@@ -46,9 +48,16 @@ class Surface32 {
                           int w,
                           int h,
                           uint8_t intensity);
-  void AdditiveBlitScaledToBack(const uint32_t* src_pixels,
-                                int src_width,
-                                int src_height,
+  // Nearest-neighbour stretch of all of `source` over the destination
+  // rectangle. A whole-number upscale, such as a layer rendered at half or
+  // quarter size, takes a faster path.
+  void AlphaBlitScaledToBack(const ImageView& source,
+                             int dst_x,
+                             int dst_y,
+                             int dst_w,
+                             int dst_h,
+                             uint8_t global_alpha);
+  void AdditiveBlitScaledToBack(const ImageView& source,
                                 int dst_x,
                                 int dst_y,
                                 int dst_w,
@@ -57,7 +66,8 @@ class Surface32 {
 
   void SwapBuffers();
 
-  const uint32_t* FrontPixels() const { return front_.data(); }
+  const uint32_t* FrontPixels() const { return double_buffered_ ? front_.data() : back_.data(); }
+  ImageView FrontView() const { return ImageView(FrontPixels(), width_, height_); }
   const uint32_t* BackPixels() const { return back_.data(); }
   uint32_t* BackPixelsMutable() { return back_.data(); }
 
@@ -0,0 +1,115 @@
+#include "TaskGraph.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "Profiler.h"
+
+namespace forward::core {
+
+TaskGraph::~TaskGraph() { Wait(); }
+
+TaskGraph::TaskId TaskGraph::AddTask(std::string name,
+                                     std::function<void()> work,
+                                     const std::vector<TaskId>& dependencies) {
+  const TaskId id = static_cast<TaskId>(tasks_.size());
+  Task task;
+  task.name = std::move(name);
+  task.work = std::move(work);
+  for (TaskId dep : dependencies) {
+    if (dep < 0 || dep >= id) {
+      continue;
+    }
+    tasks_[static_cast<size_t>(dep)].dependents.push_back(id);
+    ++task.pending_dependencies;
+  }
+  tasks_.push_back(std::move(task));
+  return id;
+}
+
+void TaskGraph::Start(int worker_count) {
+  if (started_) {
+    return;
+  }
+  started_ = true;
+
+  for (size_t i = 0; i < tasks_.size(); ++i) {
+    if (tasks_[i].pending_dependencies == 0) {
+      ready_.push_back(static_cast<TaskId>(i));
+    }
+  }
+  if (tasks_.empty()) {
+    return;
+  }
+
+  if (worker_count <= 0) {
+    worker_count = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  worker_count = std::clamp(worker_count, 1, static_cast<int>(tasks_.size()));
+  workers_.reserve(static_cast<size_t>(worker_count));
+  for (int i = 0; i < worker_count; ++i) {
+    workers_.emplace_back(&TaskGraph::WorkerLoop, this);
+  }
+}
+
+void TaskGraph::Wait() {
+  if (!started_) {
+    Start();
+  }
+  for (std::thread& worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+double TaskGraph::TaskSeconds(TaskId id) const {
+  if (id < 0 || id >= static_cast<TaskId>(tasks_.size())) {
+    return 0.0;
+  }
+  return tasks_[static_cast<size_t>(id)].elapsed_seconds;
+}
+
+const std::string& TaskGraph::TaskName(TaskId id) const {
+  static const std::string kEmpty;
+  if (id < 0 || id >= static_cast<TaskId>(tasks_.size())) {
+    return kEmpty;
+  }
+  return tasks_[static_cast<size_t>(id)].name;
+}
+
+void TaskGraph::WorkerLoop() {
+  FORWARD_PROFILE_THREAD("task worker");
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this] { return !ready_.empty() || completed_ == tasks_.size(); });
+    if (ready_.empty()) {
+      return;
+    }
+    const TaskId id = ready_.front();
+    ready_.pop_front();
+    Task& task = tasks_[static_cast<size_t>(id)];
+
+    lock.unlock();
+    const auto begin = std::chrono::steady_clock::now();
+    if (task.work) {
+      FORWARD_PROFILE_ZONE(Profiler::Enabled() ? Profiler::Intern(task.name) : nullptr);
+      task.work();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    lock.lock();
+
+    task.elapsed_seconds = std::chrono::duration<double>(end - begin).count();
+    ++completed_;
+    for (TaskId dependent : task.dependents) {
+      Task& next = tasks_[static_cast<size_t>(dependent)];
+      if (--next.pending_dependencies == 0) {
+        ready_.push_back(dependent);
+      }
+    }
+    cv_.notify_all();
+  }
+}
+
+}  // namespace forward::core
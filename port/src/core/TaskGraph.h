@@ -0,0 +1,64 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace forward::core {
+
+// Small dependency-aware thread pool used for startup asset loading.
+// Tasks are registered up front; a task only runs once all of its
+// dependencies have finished. Dependencies must refer to tasks that were
+// added earlier, which keeps the graph acyclic by construction.
+class TaskGraph {
+ public:
+  using TaskId = int;
+
+  TaskGraph() = default;
+  ~TaskGraph();
+
+  TaskGraph(const TaskGraph&) = delete;
+  TaskGraph& operator=(const TaskGraph&) = delete;
+
+  TaskId AddTask(std::string name,
+                 std::function<void()> work,
+                 const std::vector<TaskId>& dependencies = {});
+
+  // Spawns the worker threads and returns immediately. A worker count <= 0
+  // uses the hardware concurrency.
+  void Start(int worker_count = 0);
+
+  // Blocks until every task has run and joins the workers.
+  void Wait();
+
+  size_t TaskCount() const { return tasks_.size(); }
+  int WorkerCount() const { return static_cast<int>(workers_.size()); }
+  double TaskSeconds(TaskId id) const;
+  const std::string& TaskName(TaskId id) const;
+
+ private:
+  struct Task {
+    std::string name;
+    std::function<void()> work;
+    std::vector<TaskId> dependents;
+    int pending_dependencies = 0;
+    double elapsed_seconds = 0.0;
+  };
+
+  void WorkerLoop();
+
+  std::vector<Task> tasks_;
+  std::vector<std::thread> workers_;
+  std::deque<TaskId> ready_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t completed_ = 0;
+  bool started_ = false;
+};
+
+}  // namespace forward::core
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace forward::core {
+
+// Number scanning shared by the text asset parsers. Works on unterminated
+// buffers (memory-mapped files), accepts an explicit '+' sign like strtod, and
+// falls back to strtod on a bounded copy where the standard library has no
+// floating-point from_chars.
+template <typename T>
+std::from_chars_result ScanNumber(const char* first, const char* last, T* out_value) {
+  const char* begin = (first < last && *first == '+') ? first + 1 : first;
+  if constexpr (std::is_integral_v<T>) {
+    std::from_chars_result result = std::from_chars(begin, last, *out_value);
+    if (result.ptr == begin) {
+      result.ptr = first;
+    }
+    return result;
+  } else {
+#if defined(__cpp_lib_to_chars)
+    std::from_chars_result result = std::from_chars(begin, last, *out_value);
+    if (result.ptr == begin) {
+      result.ptr = first;
+    }
+    return result;
+#else
+    char buffer[64];
+    const size_t length = std::min(static_cast<size_t>(last - begin), sizeof(buffer) - 1);
+    std::memcpy(buffer, begin, length);
+    buffer[length] = '\0';
+    char* end = nullptr;
+    *out_value = static_cast<T>(std::strtod(buffer, &end));
+    if (end == buffer) {
+      return {first, std::errc::invalid_argument};
+    }
+    return {begin + (end - buffer), std::errc()};
+#endif
+  }
+}
+
+// Parses the numeric prefix of `token` ("12:" -> 12), or returns `fallback`.
+template <typename T>
+T ParseNumberPrefix(std::string_view token, T fallback = T{}) {
+  T value{};
+  const std::from_chars_result result = ScanNumber(token.data(), token.data() + token.size(), &value);
+  return (result.ptr != token.data() && result.ec == std::errc()) ? value : fallback;
+}
+
+}  // namespace forward::core
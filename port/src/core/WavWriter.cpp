@@ -0,0 +1,98 @@
+#include "WavWriter.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace forward::core {
+namespace {
+
+void PutLe(uint8_t* out, uint32_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i) {
+    out[i] = static_cast<uint8_t>((value >> (8 * i)) & 0xFFu);
+  }
+}
+
+constexpr size_t kHeaderBytes = 44;
+
+}  // namespace
+
+WavWriter::~WavWriter() { Close(); }
+
+bool WavWriter::Open(const std::string& path,
+                     int sample_rate,
+                     int channels,
+                     std::string* out_error) {
+  Close();
+  if (sample_rate <= 0 || channels <= 0) {
+    if (out_error) {
+      *out_error = "invalid WAV format";
+    }
+    return false;
+  }
+  out_.open(path, std::ios::binary | std::ios::trunc);
+  if (!out_.is_open()) {
+    if (out_error) {
+      *out_error = "cannot open " + path;
+    }
+    return false;
+  }
+  channels_ = channels;
+  frames_written_ = 0;
+
+  const uint32_t block_align = static_cast<uint32_t>(channels) * sizeof(int16_t);
+  uint8_t header[kHeaderBytes] = {};
+  std::copy_n("RIFF", 4, header);
+  std::copy_n("WAVEfmt ", 8, header + 8);
+  PutLe(header + 16, 16, 4);
+  PutLe(header + 20, 1, 2);  // PCM
+  PutLe(header + 22, static_cast<uint32_t>(channels), 2);
+  PutLe(header + 24, static_cast<uint32_t>(sample_rate), 4);
+  PutLe(header + 28, static_cast<uint32_t>(sample_rate) * block_align, 4);
+  PutLe(header + 32, block_align, 2);
+  PutLe(header + 34, 16, 2);
+  std::copy_n("data", 4, header + 36);
+  out_.write(reinterpret_cast<const char*>(header), kHeaderBytes);
+  return out_.good();
+}
+
+bool WavWriter::Write(const int16_t* samples, size_t frame_count) {
+  if (!out_.is_open() || !samples || frame_count == 0) {
+    return out_.is_open();
+  }
+  const size_t sample_count = frame_count * static_cast<size_t>(channels_);
+  uint8_t chunk[4096];
+  size_t done = 0;
+  while (done < sample_count) {
+    const size_t count = std::min(sample_count - done, sizeof(chunk) / 2);
+    for (size_t i = 0; i < count; ++i) {
+      PutLe(chunk + 2 * i, static_cast<uint16_t>(samples[done + i]), 2);
+    }
+    out_.write(reinterpret_cast<const char*>(chunk), static_cast<std::streamsize>(count * 2));
+    done += count;
+  }
+  frames_written_ += frame_count;
+  return out_.good();
+}
+
+bool WavWriter::Close() {
+  if (!out_.is_open()) {
+    return true;
+  }
+  // RIFF sizes are 32-bit; longer recordings keep a saturated header.
+  const uint64_t data_bytes64 =
+      frames_written_ * static_cast<uint64_t>(channels_) * sizeof(int16_t);
+  const uint32_t data_bytes = static_cast<uint32_t>(
+      std::min<uint64_t>(data_bytes64, std::numeric_limits<uint32_t>::max() - kHeaderBytes));
+  uint8_t size_field[4];
+  out_.seekp(4);
+  PutLe(size_field, data_bytes + static_cast<uint32_t>(kHeaderBytes) - 8, 4);
+  out_.write(reinterpret_cast<const char*>(size_field), 4);
+  out_.seekp(40);
+  PutLe(size_field, data_bytes, 4);
+  out_.write(reinterpret_cast<const char*>(size_field), 4);
+  const bool ok = out_.good();
+  out_.close();
+  return ok;
+}
+
+}  // namespace forward::core
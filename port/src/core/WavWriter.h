@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace forward::core {
+
+// Streams interleaved signed 16-bit PCM to a RIFF/WAVE file. The header is
+// written up front with zero sizes and patched by Close().
+class WavWriter {
+ public:
+  WavWriter() = default;
+  ~WavWriter();
+
+  WavWriter(const WavWriter&) = delete;
+  WavWriter& operator=(const WavWriter&) = delete;
+
+  bool Open(const std::string& path, int sample_rate, int channels, std::string* out_error);
+  bool Write(const int16_t* samples, size_t frame_count);
+  bool Close();
+
+  bool IsOpen() const { return out_.is_open(); }
+  uint64_t FramesWritten() const { return frames_written_; }
+
+ private:
+  std::ofstream out_;
+  int channels_ = 0;
+  uint64_t frames_written_ = 0;
+};
+
+}  // namespace forward::core
@@ -1,6 +1,12 @@
 #include "XmPlayer.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <utility>
+
+#include "MappedFile.h"
+#include "Profiler.h"
 
 #ifndef FORWARD_HAS_LIBXMP
 #define FORWARD_HAS_LIBXMP 1
@@ -21,18 +27,146 @@ void SetError(std::string* out_error, const std::string& value) {
 
 }  // namespace
 
+double InterpolateClockMs(const XmTiming& timing, uint64_t now_counter) {
+  const double clock_ms = static_cast<double>(timing.clock_time_ms);
+  if (!timing.valid || timing.host_counter == 0 || now_counter <= timing.host_counter) {
+    return clock_ms;
+  }
+  const double elapsed_ms = 1000.0 * static_cast<double>(now_counter - timing.host_counter) /
+                            static_cast<double>(SDL_GetPerformanceFrequency());
+  return clock_ms + std::min(elapsed_ms, timing.buffer_ms);
+}
+
 XmPlayer::~XmPlayer() { Shutdown(); }
 
+double XmPlayer::InterpolatedClockMs() const {
+  return InterpolateClockMs(GetTiming(), SDL_GetPerformanceCounter());
+}
+
+double XmPlayer::QueuedAudioMs() const {
+  if (obtained_spec_.freq <= 0) {
+    return 0.0;
+  }
+  return static_cast<double>(ring_.Size() * static_cast<size_t>(kMixBlockFrames)) * 1000.0 /
+         static_cast<double>(obtained_spec_.freq);
+}
+
+int XmPlayer::SeekRowCount(int slot) {
+  if (slot < 1 || slot >= static_cast<int>(seek_tables_.size())) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(seek_mutex_);
+  return static_cast<int>(seek_tables_[slot].size());
+}
+
+int XmPlayer::SeekRowIndex(int slot, int order, int row) {
+  if (slot < 1 || slot >= static_cast<int>(seek_tables_.size())) {
+    return -1;
+  }
+  std::lock_guard<std::mutex> lock(seek_mutex_);
+  const std::vector<XmSeekPoint>& table = seek_tables_[slot];
+  const auto it = std::lower_bound(
+      table.begin(), table.end(), std::make_pair(order, row),
+      [](const XmSeekPoint& point, const std::pair<int, int>& target) {
+        return std::make_pair(point.order, point.row) < target;
+      });
+  return it == table.end() ? -1 : static_cast<int>(it - table.begin());
+}
+
+bool XmPlayer::SeekPointAtIndex(int slot, int index, XmSeekPoint* out_point) {
+  if (slot < 1 || slot >= static_cast<int>(seek_tables_.size()) || index < 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(seek_mutex_);
+  const std::vector<XmSeekPoint>& table = seek_tables_[slot];
+  if (index >= static_cast<int>(table.size())) {
+    return false;
+  }
+  if (out_point) {
+    *out_point = table[static_cast<size_t>(index)];
+  }
+  return true;
+}
+
 #if FORWARD_HAS_LIBXMP
 
-bool XmPlayer::Initialize(int sample_rate, int buffer_frames, std::string* out_error) {
-  Shutdown();
+namespace {
+
+void FreeModuleContext(void* handle) {
+  if (!handle) {
+    return;
+  }
+  xmp_context ctx = static_cast<xmp_context>(handle);
+  xmp_end_player(ctx);
+  xmp_release_module(ctx);
+  xmp_free_context(ctx);
+}
 
-  xmp_ctx_ = xmp_create_context();
-  if (!xmp_ctx_) {
+// Plays the module image once on a private context, as fast as it mixes, and
+// records where every order-row is first reached, sorted by order-row. Same
+// rate and frame sequence as playback, so sample positions match what the
+// mixer counts after StartModule().
+bool ScanSeekPoints(const uint8_t* data,
+                    size_t size,
+                    int sample_rate,
+                    const std::string& path,
+                    std::vector<XmSeekPoint>* out_table,
+                    std::string* out_error) {
+  xmp_context scan = xmp_create_context();
+  if (!scan) {
     SetError(out_error, "xmp_create_context failed");
     return false;
   }
+  if (xmp_load_module_from_memory(scan, const_cast<uint8_t*>(data), static_cast<long>(size)) !=
+      0) {
+    xmp_free_context(scan);
+    SetError(out_error, "xmp_load_module_from_memory failed for " + path);
+    return false;
+  }
+  if (xmp_start_player(scan, sample_rate, 0) != 0) {
+    xmp_release_module(scan);
+    xmp_free_context(scan);
+    SetError(out_error, "xmp_start_player failed");
+    return false;
+  }
+
+  std::vector<XmSeekPoint> table;
+  std::vector<bool> seen(256 * 256, false);
+  uint64_t frames = 0;
+  xmp_frame_info info{};
+  while (xmp_play_frame(scan) == 0) {
+    xmp_get_frame_info(scan, &info);
+    if (info.loop_count > 0 || info.buffer_size <= 0) {
+      break;
+    }
+    const size_t key = static_cast<size_t>(((info.pos & 0xFF) << 8) | (info.row & 0xFF));
+    if (!seen[key]) {
+      seen[key] = true;
+      table.push_back({info.pos, info.row, static_cast<int64_t>(info.time), frames});
+    }
+    frames += static_cast<uint64_t>(info.buffer_size) / (2 * sizeof(int16_t));
+  }
+  xmp_end_player(scan);
+  xmp_release_module(scan);
+  xmp_free_context(scan);
+  if (table.empty()) {
+    SetError(out_error, "module produced no rows: " + path);
+    return false;
+  }
+  std::sort(table.begin(), table.end(), [](const XmSeekPoint& a, const XmSeekPoint& b) {
+    return (a.order != b.order) ? a.order < b.order : a.row < b.row;
+  });
+  *out_table = std::move(table);
+  return true;
+}
+
+}  // namespace
+
+bool XmPlayer::Initialize(int sample_rate,
+                          int buffer_frames,
+                          std::string* out_error,
+                          int mix_ahead_ms) {
+  Shutdown();
 
   SDL_AudioSpec desired{};
   desired.freq = sample_rate;
@@ -45,10 +179,74 @@ bool XmPlayer::Initialize(int sample_rate, int buffer_frames, std::string* out_e
   audio_device_ = SDL_OpenAudioDevice(nullptr, 0, &desired, &obtained_spec_, 0);
   if (audio_device_ == 0) {
     SetError(out_error, std::string("SDL_OpenAudioDevice failed: ") + SDL_GetError());
-    xmp_free_context(static_cast<xmp_context>(xmp_ctx_));
-    xmp_ctx_ = nullptr;
     return false;
   }
+
+  // Room for one device buffer plus the requested lead, in whole blocks of
+  // interleaved S16 stereo.
+  const int ahead_frames = std::max(0, mix_ahead_ms) * obtained_spec_.freq / 1000;
+  const int ring_frames = static_cast<int>(obtained_spec_.samples) + ahead_frames;
+  ResetStreams(std::max(2, (ring_frames + kMixBlockFrames - 1) / kMixBlockFrames));
+
+  mix_running_.store(true, std::memory_order_release);
+  mix_thread_ = std::thread(&XmPlayer::MixLoop, this);
+  return true;
+}
+
+bool XmPlayer::InitializeOffline(int sample_rate, std::string* out_error) {
+  Shutdown();
+  if (sample_rate <= 0) {
+    SetError(out_error, "invalid sample rate");
+    return false;
+  }
+
+  obtained_spec_ = SDL_AudioSpec{};
+  obtained_spec_.freq = sample_rate;
+  obtained_spec_.format = AUDIO_S16SYS;
+  obtained_spec_.channels = 2;
+  obtained_spec_.samples = static_cast<Uint16>(kMixBlockFrames);
+  // RenderOffline() consumes at most one block per step, so two always cover
+  // a partly read block plus the next one.
+  ResetStreams(2);
+  offline_ = true;
+  return true;
+}
+
+void XmPlayer::ResetStreams(int block_count) {
+  ring_.Reset(static_cast<size_t>(block_count),
+              static_cast<size_t>(kMixBlockFrames) * 2 * sizeof(int16_t));
+  ring_read_offset_ = 0;
+  underruns_.store(0, std::memory_order_relaxed);
+  row_events_.Reset(256);
+  dropped_row_events_.store(0, std::memory_order_relaxed);
+}
+
+bool XmPlayer::RenderOffline(int frame_count, int16_t* out_pcm) {
+  if (!offline_ || frame_count < 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mix_mutex_);
+  std::array<int16_t, kMixBlockFrames * 2> scratch{};
+  int done = 0;
+  while (done < frame_count) {
+    const int chunk = std::min(frame_count - done, kMixBlockFrames);
+    // Blocks queued before a module switch or seek would keep the ring full
+    // until OnAudio() discarded them, so drop them before mixing.
+    const MixBlockTag* queued = nullptr;
+    while (ring_.AcquireRead(&queued) &&
+           queued->generation != generation_.load(std::memory_order_acquire)) {
+      ring_.ReleaseRead();
+      ring_read_offset_ = 0;
+    }
+    while (ring_.Size() < ring_.Capacity() &&
+           module_playing_.load(std::memory_order_acquire) &&
+           !paused_.load(std::memory_order_acquire)) {
+      MixBlockLocked();
+    }
+    int16_t* target = out_pcm ? out_pcm + static_cast<size_t>(done) * 2 : scratch.data();
+    OnAudio(reinterpret_cast<Uint8*>(target), chunk * 2 * static_cast<int>(sizeof(int16_t)));
+    done += chunk;
+  }
   return true;
 }
 
@@ -61,19 +259,190 @@ bool XmPlayer::LoadModule(int slot, const std::string& path, std::string* out_er
     SetError(out_error, "module path is empty");
     return false;
   }
+  if (obtained_spec_.freq <= 0) {
+    SetError(out_error, "XmPlayer not initialized");
+    return false;
+  }
+
+  MappedFile file;
+  if (!file.Open(path, out_error)) {
+    return false;
+  }
+  xmp_context ctx = xmp_create_context();
+  if (!ctx) {
+    SetError(out_error, "xmp_create_context failed");
+    return false;
+  }
+  // libxmp parses the image into its own structures, so the mapping can go as
+  // soon as this returns. Versions before 4.5 take a non-const pointer.
+  if (xmp_load_module_from_memory(ctx, const_cast<uint8_t*>(file.Data()),
+                                  static_cast<long>(file.Size())) != 0) {
+    xmp_free_context(ctx);
+    SetError(out_error, "xmp_load_module_from_memory failed for " + path);
+    return false;
+  }
+  if (xmp_start_player(ctx, obtained_spec_.freq, 0) != 0) {
+    xmp_release_module(ctx);
+    xmp_free_context(ctx);
+    SetError(out_error, "xmp_start_player failed");
+    return false;
+  }
+  // Built here, from the image already in memory, so the first seek neither
+  // reads the file nor plays the module through. If the scan fails, seeking
+  // retries it from the file.
+  std::vector<XmSeekPoint> table;
+  ScanSeekPoints(file.Data(), file.Size(), obtained_spec_.freq, path, &table, nullptr);
+
+  void* replaced = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mix_mutex_);
+    if (active_module_slot_.load(std::memory_order_acquire) == slot) {
+      module_playing_.store(false, std::memory_order_release);
+      frame_pcm_ = nullptr;
+      frame_bytes_ = 0;
+      frame_offset_ = 0;
+    }
+    replaced = modules_[slot].ctx;
+    modules_[slot] = LoadedModule{ctx, true};
+  }
+  FreeModuleContext(replaced);
+
+  std::lock_guard<std::mutex> lock(seek_mutex_);
+  seek_tables_[slot] = std::move(table);
   module_paths_[slot] = path;
   return true;
 }
 
+bool XmPlayer::BuildSeekTable(int slot, std::string* out_error) {
+  if (slot < 1 || slot >= static_cast<int>(module_paths_.size())) {
+    SetError(out_error, "invalid module slot");
+    return false;
+  }
+  std::string path;
+  {
+    std::lock_guard<std::mutex> lock(seek_mutex_);
+    if (!seek_tables_[slot].empty()) {
+      return true;
+    }
+    path = module_paths_[slot];
+  }
+  if (path.empty() || obtained_spec_.freq <= 0) {
+    SetError(out_error, "module path not loaded for requested slot");
+    return false;
+  }
+
+  // Only reached when the scan in LoadModule() failed.
+  MappedFile file;
+  std::vector<XmSeekPoint> table;
+  if (!file.Open(path, out_error) ||
+      !ScanSeekPoints(file.Data(), file.Size(), obtained_spec_.freq, path, &table, out_error)) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(seek_mutex_);
+  if (module_paths_[slot] == path && seek_tables_[slot].empty()) {
+    seek_tables_[slot] = std::move(table);
+  }
+  return true;
+}
+
+bool XmPlayer::FindSeekPoint(int slot,
+                             int order,
+                             int row,
+                             XmSeekPoint* out_point,
+                             std::string* out_error) {
+  if (!BuildSeekTable(slot, out_error)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(seek_mutex_);
+  const std::vector<XmSeekPoint>& table = seek_tables_[slot];
+  const auto it = std::lower_bound(
+      table.begin(), table.end(), std::make_pair(order, row),
+      [](const XmSeekPoint& point, const std::pair<int, int>& target) {
+        return std::make_pair(point.order, point.row) < target;
+      });
+  if (it == table.end()) {
+    SetError(out_error, "order-row is past the end of the module");
+    return false;
+  }
+  if (out_point) {
+    *out_point = *it;
+  }
+  return true;
+}
+
+bool XmPlayer::SeekToOrderRow(int order, int row, XmSeekPoint* out_point, std::string* out_error) {
+  const int slot = active_module_slot_.load(std::memory_order_acquire);
+  XmSeekPoint point;
+  // Built before taking mix_mutex_ so the mixer keeps running meanwhile.
+  if (!FindSeekPoint(slot, order, row, &point, out_error)) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mix_mutex_);
+  if (!module_playing_.load(std::memory_order_acquire) ||
+      active_module_slot_.load(std::memory_order_acquire) != slot) {
+    SetError(out_error, "no module playing");
+    return false;
+  }
+  xmp_set_position(static_cast<xmp_context>(modules_[slot].ctx), point.order);
+  frame_pcm_ = nullptr;
+  frame_bytes_ = 0;
+  frame_offset_ = 0;
+  // Rows before the target within its order are played silently so notes
+  // already sounding there carry over. A scheduled switch waits until the
+  // target is reached and then fires on the next row start it covers.
+  const ModuleSwitch held_switch = pending_switch_;
+  pending_switch_.armed = false;
+  bool reached = false;
+  while (MixFrameLocked()) {
+    if (frame_position_.order == point.order && frame_position_.row == point.row) {
+      reached = true;
+      break;
+    }
+    if (frame_position_.order != point.order) {
+      break;
+    }
+  }
+  pending_switch_ = held_switch;
+  if (!reached) {
+    SetError(out_error, "seek target was not reached");
+    return false;
+  }
+  frame_starts_row_ = true;
+  mixed_frames_ = point.sample_position;
+
+  if (!offline_) {
+    SDL_LockAudioDevice(audio_device_);
+  }
+  generation_.fetch_add(1, std::memory_order_acq_rel);
+  ring_read_offset_ = 0;
+  XmTiming timing;
+  timing.valid = true;
+  timing.module_slot = slot;
+  timing.order = point.order;
+  timing.row = point.row;
+  timing.speed = frame_position_.speed;
+  timing.bpm = frame_position_.bpm;
+  timing.module_time_ms = point.module_time_ms;
+  timing.clock_time_ms = clock_base_ms_ + point.module_time_ms;
+  timing_.Store(timing);
+  if (!offline_) {
+    SDL_UnlockAudioDevice(audio_device_);
+  }
+  if (out_point) {
+    *out_point = point;
+  }
+  return true;
+}
+
 bool XmPlayer::StartModule(int slot, bool loop, std::string* out_error) {
-  if (audio_device_ == 0 || !xmp_ctx_) {
+  if (audio_device_ == 0 && !offline_) {
     SetError(out_error, "XmPlayer not initialized");
     return false;
   }
-  SDL_LockAudioDevice(audio_device_);
-  const bool ok = StartModuleLocked(slot, loop, out_error);
-  SDL_UnlockAudioDevice(audio_device_);
-  return ok;
+  std::lock_guard<std::mutex> lock(mix_mutex_);
+  return StartModuleLocked(slot, loop, out_error);
 }
 
 bool XmPlayer::StartModuleLocked(int slot, bool loop, std::string* out_error) {
@@ -81,42 +450,83 @@ bool XmPlayer::StartModuleLocked(int slot, bool loop, std::string* out_error) {
     SetError(out_error, "invalid module slot");
     return false;
   }
-  if (module_paths_[slot].empty()) {
-    SetError(out_error, "module path not loaded for requested slot");
+  if (!modules_[slot].ctx) {
+    SetError(out_error, "module not loaded for requested slot");
     return false;
   }
 
-  xmp_context ctx = static_cast<xmp_context>(xmp_ctx_);
-  if (module_loaded_in_context_.load(std::memory_order_acquire)) {
-    xmp_end_player(ctx);
-    xmp_release_module(ctx);
-    module_loaded_in_context_.store(false, std::memory_order_release);
+  // Players left mid-song by an earlier run are rewound here, so a scheduled
+  // switch always finds its target at the start.
+  pending_switch_ = ModuleSwitch{};
+  for (int i = 1; i < static_cast<int>(modules_.size()); ++i) {
+    if (modules_[i].ctx && !RestartPlayerLocked(i) && i == slot) {
+      SetError(out_error, "xmp_start_player failed");
+      return false;
+    }
   }
+  ActivateModuleLocked(slot, loop);
 
-  if (xmp_load_module(ctx, module_paths_[slot].c_str()) != 0) {
-    SetError(out_error, "xmp_load_module failed");
-    return false;
+  // Only this short section excludes the callback: it retires the blocks queued
+  // for the previous module and restarts the published timing. The offline
+  // backend mixes under mix_mutex_, which is already held.
+  if (!offline_) {
+    SDL_LockAudioDevice(audio_device_);
+  }
+  generation_.fetch_add(1, std::memory_order_acq_rel);
+  ring_read_offset_ = 0;
+  XmTiming restart;
+  restart.module_slot = slot;
+  restart.clock_time_ms = timing_.Load().clock_time_ms;
+  clock_base_ms_ = restart.clock_time_ms;
+  timing_.Store(restart);
+  if (!offline_) {
+    SDL_UnlockAudioDevice(audio_device_);
+    SDL_PauseAudioDevice(audio_device_, paused_.load(std::memory_order_acquire) ? 1 : 0);
+  }
+  return true;
+}
+
+void XmPlayer::ScheduleModuleSwitch(int from_slot, int order, int row, int to_slot, bool loop) {
+  const int slot_count = static_cast<int>(modules_.size());
+  if (from_slot < 1 || from_slot >= slot_count || to_slot < 1 || to_slot >= slot_count) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mix_mutex_);
+  if (modules_[to_slot].ctx &&
+      (to_slot != active_module_slot_.load(std::memory_order_acquire) ||
+       !module_playing_.load(std::memory_order_acquire))) {
+    RestartPlayerLocked(to_slot);
   }
+  pending_switch_.armed = true;
+  pending_switch_.from_slot = from_slot;
+  pending_switch_.order_row = ((order & 0xFF) << 8) | (row & 0xFF);
+  pending_switch_.to_slot = to_slot;
+  pending_switch_.loop = loop;
+}
+
+bool XmPlayer::RestartPlayerLocked(int slot) {
+  LoadedModule& module = modules_[static_cast<size_t>(slot)];
+  if (module.fresh) {
+    return true;
+  }
+  xmp_context ctx = static_cast<xmp_context>(module.ctx);
+  xmp_end_player(ctx);
   if (xmp_start_player(ctx, obtained_spec_.freq, 0) != 0) {
-    xmp_release_module(ctx);
-    SetError(out_error, "xmp_start_player failed");
     return false;
   }
+  module.fresh = true;
+  return true;
+}
 
+void XmPlayer::ActivateModuleLocked(int slot, bool loop) {
+  modules_[static_cast<size_t>(slot)].fresh = false;
   loop_current_module_.store(loop, std::memory_order_release);
-  module_loaded_in_context_.store(true, std::memory_order_release);
+  frame_pcm_ = nullptr;
+  frame_bytes_ = 0;
+  frame_offset_ = 0;
+  mixed_frames_ = 0;
   active_module_slot_.store(slot, std::memory_order_release);
-
-  const int64_t current_clock_ms = clock_time_ms_.load(std::memory_order_acquire);
-  module_base_time_ms_.store(current_clock_ms, std::memory_order_release);
-  module_time_ms_.store(0, std::memory_order_release);
-  order_.store(0, std::memory_order_release);
-  row_.store(0, std::memory_order_release);
-  speed_.store(0, std::memory_order_release);
-  bpm_.store(0, std::memory_order_release);
-  timing_valid_.store(false, std::memory_order_release);
-  SDL_PauseAudioDevice(audio_device_, paused_.load(std::memory_order_acquire) ? 1 : 0);
-  return true;
+  module_playing_.store(true, std::memory_order_release);
 }
 
 void XmPlayer::SetPaused(bool paused) {
@@ -126,51 +536,36 @@ void XmPlayer::SetPaused(bool paused) {
   }
 }
 
-XmTiming XmPlayer::GetTiming() const {
-  XmTiming out;
-  out.valid = timing_valid_.load(std::memory_order_acquire);
-  out.module_slot = active_module_slot_.load(std::memory_order_acquire);
-  out.order = order_.load(std::memory_order_acquire);
-  out.row = row_.load(std::memory_order_acquire);
-  out.speed = speed_.load(std::memory_order_acquire);
-  out.bpm = bpm_.load(std::memory_order_acquire);
-  out.module_time_ms = module_time_ms_.load(std::memory_order_acquire);
-  out.clock_time_ms = clock_time_ms_.load(std::memory_order_acquire);
-  return out;
-}
+XmTiming XmPlayer::GetTiming() const { return timing_.Load(); }
 
-bool XmPlayer::IsReady() const { return audio_device_ != 0 && xmp_ctx_ != nullptr; }
+bool XmPlayer::IsReady() const { return audio_device_ != 0 || offline_; }
 
 void XmPlayer::Shutdown() {
+  StopMixThread();
   if (audio_device_ != 0) {
     SDL_PauseAudioDevice(audio_device_, 1);
-    SDL_LockAudioDevice(audio_device_);
-    if (xmp_ctx_ && module_loaded_in_context_.load(std::memory_order_acquire)) {
-      xmp_end_player(static_cast<xmp_context>(xmp_ctx_));
-      xmp_release_module(static_cast<xmp_context>(xmp_ctx_));
-      module_loaded_in_context_.store(false, std::memory_order_release);
-    }
-    SDL_UnlockAudioDevice(audio_device_);
     SDL_CloseAudioDevice(audio_device_);
     audio_device_ = 0;
   }
-
-  if (xmp_ctx_) {
-    xmp_free_context(static_cast<xmp_context>(xmp_ctx_));
-    xmp_ctx_ = nullptr;
+  for (LoadedModule& module : modules_) {
+    FreeModuleContext(module.ctx);
+    module = LoadedModule{};
   }
-  module_paths_.fill({});
+  pending_switch_ = ModuleSwitch{};
+  clock_base_ms_ = 0;
+  module_playing_.store(false, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(seek_mutex_);
+    module_paths_.fill({});
+    for (std::vector<XmSeekPoint>& table : seek_tables_) {
+      table.clear();
+    }
+  }
+  offline_ = false;
   loop_current_module_.store(false, std::memory_order_release);
   paused_.store(false, std::memory_order_release);
-  timing_valid_.store(false, std::memory_order_release);
   active_module_slot_.store(0, std::memory_order_release);
-  order_.store(0, std::memory_order_release);
-  row_.store(0, std::memory_order_release);
-  speed_.store(0, std::memory_order_release);
-  bpm_.store(0, std::memory_order_release);
-  module_time_ms_.store(0, std::memory_order_release);
-  clock_time_ms_.store(0, std::memory_order_release);
-  module_base_time_ms_.store(0, std::memory_order_release);
+  timing_.Store(XmTiming{});
 }
 
 void XmPlayer::SDLAudioCallback(void* userdata, Uint8* stream, int len) {
@@ -181,53 +576,269 @@ void XmPlayer::SDLAudioCallback(void* userdata, Uint8* stream, int len) {
 }
 
 void XmPlayer::OnAudio(Uint8* stream, int len) {
-  std::memset(stream, 0, static_cast<size_t>(len));
-  if (!xmp_ctx_ || !module_loaded_in_context_.load(std::memory_order_acquire) ||
-      paused_.load(std::memory_order_acquire)) {
-    return;
+  // Offline there is no host clock to interpolate against.
+  const uint64_t host_counter = offline_ ? 0 : SDL_GetPerformanceCounter();
+  const size_t total = static_cast<size_t>(len);
+  size_t written = 0;
+  // Copied: once released, a block's slot may be refilled by the mixer.
+  MixBlockTag started;
+  bool any_started = false;
+  if (!paused_.load(std::memory_order_acquire)) {
+    const uint32_t generation = generation_.load(std::memory_order_acquire);
+    const size_t block_bytes = ring_.BlockBytes();
+    while (written < total) {
+      const MixBlockTag* tag = nullptr;
+      const uint8_t* block = ring_.AcquireRead(&tag);
+      if (!block) {
+        if (module_playing_.load(std::memory_order_acquire)) {
+          underruns_.fetch_add(1, std::memory_order_relaxed);
+        }
+        break;
+      }
+      if (tag->generation != generation) {
+        ring_.ReleaseRead();
+        ring_read_offset_ = 0;
+        continue;
+      }
+      if (ring_read_offset_ == 0) {
+        started = *tag;
+        any_started = true;
+        for (int i = 0; i < tag->row_start_count; ++i) {
+          if (!row_events_.TryPush(tag->row_starts[static_cast<size_t>(i)])) {
+            dropped_row_events_.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      }
+      const size_t count = std::min(total - written, block_bytes - ring_read_offset_);
+      std::memcpy(stream + written, block + ring_read_offset_, count);
+      written += count;
+      ring_read_offset_ += count;
+      if (ring_read_offset_ == block_bytes) {
+        ring_.ReleaseRead();
+        ring_read_offset_ = 0;
+      }
+    }
   }
+  if (written < total) {
+    std::memset(stream + written, 0, total - written);
+  }
+  if (any_started) {
+    const double buffer_ms = 1000.0 * static_cast<double>(total / (2 * sizeof(int16_t))) /
+                             static_cast<double>(std::max(1, obtained_spec_.freq));
+    PublishTiming(started, host_counter, buffer_ms);
+  }
+}
 
-  xmp_context ctx = static_cast<xmp_context>(xmp_ctx_);
-  const int loop_flag = loop_current_module_.load(std::memory_order_acquire) ? 1 : 0;
-  const int result = xmp_play_buffer(ctx, stream, len, loop_flag);
-  if (result < 0 && result != -XMP_END) {
-    timing_valid_.store(false, std::memory_order_release);
+void XmPlayer::PublishTiming(const MixBlockTag& tag, uint64_t host_counter, double buffer_ms) {
+  XmTiming timing;
+  timing.module_slot = tag.module_slot;
+  timing.host_counter = host_counter;
+  timing.buffer_ms = buffer_ms;
+  if (!tag.timing_valid) {
+    timing.clock_time_ms = timing_.Load().clock_time_ms;
+    timing_.Store(timing);
     return;
   }
+  timing.valid = true;
+  timing.order = tag.order;
+  timing.row = tag.row;
+  timing.speed = tag.speed;
+  timing.bpm = tag.bpm;
+  timing.module_time_ms = tag.module_time_ms;
+  timing.clock_time_ms = tag.clock_base_ms + tag.module_time_ms;
+  timing_.Store(timing);
+}
+
+void XmPlayer::MixLoop() {
+  FORWARD_PROFILE_THREAD("xm mixer");
+  while (mix_running_.load(std::memory_order_acquire)) {
+    bool mixed = false;
+    {
+      std::lock_guard<std::mutex> lock(mix_mutex_);
+      if (module_playing_.load(std::memory_order_acquire) &&
+          !paused_.load(std::memory_order_acquire)) {
+        mixed = MixBlockLocked();
+      }
+    }
+    if (!mixed) {
+      // Ring full, paused or idle: one block lasts ~5 ms, so a 1 ms nap keeps
+      // the lead topped up without spinning.
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+}
 
+bool XmPlayer::MixBlockLocked() {
+  MixBlockTag* tag = nullptr;
+  uint8_t* block = ring_.AcquireWrite(&tag);
+  if (!block) {
+    return false;
+  }
+  FORWARD_PROFILE_ZONE("xm.mix");
+
+  // Copies whole xmp frames (one tick each) instead of calling
+  // xmp_play_buffer(), so every row start is seen with its exact sample offset.
+  const size_t block_bytes = ring_.BlockBytes();
+  const size_t frame_size = 2 * sizeof(int16_t);
+  *tag = MixBlockTag{};
+  tag->generation = generation_.load(std::memory_order_acquire);
+  tag->module_slot = active_module_slot_.load(std::memory_order_acquire);
+  tag->clock_base_ms = clock_base_ms_;
+  tag->sample_position = mixed_frames_;
+  // Position of the block's first sample; after the end of a module, the last
+  // position played. Restamped after the first frame, which may switch module.
+  auto stamp_position = [&]() {
+    const int64_t frames_into_tick = static_cast<int64_t>(frame_offset_ / frame_size);
+    tag->module_slot = active_module_slot_.load(std::memory_order_relaxed);
+    tag->clock_base_ms = clock_base_ms_;
+    tag->sample_position = mixed_frames_;
+    tag->timing_valid = true;
+    tag->order = frame_position_.order;
+    tag->row = frame_position_.row;
+    tag->speed = frame_position_.speed;
+    tag->bpm = frame_position_.bpm;
+    tag->module_time_ms = frame_position_.module_time_ms +
+                          frames_into_tick * 1000 / std::max(1, obtained_spec_.freq);
+  };
+
+  size_t filled = 0;
+  bool ended = false;
+  while (filled < block_bytes) {
+    if (frame_offset_ >= frame_bytes_) {
+      if (!MixFrameLocked()) {
+        ended = true;
+        break;
+      }
+    }
+    if (frame_offset_ == 0 && frame_starts_row_ && tag->row_start_count < kMaxRowStartsPerBlock) {
+      XmRowEvent& event = tag->row_starts[static_cast<size_t>(tag->row_start_count++)];
+      event.module_slot = active_module_slot_.load(std::memory_order_relaxed);
+      event.order = frame_position_.order;
+      event.row = frame_position_.row;
+      event.sample_position = mixed_frames_;
+    }
+    if (filled == 0) {
+      stamp_position();
+    }
+    const size_t count = std::min(block_bytes - filled, frame_bytes_ - frame_offset_);
+    std::memcpy(block + filled, frame_pcm_ + frame_offset_, count);
+    filled += count;
+    frame_offset_ += count;
+    mixed_frames_ += count / frame_size;
+  }
+  if (filled < block_bytes) {
+    std::memset(block + filled, 0, block_bytes - filled);
+  }
+  if (filled == 0 && mixed_frames_ > 0) {
+    stamp_position();
+  }
+  ring_.CommitWrite();
+
+  // The module stays loaded; StartModule() rewinds it.
+  if (ended && !loop_current_module_.load(std::memory_order_acquire)) {
+    module_playing_.store(false, std::memory_order_release);
+  }
+  return true;
+}
+
+bool XmPlayer::MixFrameLocked() {
+  const int slot = active_module_slot_.load(std::memory_order_relaxed);
+  xmp_context ctx = static_cast<xmp_context>(modules_[static_cast<size_t>(slot)].ctx);
+  if (!ctx) {
+    return false;
+  }
+  const int loop_flag = loop_current_module_.load(std::memory_order_acquire) ? 1 : 0;
+  const int result = xmp_play_frame(ctx);
   xmp_frame_info info{};
   xmp_get_frame_info(ctx, &info);
+  // Same end-of-module rule as xmp_play_buffer(): a positive flag is the
+  // number of loops to play, zero plays forever.
+  if (result < 0 || (loop_flag > 0 && info.loop_count >= loop_flag) || info.buffer_size <= 0) {
+    frame_pcm_ = nullptr;
+    frame_bytes_ = 0;
+    frame_offset_ = 0;
+    return false;
+  }
 
-  const int64_t module_ms = static_cast<int64_t>(info.time);
-  const int64_t absolute_ms = module_base_time_ms_.load(std::memory_order_acquire) + module_ms;
-  module_time_ms_.store(module_ms, std::memory_order_release);
-  clock_time_ms_.store(absolute_ms, std::memory_order_release);
-  order_.store(info.pos, std::memory_order_release);
-  row_.store(info.row, std::memory_order_release);
-  speed_.store(info.speed, std::memory_order_release);
-  bpm_.store(info.bpm, std::memory_order_release);
-  timing_valid_.store(true, std::memory_order_release);
-
-  if (result == -XMP_END && !loop_current_module_.load(std::memory_order_acquire)) {
-    module_loaded_in_context_.store(false, std::memory_order_release);
-    xmp_end_player(ctx);
-    xmp_release_module(ctx);
+  // The first frame after a switch always starts a row.
+  frame_starts_row_ = frame_pcm_ == nullptr || info.pos != frame_position_.order ||
+                      info.row != frame_position_.row;
+  const ModuleSwitch next = pending_switch_;
+  if (frame_starts_row_ && next.armed && slot == next.from_slot &&
+      (((info.pos & 0xFF) << 8) | (info.row & 0xFF)) >= next.order_row) {
+    pending_switch_.armed = false;
+    if (modules_[static_cast<size_t>(next.to_slot)].ctx && RestartPlayerLocked(next.to_slot)) {
+      // This frame of the old module is never heard: the new module's first
+      // frame takes its place, and its clock starts where this row would have.
+      clock_base_ms_ += static_cast<int64_t>(info.time);
+      ActivateModuleLocked(next.to_slot, next.loop);
+      return MixFrameLocked();
+    }
+  }
+  frame_pcm_ = static_cast<const uint8_t*>(info.buffer);
+  frame_bytes_ = static_cast<size_t>(info.buffer_size);
+  frame_offset_ = 0;
+  frame_position_.order = info.pos;
+  frame_position_.row = info.row;
+  frame_position_.speed = info.speed;
+  frame_position_.bpm = info.bpm;
+  frame_position_.module_time_ms = static_cast<int64_t>(info.time);
+  return true;
+}
+
+void XmPlayer::StopMixThread() {
+  mix_running_.store(false, std::memory_order_release);
+  if (mix_thread_.joinable()) {
+    mix_thread_.join();
   }
 }
 
 #else
 
-bool XmPlayer::Initialize(int /*sample_rate*/, int /*buffer_frames*/, std::string* out_error) {
+bool XmPlayer::Initialize(int /*sample_rate*/,
+                          int /*buffer_frames*/,
+                          std::string* out_error,
+                          int /*mix_ahead_ms*/) {
   Shutdown();
   SetError(out_error, "libxmp support is disabled at build time");
   return false;
 }
 
+bool XmPlayer::InitializeOffline(int /*sample_rate*/, std::string* out_error) {
+  Shutdown();
+  SetError(out_error, "libxmp support is disabled at build time");
+  return false;
+}
+
+bool XmPlayer::RenderOffline(int /*frame_count*/, int16_t* /*out_pcm*/) { return false; }
+
 bool XmPlayer::LoadModule(int /*slot*/, const std::string& /*path*/, std::string* out_error) {
   SetError(out_error, "libxmp support is disabled at build time");
   return false;
 }
 
+bool XmPlayer::BuildSeekTable(int /*slot*/, std::string* out_error) {
+  SetError(out_error, "libxmp support is disabled at build time");
+  return false;
+}
+
+bool XmPlayer::FindSeekPoint(int /*slot*/,
+                             int /*order*/,
+                             int /*row*/,
+                             XmSeekPoint* /*out_point*/,
+                             std::string* out_error) {
+  SetError(out_error, "libxmp support is disabled at build time");
+  return false;
+}
+
+bool XmPlayer::SeekToOrderRow(int /*order*/,
+                              int /*row*/,
+                              XmSeekPoint* /*out_point*/,
+                              std::string* out_error) {
+  SetError(out_error, "libxmp support is disabled at build time");
+  return false;
+}
+
 bool XmPlayer::StartModule(int /*slot*/, bool /*loop*/, std::string* out_error) {
   SetError(out_error, "libxmp support is disabled at build time");
   return false;
@@ -238,6 +849,12 @@ bool XmPlayer::StartModuleLocked(int /*slot*/, bool /*loop*/, std::string* out_e
   return false;
 }
 
+void XmPlayer::ScheduleModuleSwitch(int /*from_slot*/,
+                                    int /*order*/,
+                                    int /*row*/,
+                                    int /*to_slot*/,
+                                    bool /*loop*/) {}
+
 void XmPlayer::SetPaused(bool paused) {
   paused_.store(paused, std::memory_order_release);
 }
@@ -247,24 +864,17 @@ XmTiming XmPlayer::GetTiming() const { return XmTiming{}; }
 bool XmPlayer::IsReady() const { return false; }
 
 void XmPlayer::Shutdown() {
-  xmp_ctx_ = nullptr;
   if (audio_device_ != 0) {
     SDL_CloseAudioDevice(audio_device_);
     audio_device_ = 0;
   }
   module_paths_.fill({});
-  module_loaded_in_context_.store(false, std::memory_order_release);
+  offline_ = false;
+  module_playing_.store(false, std::memory_order_release);
   loop_current_module_.store(false, std::memory_order_release);
   paused_.store(false, std::memory_order_release);
-  timing_valid_.store(false, std::memory_order_release);
   active_module_slot_.store(0, std::memory_order_release);
-  order_.store(0, std::memory_order_release);
-  row_.store(0, std::memory_order_release);
-  speed_.store(0, std::memory_order_release);
-  bpm_.store(0, std::memory_order_release);
-  module_time_ms_.store(0, std::memory_order_release);
-  clock_time_ms_.store(0, std::memory_order_release);
-  module_base_time_ms_.store(0, std::memory_order_release);
+  timing_.Store(XmTiming{});
 }
 
 void XmPlayer::SDLAudioCallback(void* /*userdata*/, Uint8* /*stream*/, int /*len*/) {}
@@ -5,7 +5,14 @@
 #include <array>
 #include <atomic>
 #include <cstdint>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include "SeqLock.h"
+#include "SpscBlockRing.h"
+#include "SpscQueue.h"
 
 namespace forward::core {
 
@@ -18,48 +25,214 @@ struct XmTiming {
   int bpm = 0;
   int64_t module_time_ms = 0;
   int64_t clock_time_ms = 0;
+  // SDL performance counter read when the device callback published this
+  // snapshot, and the duration of the audio that callback handed over.
+  uint64_t host_counter = 0;
+  double buffer_ms = 0.0;
+};
+
+// A pattern row starting, in the order the device receives it.
+struct XmRowEvent {
+  int module_slot = 0;
+  int order = 0;
+  int row = 0;
+  // Output frames of this module that precede the row's first sample.
+  uint64_t sample_position = 0;
+};
+
+// Where playback of a module first reaches an order-row.
+struct XmSeekPoint {
+  int order = 0;
+  int row = 0;
+  int64_t module_time_ms = 0;
+  // Output frames of the module before the row's first sample, at the
+  // player's sample rate.
+  uint64_t sample_position = 0;
 };
 
+// `timing.clock_time_ms` advanced by the host time elapsed since it was
+// published, capped at one device buffer so the clock never runs ahead of the
+// audio queued by that callback. Between callbacks this ramps smoothly instead
+// of stepping once per buffer.
+double InterpolateClockMs(const XmTiming& timing, uint64_t now_counter);
+
+// Plays the demo's XM modules through libxmp. A dedicated mixing thread renders
+// ahead into a ring of PCM blocks tagged with their playback position; the SDL
+// audio callback only copies blocks out and publishes the tag of the block
+// that reaches the device, along with the row starts inside it. Every slot
+// owns an xmp context whose module is parsed from memory and whose player is
+// started by LoadModule(), so starting or switching modules does no file I/O
+// and only swaps the context the mixer reads from.
+//
+// InitializeOffline() selects a backend with no SDL device and no mixing
+// thread: the caller pulls audio with RenderOffline() at whatever pace it
+// likes, and timing and row events are published exactly as the device
+// callback would.
 class XmPlayer {
  public:
+  static constexpr int kMixBlockFrames = 256;
+  static constexpr int kDefaultMixAheadMs = 60;
+  // A row lasts at least one tick (~10 ms at 255 bpm), longer than a block at
+  // any supported rate, so this bound is never reached in practice.
+  static constexpr int kMaxRowStartsPerBlock = 4;
+
   XmPlayer() = default;
   ~XmPlayer();
 
   XmPlayer(const XmPlayer&) = delete;
   XmPlayer& operator=(const XmPlayer&) = delete;
 
-  bool Initialize(int sample_rate, int buffer_frames, std::string* out_error);
+  // `buffer_frames` is the device buffer size; `mix_ahead_ms` is how much audio
+  // the mixing thread keeps queued on top of it.
+  bool Initialize(int sample_rate,
+                  int buffer_frames,
+                  std::string* out_error,
+                  int mix_ahead_ms = kDefaultMixAheadMs);
+  bool InitializeOffline(int sample_rate, std::string* out_error);
+  // Requires Initialize() or InitializeOffline(): the player is started at the
+  // device rate. Reloading the playing slot stops playback.
   bool LoadModule(int slot, const std::string& path, std::string* out_error);
+  // Plays `slot` from its start right away; queued audio is dropped and any
+  // scheduled switch is cancelled.
   bool StartModule(int slot, bool loop, std::string* out_error);
+  // Has the mixer move from `from_slot` to `to_slot` at the first row start
+  // of `from_slot` at or after (order, row): the new module's first sample
+  // directly follows the last one before that row, and its clock continues
+  // from there. Replaces any earlier request.
+  void ScheduleModuleSwitch(int from_slot, int order, int row, int to_slot, bool loop);
   void SetPaused(bool paused);
 
+  // Offline backend only: mixes `frame_count` interleaved S16 stereo frames on
+  // the calling thread and copies them to `out_pcm` when it is not null.
+  bool RenderOffline(int frame_count, int16_t* out_pcm);
+  bool IsOffline() const { return offline_; }
+  int SampleRate() const { return obtained_spec_.freq; }
+
+  // Order-row table of `slot`'s module: where every order-row is first reached
+  // when the module is played once, as fast as it mixes, on a private context.
+  // LoadModule() builds it from the image it loaded; this returns at once
+  // unless that scan failed, in which case it retries from the file. Thread-safe.
+  bool BuildSeekTable(int slot, std::string* out_error);
+  // First point of `slot`'s table at or after (order, row); builds the table
+  // on first use.
+  bool FindSeekPoint(int slot, int order, int row, XmSeekPoint* out_point, std::string* out_error);
+  // Rows of `slot`'s playback as counted by its table, so index arithmetic
+  // follows the module's own pattern lengths. These never build the table:
+  // SeekRowIndex() is -1 without one or past the end.
+  int SeekRowCount(int slot);
+  int SeekRowIndex(int slot, int order, int row);
+  bool SeekPointAtIndex(int slot, int index, XmSeekPoint* out_point);
+  // Repositions the playing module at FindSeekPoint(order, row): queued audio
+  // is dropped, mixing resumes at that row with its table sample position and
+  // the timing snapshot jumps there immediately.
+  bool SeekToOrderRow(int order, int row, XmSeekPoint* out_point, std::string* out_error);
+
+  // A coherent snapshot of the last published position.
   XmTiming GetTiming() const;
+  // InterpolateClockMs() of the current snapshot at the current host time.
+  double InterpolatedClockMs() const;
   bool IsReady() const;
+  // Mixed audio waiting in the ring for the device; a snapshot.
+  double QueuedAudioMs() const;
+  // Device callbacks that found the ring empty and padded with silence.
+  uint32_t UnderrunCount() const { return underruns_.load(std::memory_order_relaxed); }
+
+  // Next row start handed to the device, oldest first; a single consumer
+  // thread should drain this every frame. Events that found the queue full
+  // are dropped and counted.
+  bool PopRowEvent(XmRowEvent* out_event) { return row_events_.TryPop(out_event); }
+  uint32_t DroppedRowEventCount() const {
+    return dropped_row_events_.load(std::memory_order_relaxed);
+  }
 
   void Shutdown();
 
  private:
+  struct MixBlockTag {
+    uint32_t generation = 0;
+    bool timing_valid = false;
+    int module_slot = 0;
+    int order = 0;
+    int row = 0;
+    int speed = 0;
+    int bpm = 0;
+    int64_t module_time_ms = 0;
+    // Clock time at which the block's module started playing.
+    int64_t clock_base_ms = 0;
+    // Module output frames before this block's first sample.
+    uint64_t sample_position = 0;
+    int row_start_count = 0;
+    std::array<XmRowEvent, kMaxRowStartsPerBlock> row_starts{};
+  };
+
   static void SDLAudioCallback(void* userdata, Uint8* stream, int len);
   void OnAudio(Uint8* stream, int len);
+  void ResetStreams(int block_count);
+  void PublishTiming(const MixBlockTag& tag, uint64_t host_counter, double buffer_ms);
   bool StartModuleLocked(int slot, bool loop, std::string* out_error);
+  void MixLoop();
+  bool MixBlockLocked();
+  bool MixFrameLocked();
+  bool RestartPlayerLocked(int slot);
+  void ActivateModuleLocked(int slot, bool loop);
+  void StopMixThread();
+
+  struct LoadedModule {
+    void* ctx = nullptr;
+    // The player sits at the module start and has not been mixed from yet.
+    bool fresh = false;
+  };
+  struct ModuleSwitch {
+    bool armed = false;
+    int from_slot = 0;
+    int order_row = 0;
+    int to_slot = 0;
+    bool loop = false;
+  };
 
-  void* xmp_ctx_ = nullptr;
   SDL_AudioDeviceID audio_device_ = 0;
+  bool offline_ = false;
   SDL_AudioSpec obtained_spec_{};
   std::array<std::string, 3> module_paths_;
-  std::atomic<bool> module_loaded_in_context_{false};
+  // Guarded by mix_mutex_; a slot's context is only freed once it is unlinked.
+  std::array<LoadedModule, 3> modules_;
+  std::atomic<bool> module_playing_{false};
   std::atomic<bool> loop_current_module_{false};
 
   std::atomic<bool> paused_{false};
-  std::atomic<bool> timing_valid_{false};
   std::atomic<int> active_module_slot_{0};
-  std::atomic<int> order_{0};
-  std::atomic<int> row_{0};
-  std::atomic<int> speed_{0};
-  std::atomic<int> bpm_{0};
-  std::atomic<int64_t> module_time_ms_{0};
-  std::atomic<int64_t> clock_time_ms_{0};
-  std::atomic<int64_t> module_base_time_ms_{0};
+  // Written by the audio callback, and by module switches and Shutdown while
+  // the callback is excluded.
+  SeqLock<XmTiming> timing_;
+
+  // Guards the xmp context between the mixing thread and module switches;
+  // never taken by the audio callback.
+  std::mutex mix_mutex_;
+  std::thread mix_thread_;
+  std::atomic<bool> mix_running_{false};
+  SpscBlockRing<MixBlockTag> ring_;
+  // Bumped on every module switch; the callback drops blocks of older ones.
+  std::atomic<uint32_t> generation_{0};
+  size_t ring_read_offset_ = 0;
+  std::atomic<uint32_t> underruns_{0};
+  SpscQueue<XmRowEvent> row_events_;
+  std::atomic<uint32_t> dropped_row_events_{0};
+
+  // Mixing-thread state for the xmp frame being copied into blocks; guarded by
+  // mix_mutex_ and reset on every module switch.
+  ModuleSwitch pending_switch_;
+  int64_t clock_base_ms_ = 0;
+  const uint8_t* frame_pcm_ = nullptr;
+  size_t frame_bytes_ = 0;
+  size_t frame_offset_ = 0;
+  MixBlockTag frame_position_;
+  bool frame_starts_row_ = false;
+  uint64_t mixed_frames_ = 0;
+
+  // Guards module_paths_ writes and the seek tables, which may be built off
+  // the main thread.
+  std::mutex seek_mutex_;
+  std::array<std::vector<XmSeekPoint>, 3> seek_tables_;
 };
 
 }  // namespace forward::core
@@ -3,51 +3,128 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <numeric>
 #include <sstream>
+#include <span>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "core/AllocationTracker.h"
+#include "core/AseScene.h"
+#include "core/AssetCache.h"
+#include "core/BenchReport.h"
 #include "core/Camera.h"
+#include "core/EffectKernels.h"
+#include "core/FrameArena.h"
 #include "core/GifIndexed.h"
 #include "core/Image32.h"
+#include "core/ImageView.h"
 #include "core/IndexedSurface8.h"
 #include "core/LegacyPacked10.h"
 #include "core/Mesh.h"
 #include "core/MeshLoaderIgu.h"
+#include "core/MappedFile.h"
+#include "core/ProcessStats.h"
+#include "core/Profiler.h"
+#include "core/Quat.h"
+#include "core/RenderPassGraph.h"
+#include "core/RenderTargetPool.h"
 #include "core/Renderer3D.h"
+#include "core/ScriptTimeline.h"
 #include "core/Surface32.h"
+#include "core/TaskGraph.h"
+#include "core/TextScan.h"
 #include "core/Vec3.h"
+#include "core/WavWriter.h"
 #include "core/XmPlayer.h"
 
+#ifndef FORWARD_BENCH_BUILD
+#define FORWARD_BENCH_BUILD 0
+#endif
+
 namespace {
 
+using forward::core::AllocationCounters;
+using forward::core::AllocationSite;
+using forward::core::ArenaAllocator;
+using forward::core::ArenaVector;
+using forward::core::AseSceneData;
+using forward::core::BenchResult;
 using forward::core::Camera;
+using forward::core::ComputeVertexNormals;
+using forward::core::FrameArena;
+using forward::core::FrameTimeHistogram;
 using forward::core::IndexedImage8;
 using forward::core::IndexedSurface8;
 using forward::core::Image32;
+using forward::core::ImageView;
+using forward::core::InterpolateClockMs;
 using forward::core::Mesh;
+using forward::core::ParseAseScene;
+using forward::core::ProcessAllocations;
+using forward::core::ProfileEvent;
+using forward::core::Profiler;
+using forward::core::Quat;
+using forward::core::QuatConjugate;
+using forward::core::QuatFromAxisAngle;
+using forward::core::QuatMul;
+using forward::core::QuatNormalize;
 using forward::core::RenderInstance;
+using forward::core::RenderPassGraph;
+using forward::core::RenderStats;
+using forward::core::RenderTargetPool;
 using forward::core::Renderer3D;
+using forward::core::ResidentSetBytes;
+using forward::core::ScriptCursor;
+using forward::core::ScriptEvent;
+using forward::core::SetAllocationSiteCapture;
 using forward::core::Surface32;
+using forward::core::TakeAllocationSites;
+using forward::core::ThreadAllocations;
 using forward::core::Vec3;
+using forward::core::WatercubeWaveStep;
+using forward::core::WavWriter;
 using forward::core::XmPlayer;
+using forward::core::XmRowEvent;
+using forward::core::XmSeekPoint;
 using forward::core::XmTiming;
 namespace legacy10 = forward::core::legacy10;
 
 constexpr int kLogicalWidth = 512;
 constexpr int kLogicalHeight = 256;
 constexpr int kWindowScale = 1;  // 1x1 mode only
+constexpr int kDefaultPrefetchRows = 32;
+constexpr int kOfflineAudioRate = 44100;
+constexpr int kDefaultHeadlessFps = 60;
+constexpr int64_t kDefaultHeadlessFrames = 600;
+constexpr int kDefaultBenchFrames = 240;
+constexpr int kDefaultBenchWarmupFrames = 30;
+constexpr double kDefaultBenchThresholdPercent = 5.0;
+constexpr size_t kMaxTraceEvents = 8'000'000;
+constexpr double kDefaultMetricsPeriodSeconds = 1.0;
+constexpr double kDefaultStallWindowSeconds = 3.0;
+constexpr size_t kMaxStallEvents = 1'000'000;
+constexpr int kMaxStallDumps = 64;
+constexpr const char* kDefaultStallDir = "stalls";
+constexpr size_t kReportedAllocationSites = 8;
+constexpr const char* kDefaultAssetCacheDir = "forward-cache";
 constexpr double kTickHz = 50.0;
 constexpr double kTickDtSeconds = 1.0 / kTickHz;
 constexpr float kPi = 3.14159265358979323846f;
@@ -58,6 +135,11 @@ constexpr int kMod2ToMakuRow = 0x0D00;
 constexpr int kMod2ToWatercubeRow = 0x1000;
 constexpr int kMod2ToFetaRow = 0x1300;
 constexpr int kMod2ToUppolRow = 0x1600;
+constexpr double kScriptFallbackToDominaSeconds = 13.0;
+constexpr double kScriptFallbackToSaariSeconds = 29.0;
+constexpr double kScriptFallbackToKukotSeconds = 36.0;
+constexpr double kScriptFallbackToMakuSeconds = 46.0;
+constexpr double kScriptFallbackToWatercubeSeconds = 58.0;
 constexpr double kScriptFallbackToFetaSeconds = 66.0;
 constexpr double kScriptFallbackToUppolSeconds = 74.0;
 
@@ -66,6 +148,98 @@ struct RuntimeStats {
   uint64_t simulated_ticks = 0;
 };
 
+// --headless: no window or present, a fixed virtual frame step, and a point
+// at which the run stops.
+struct HeadlessRun {
+  bool enabled = false;
+  int fps = kDefaultHeadlessFps;
+  int64_t max_frames = -1;
+  double end_seconds = -1.0;
+  int end_module_slot = 2;
+  int end_order_row = -1;
+  int64_t frames = 0;
+};
+
+// --trace: zones drained from every thread's ring once per frame, written as
+// Chrome trace JSON on exit. Recording stops at `max_events`.
+struct TraceCapture {
+  std::string path;
+  std::vector<ProfileEvent> events;
+  size_t max_events = kMaxTraceEvents;
+  size_t dropped = 0;
+};
+
+struct SceneFrameTimes {
+  size_t frames = 0;
+  double total_ms = 0.0;
+  double max_ms = 0.0;
+  RenderStats render;
+  AllocationCounters allocations;
+};
+
+// --metrics: one JSON object per line every `period_seconds` of wall time, to
+// a file or to stdout for "-". Frame times and per-scene totals cover only the
+// period since the previous line.
+struct MetricsStream {
+  std::string path;
+  std::ofstream file;
+  std::ostream* out = nullptr;
+  double period_seconds = kDefaultMetricsPeriodSeconds;
+  double elapsed_seconds = 0.0;
+  std::vector<double> frame_ms;
+  FrameTimeHistogram histogram;
+  RenderStats render;
+  // Main thread, and every thread since ProcessAllocations() was `process_mark`.
+  AllocationCounters allocations;
+  AllocationCounters process_mark;
+  // Keyed by SceneModeName()/SequenceStageName() literals.
+  std::map<std::string_view, SceneFrameTimes> scenes;
+};
+
+// --stall-ms: zones of the last `window_seconds` are kept in memory, and a
+// frame slower than the budget writes them out as a Chrome trace. Dumps do
+// not overlap; a stall inside the window of the previous dump is only counted.
+struct StallRecorder {
+  double budget_ms = -1.0;
+  double window_seconds = kDefaultStallWindowSeconds;
+  std::filesystem::path directory = kDefaultStallDir;
+  std::deque<ProfileEvent> events;
+  uint64_t stalls = 0;
+  int dumps = 0;
+  uint64_t next_dump_ns = 0;
+};
+
+// Where a scene of the scripted sequence starts: a module row when music
+// drives the sequence, a script time when it does not.
+struct BenchScene {
+  std::string name;
+  int module_slot = 0;
+  int order_row = 0;
+  double fallback_seconds = 0.0;
+};
+
+// --bench (the default of forward_bench): a headless run that enters each
+// scene at its start, renders `warmup_frames`, then times `frames` more.
+struct BenchRun {
+  bool enabled = false;
+  int frames = kDefaultBenchFrames;
+  int warmup_frames = kDefaultBenchWarmupFrames;
+  std::string scene_filter;
+  std::string json_path;
+  std::string baseline_path;
+  double threshold_percent = kDefaultBenchThresholdPercent;
+  std::vector<BenchScene> scenes;
+  size_t scene_index = 0;
+  // -1 until the current scene has been entered.
+  int scene_frame = -1;
+  std::vector<double> frame_ms;
+  std::vector<BenchResult> results;
+  // Heap allocations of the main thread allowed over a scene's timed frames.
+  uint64_t max_allocations = 0;
+  AllocationCounters allocations;
+  size_t allocation_failures = 0;
+};
+
 enum class SceneMode {
   kMute95,
   kDomina,
@@ -102,8 +276,18 @@ struct DemoState {
   std::string mesh_label;
   std::string post_label;
   bool debug_maku_no_fog = false;
+  bool debug_overdraw = false;
+  // Saari's reflection and Feta's halos render at 1/N of the logical size when
+  // --layer-downscale asks for it. Watercube's layer is added at full intensity,
+  // so it always stays full size.
+  int layer_downscale = 1;
 };
 
+// The overdraw view keeps layers full size so its counts stay per screen pixel.
+int LayerDownscale(const DemoState& state) {
+  return state.debug_overdraw ? 1 : state.layer_downscale;
+}
+
 struct WatercubeValidationHarness {
   bool enabled = false;
   bool has_reference_dir = false;
@@ -111,7 +295,6 @@ struct WatercubeValidationHarness {
   std::filesystem::path reference_dir;
   std::vector<int> checkpoints = {0x1004, 0x1100, 0x1200, 0x1210, 0x1220, 0x1230};
   std::unordered_set<int> captured_rows;
-  int last_order_row = -1;
 };
 
 struct FetaValidationHarness {
@@ -121,7 +304,6 @@ struct FetaValidationHarness {
   std::filesystem::path reference_dir;
   std::vector<int> checkpoints = {0x1300, 0x1520, 0x1530, 0x1600};
   std::unordered_set<int> captured_rows;
-  int last_order_row = -1;
 };
 
 struct MakuValidationHarness {
@@ -131,7 +313,6 @@ struct MakuValidationHarness {
   std::filesystem::path reference_dir;
   std::vector<int> checkpoints = {0x0D00, 0x0E00, 0x0E20, 0x0F00, 0x0F20, 0x0F28, 0x0F30, 0x0F3C};
   std::unordered_set<int> captured_rows;
-  int last_order_row = -1;
   int direct_row_hint = kMod2ToMakuRow;
 };
 
@@ -178,7 +359,7 @@ struct Particle {
 };
 
 struct MmaamkaParticlePass {
-  Image32 flare;
+  ImageView flare;
   std::vector<Particle> particles;
   double last_timeline_seconds = 0.0;
   uint32_t rng_state = 0x1998u;
@@ -197,8 +378,7 @@ struct FetaRuntime {
   std::vector<uint32_t> packed_frame;
   double blackfeta_start_seconds = 0.0;
   double blackmuna_start_seconds = 0.0;
-  int last_order_row = -1;
-  int next_script_event = 0;
+  ScriptCursor script_cursor;
 };
 
 struct Mute95CreditPair {
@@ -209,6 +389,7 @@ struct Mute95CreditPair {
 struct Mute95SceneAssets {
   std::array<Mute95CreditPair, 5> credits;
   std::array<uint32_t, 256> palette{};
+  bool has_palette = false;
   bool enabled = false;
 };
 
@@ -245,37 +426,22 @@ struct DominaRuntime {
   bool initialized = false;
 };
 
-struct Quat {
-  float x = 0.0f;
-  float y = 0.0f;
-  float z = 0.0f;
-  float w = 1.0f;
-};
-
 struct SaariSceneAssets {
-  struct TrackKey {
-    double time_ms = 0.0;
-    Vec3 value;
-  };
-  struct RotTrackKey {
-    double time_ms = 0.0;
-    Quat value;
-  };
-  struct AnimatedObject {
-    std::string name;
-    Mesh mesh;
-    Vec3 base_position;
-    Quat base_rotation;
-    std::vector<TrackKey> position_track;
-    std::vector<RotTrackKey> rotation_track;
-  };
+  using TrackKey = forward::core::AseTrackKey;
+  using RotTrackKey = forward::core::AseRotTrackKey;
+  using AnimatedObject = forward::core::AseAnimatedObject;
 
   Mesh terrain;
   Mesh sea;
-  Image32 terrain_texture;
-  Image32 water_texture;
+  // saari.gif holds the terrain texture in its top half and the water in its
+  // bottom half; the backdrop is the top-left 256x256 of tai1sp.jpg. The views
+  // point into these images, which survive moves of the assets but not copies.
+  Image32 scape_image;
+  Image32 backdrop_image;
+  ImageView terrain_texture;
+  ImageView water_texture;
   Mesh backdrop_mesh;
-  Image32 backdrop_texture;
+  ImageView backdrop_texture;
   float backdrop_scale = 1.0f;
   float camera_fov_degrees = 80.0f;
   std::vector<TrackKey> camera_track;
@@ -344,8 +510,7 @@ struct MakuRuntime {
   bool ksor_enabled = false;
   float flash_intensity = 0.0f;
   float flash_decay = 0.0f;
-  int next_script_event = 0;
-  int last_order_row = -1;
+  ScriptCursor script_cursor;
   Vec3 last_camera_position;
   Vec3 last_camera_target;
   double last_eval_seconds = 0.0;
@@ -393,8 +558,7 @@ struct WatercubeRuntime {
   float shock_decay = 0.0f;
   int tex_strip_offset = 0;
 
-  int next_script_event = 0;
-  int last_order_row = -1;
+  ScriptCursor script_cursor;
   bool initialized = false;
 };
 
@@ -403,33 +567,54 @@ struct KukotRuntime {
   std::vector<uint32_t> flash_lut_10;
   std::vector<int> flash_scanline_order;
   std::vector<Particle> particles;
-  std::vector<Mesh> deformed_meshes;
   std::vector<uint32_t> frame_packed10;
   std::vector<uint32_t> prev_frame_packed10;
   float flash_intensity = 0.0f;
   float flash_decay = 0.0f;
-  int next_script_event = 0;
-  int last_order_row = -1;
+  ScriptCursor script_cursor;
   double prev_scene_seconds = 0.0;
   bool initialized = false;
 };
 
-struct ScriptMessageEvent {
-  int order_row = -1;
-  std::string message;
+// Script words the scenes react to. The compiled timeline interns them first,
+// in this order, so a message ID casts straight to this enum.
+enum class ScriptSymbol : uint16_t {
+  kKukot,
+  kMaku,
+  kWatercube,
+  kFeta,
+  kSuh,
+  kSuh0,
+  kSuh1,
+  kSuh2,
+  kKsor,
+  kRoll,
+  kGo,
+  kSpeed,
+  kRok,
+  kPum,
+  kTex0,
+  kTex1,
+  kTex2,
+  kTex3,
+  kPalette1,
+  kPalette2,
+  kBlackfeta,
+  kBlackmuna,
+  kCount,
 };
 
-struct KukotScriptData {
-  std::vector<ScriptMessageEvent> events;
-  int show_row = kMod2ToKukotRow;
-  int handoff_row = kMod2ToMakuRow;
-  bool loaded_from_forward_java = false;
+constexpr std::array<std::string_view, static_cast<size_t>(ScriptSymbol::kCount)>
+    kScriptVocabulary = {
+        "kukot", "maku", "watercube", "feta", "suh",  "suh0", "suh1", "suh2",
+        "ksor",  "roll", "go",        "speed", "rok", "pum",  "tex0", "tex1",
+        "tex2",  "tex3", "1",         "2",    "blackfeta", "blackmuna",
 };
 
-struct MakuScriptData {
-  std::vector<ScriptMessageEvent> events;
-  int show_row = kMod2ToMakuRow;
-  int handoff_row = kMod2ToWatercubeRow;
+struct ForwardScript {
+  forward::core::ScriptTimeline timeline{kScriptVocabulary};
+  int kukot_show_row = kMod2ToKukotRow;
+  int kukot_handoff_row = kMod2ToMakuRow;
   bool loaded_from_forward_java = false;
 };
 
@@ -440,9 +625,9 @@ bool ProjectPointToScreen(const Camera& camera,
                           int* out_x,
                           int* out_y,
                           float* out_depth);
-const KukotScriptData& GetKukotScriptData();
-const MakuScriptData& GetMakuScriptData();
+const ForwardScript& GetForwardScript();
 const char* SceneModeName(SceneMode mode);
+const char* SequenceStageName(SequenceStage stage);
 
 uint32_t PackArgb(uint8_t r, uint8_t g, uint8_t b) {
   return (0xFFu << 24u) | (static_cast<uint32_t>(r) << 16u) |
@@ -506,9 +691,9 @@ SequenceStage DetermineSequenceStage(const XmTiming& timing,
                                      bool maku_enabled,
                                      bool watercube_enabled,
                                      double fallback_script_seconds) {
-  const KukotScriptData& kukot_script = GetKukotScriptData();
-  const int kukot_show_row = kukot_script.show_row;
-  const int kukot_handoff_row = kukot_script.handoff_row;
+  const ForwardScript& script = GetForwardScript();
+  const int kukot_show_row = script.kukot_show_row;
+  const int kukot_handoff_row = script.kukot_handoff_row;
 
   if (timing.valid) {
     const int order_row = PackOrderRow(timing.order, timing.row);
@@ -536,27 +721,80 @@ SequenceStage DetermineSequenceStage(const XmTiming& timing,
     return SequenceStage::kWatercube;
   }
 
-  if (fallback_script_seconds < 13.0) {
+  if (fallback_script_seconds < kScriptFallbackToDominaSeconds) {
     return SequenceStage::kMute95;
   }
-  if (fallback_script_seconds < 29.0 || !saari_enabled) {
+  if (fallback_script_seconds < kScriptFallbackToSaariSeconds || !saari_enabled) {
     return SequenceStage::kDomina;
   }
-  if (fallback_script_seconds < 36.0) {
+  if (fallback_script_seconds < kScriptFallbackToKukotSeconds) {
     return SequenceStage::kSaari;
   }
-  if (fallback_script_seconds < 46.0 || !maku_enabled) {
+  if (fallback_script_seconds < kScriptFallbackToMakuSeconds || !maku_enabled) {
     if (!kukot_enabled) {
       return SequenceStage::kSaari;
     }
     return SequenceStage::kKukot;
   }
-  if (fallback_script_seconds < 58.0 || !watercube_enabled) {
+  if (fallback_script_seconds < kScriptFallbackToWatercubeSeconds || !watercube_enabled) {
     return SequenceStage::kMaku;
   }
   return SequenceStage::kWatercube;
 }
 
+// Module slot and packed order-row where the scripted sequence enters the
+// scene it shows in (`mode`, `stage`).
+std::pair<int, int> SequenceSceneStartRow(SceneMode mode, SequenceStage stage) {
+  if (mode == SceneMode::kUppol) {
+    return {2, kMod2ToUppolRow};
+  }
+  if (mode == SceneMode::kFeta) {
+    return {2, kMod2ToFetaRow};
+  }
+  const ForwardScript& script = GetForwardScript();
+  switch (stage) {
+    case SequenceStage::kMute95:
+      return {1, 0};
+    case SequenceStage::kDomina:
+      return {1, kMute95ToDominaRow};
+    case SequenceStage::kSaari:
+      return {2, 0};
+    case SequenceStage::kKukot:
+      return {2, script.kukot_show_row};
+    case SequenceStage::kMaku:
+      return {2, script.kukot_handoff_row};
+    case SequenceStage::kWatercube:
+      return {2, kMod2ToWatercubeRow};
+  }
+  return {1, 0};
+}
+
+// Every scene of the sequence in playback order, or those named in the
+// comma-separated `filter`.
+std::vector<BenchScene> BuildBenchScenes(const std::string& filter) {
+  const ForwardScript& script = GetForwardScript();
+  const std::vector<BenchScene> all = {
+      {"mute95", 1, 0, 0.0},
+      {"domina", 1, kMute95ToDominaRow, kScriptFallbackToDominaSeconds},
+      {"saari", 2, 0, kScriptFallbackToSaariSeconds},
+      {"kukot", 2, script.kukot_show_row, kScriptFallbackToKukotSeconds},
+      {"maku", 2, script.kukot_handoff_row, kScriptFallbackToMakuSeconds},
+      {"watercube", 2, kMod2ToWatercubeRow, kScriptFallbackToWatercubeSeconds},
+      {"feta", 2, kMod2ToFetaRow, kScriptFallbackToFetaSeconds},
+      {"uppol", 2, kMod2ToUppolRow, kScriptFallbackToUppolSeconds},
+  };
+  if (filter.empty()) {
+    return all;
+  }
+  std::vector<BenchScene> selected;
+  for (const BenchScene& scene : all) {
+    if (("," + filter + ",").find("," + scene.name + ",") != std::string::npos) {
+      selected.push_back(scene);
+    }
+  }
+  return selected;
+}
+
 SDL_Rect ComputePresentationRect(SDL_Renderer* renderer) {
   int output_w = 0;
   int output_h = 0;
@@ -677,83 +915,108 @@ std::string ResolveFirstExistingForwardPath(const std::array<std::string, N>& re
   return {};
 }
 
-bool LoadForwardImage(const std::string& relative_path, Image32* out_image, std::string* out_error) {
-  const std::string path = ResolveForwardAssetPath(relative_path);
-  if (path.empty()) {
-    if (out_error) {
-      *out_error = "asset not found: " + relative_path;
-    }
+forward::core::AssetCache& GetAssetCache() {
+  static forward::core::AssetCache cache;
+  return cache;
+}
+
+// Returns the cached result for `key` when an entry built from the current contents of
+// `source_path` (mixed with `salt`) exists; otherwise runs `build` and stores the result.
+// An empty source path keys the entry on `salt` alone, for procedurally generated data.
+template <typename ReadFn, typename BuildFn, typename WriteFn>
+bool LoadThroughAssetCache(const std::string& key,
+                           const std::string& source_path,
+                           uint64_t salt,
+                           ReadFn&& read,
+                           BuildFn&& build,
+                           WriteFn&& write) {
+  forward::core::AssetCache& cache = GetAssetCache();
+  uint64_t content_hash = forward::core::HashBytes(&salt, sizeof(salt));
+  const bool cacheable =
+      cache.Enabled() &&
+      (source_path.empty() || forward::core::HashFileContents(source_path, &content_hash, content_hash));
+  if (cacheable) {
+    forward::core::AssetCacheReader reader;
+    if (cache.Load(key, content_hash, &reader) && read(reader) && reader.Ok()) {
+      return true;
+    }
+  }
+  if (!build()) {
     return false;
   }
-  return forward::core::LoadImage32(path, *out_image, out_error);
-}
-
-Image32 ExtractTopHalf(const Image32& src) {
-  if (src.Empty() || src.height < 2) {
-    return {};
-  }
-  const int out_h = src.height / 2;
-  Image32 out;
-  out.width = src.width;
-  out.height = out_h;
-  out.pixels.resize(static_cast<size_t>(out.width) * static_cast<size_t>(out.height));
-  for (int y = 0; y < out_h; ++y) {
-    const size_t src_row = static_cast<size_t>(y) * static_cast<size_t>(src.width);
-    const size_t dst_row = static_cast<size_t>(y) * static_cast<size_t>(out.width);
-    for (int x = 0; x < out.width; ++x) {
-      out.pixels[dst_row + static_cast<size_t>(x)] = src.pixels[src_row + static_cast<size_t>(x)];
+  if (cacheable) {
+    forward::core::AssetCacheWriter writer;
+    write(writer);
+    std::string cache_error;
+    if (!cache.Store(key, content_hash, writer, &cache_error)) {
+      std::cerr << "asset cache: " + cache_error + "\n";
     }
   }
-  return out;
+  return true;
 }
 
-Image32 ExtractBottomHalf(const Image32& src) {
-  if (src.Empty() || src.height < 2) {
-    return {};
-  }
-  const int half_h = src.height / 2;
-  const int start_y = src.height - half_h;
-  Image32 out;
-  out.width = src.width;
-  out.height = half_h;
-  out.pixels.resize(static_cast<size_t>(out.width) * static_cast<size_t>(out.height));
-  for (int y = 0; y < half_h; ++y) {
-    const size_t src_row = static_cast<size_t>(start_y + y) * static_cast<size_t>(src.width);
-    const size_t dst_row = static_cast<size_t>(y) * static_cast<size_t>(out.width);
-    for (int x = 0; x < out.width; ++x) {
-      out.pixels[dst_row + static_cast<size_t>(x)] = src.pixels[src_row + static_cast<size_t>(x)];
-    }
-  }
-  return out;
+// Names the source by its path under original/forward (or as given, for files
+// outside it), so same-named files in different directories get distinct keys.
+std::string AssetCacheKey(const char* kind, const std::string& path) {
+  const std::filesystem::path source = std::filesystem::path(path).lexically_normal();
+  std::filesystem::path relative;
+  bool under_root = false;
+  std::filesystem::path previous;
+  for (const std::filesystem::path& part : source) {
+    if (under_root) {
+      relative /= part;
+    } else if (part == "forward" && previous == "original") {
+      under_root = true;
+    }
+    previous = part;
+  }
+  if (!under_root) {
+    relative = source.relative_path();
+  }
+  return std::string(kind) + "-" + relative.generic_string();
+}
+
+bool LoadImage32Cached(const std::string& path, Image32& out_image, std::string* out_error) {
+  return LoadThroughAssetCache(
+      AssetCacheKey("image", path),
+      path,
+      0,
+      [&](forward::core::AssetCacheReader& reader) { return reader.ReadImage(&out_image); },
+      [&] { return forward::core::LoadImage32(path, out_image, out_error); },
+      [&](forward::core::AssetCacheWriter& writer) { writer.WriteImage(out_image); });
+}
+
+bool LoadIguMeshCached(const std::string& path, Mesh& out_mesh, std::string* out_error) {
+  return LoadThroughAssetCache(
+      AssetCacheKey("igu", path),
+      path,
+      0,
+      [&](forward::core::AssetCacheReader& reader) { return reader.ReadMesh(&out_mesh); },
+      [&] {
+        forward::core::IguLoadStats stats;
+        if (!forward::core::LoadIguMesh(path, out_mesh, out_error, &stats)) {
+          return false;
+        }
+        std::ostringstream line;
+        line << "igu parsed: " << std::filesystem::path(path).filename().string() << " "
+             << stats.bytes / 1024 << " KB in " << std::fixed << std::setprecision(2)
+             << stats.seconds * 1000.0 << " ms (" << std::setprecision(1)
+             << stats.MegabytesPerSecond() << " MB/s)\n";
+        std::cerr << line.str();
+        return true;
+      },
+      [&](forward::core::AssetCacheWriter& writer) { writer.WriteMesh(out_mesh); });
 }
 
-Image32 ExtractRect(const Image32& src, int x, int y, int w, int h) {
-  if (src.Empty() || w <= 0 || h <= 0) {
-    return {};
-  }
-  const int sx = std::clamp(x, 0, src.width - 1);
-  const int sy = std::clamp(y, 0, src.height - 1);
-  const int ex = std::clamp(x + w, 0, src.width);
-  const int ey = std::clamp(y + h, 0, src.height);
-  const int out_w = std::max(0, ex - sx);
-  const int out_h = std::max(0, ey - sy);
-  if (out_w <= 0 || out_h <= 0) {
-    return {};
-  }
-
-  Image32 out;
-  out.width = out_w;
-  out.height = out_h;
-  out.pixels.resize(static_cast<size_t>(out_w) * static_cast<size_t>(out_h));
-  for (int row = 0; row < out_h; ++row) {
-    const size_t src_row = static_cast<size_t>(sy + row) * static_cast<size_t>(src.width);
-    const size_t dst_row = static_cast<size_t>(row) * static_cast<size_t>(out_w);
-    for (int col = 0; col < out_w; ++col) {
-      out.pixels[dst_row + static_cast<size_t>(col)] =
-          src.pixels[src_row + static_cast<size_t>(sx + col)];
+bool LoadForwardImage(const std::string& relative_path, Image32* out_image, std::string* out_error) {
+  const std::string path = ResolveForwardAssetPath(relative_path);
+  if (path.empty()) {
+    if (out_error) {
+      *out_error = "asset not found: " + relative_path;
     }
+    return false;
   }
-  return out;
+  return LoadImage32Cached(path, *out_image, out_error);
 }
 
 Image32 BuildKukotEnvTextureFromPalette(const std::array<uint32_t, 256>& palette,
@@ -978,74 +1241,6 @@ void FlipMeshUvU(Mesh* mesh) {
   }
 }
 
-std::vector<std::string> SplitWhitespace(std::string line) {
-  for (char& c : line) {
-    if (c == '\t') {
-      c = ' ';
-    }
-  }
-  std::istringstream iss(line);
-  std::vector<std::string> out;
-  std::string token;
-  while (iss >> token) {
-    out.push_back(token);
-  }
-  return out;
-}
-
-std::string TrimAscii(const std::string& s) {
-  const size_t begin = s.find_first_not_of(" \t\r\n");
-  if (begin == std::string::npos) {
-    return {};
-  }
-  const size_t end = s.find_last_not_of(" \t\r\n");
-  return s.substr(begin, end - begin + 1);
-}
-
-int CountChar(const std::string& s, char ch) {
-  return static_cast<int>(std::count(s.begin(), s.end(), ch));
-}
-
-std::string ExtractQuoted(const std::string& line) {
-  const size_t first_quote = line.find('"');
-  const size_t last_quote = line.rfind('"');
-  if (first_quote == std::string::npos || last_quote == std::string::npos ||
-      last_quote <= first_quote) {
-    return {};
-  }
-  return line.substr(first_quote + 1, last_quote - first_quote - 1);
-}
-
-Quat QuatNormalize(const Quat& q) {
-  const float len_sq = q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
-  if (len_sq <= 1e-12f) {
-    return {};
-  }
-  const float inv_len = 1.0f / std::sqrt(len_sq);
-  return Quat{q.x * inv_len, q.y * inv_len, q.z * inv_len, q.w * inv_len};
-}
-
-Quat QuatConjugate(const Quat& q) { return Quat{-q.x, -q.y, -q.z, q.w}; }
-
-Quat QuatMul(const Quat& a, const Quat& b) {
-  return Quat{
-      a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
-      a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
-      a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
-      a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
-  };
-}
-
-Quat QuatFromAxisAngle(const Vec3& axis, float angle_radians) {
-  Vec3 n = axis.Normalized();
-  if (n.LengthSq() <= 1e-12f) {
-    n = Vec3(0.0f, 0.0f, 1.0f);
-  }
-  const float half = angle_radians * 0.5f;
-  const float s = std::sin(half);
-  return QuatNormalize(Quat{n.x * s, n.y * s, n.z * s, std::cos(half)});
-}
-
 bool LoadForwardJavaScriptEntries(std::vector<std::string>* out_entries) {
   if (!out_entries) {
     return false;
@@ -1111,245 +1306,77 @@ bool LoadForwardJavaScriptEntries(std::vector<std::string>* out_entries) {
   return !out_entries->empty();
 }
 
-bool IsAsciiHexDigit(char c) {
-  return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||
-         (c >= 'A' && c <= 'F');
-}
-
-bool ExtractScriptRowPrefix(const std::string& token, int* inout_order_row) {
-  if (token.empty() || token[0] != '_' || !inout_order_row) {
-    return false;
-  }
-  size_t underscore_count = 0;
-  while (underscore_count < token.size() && token[underscore_count] == '_') {
-    ++underscore_count;
-  }
-  if (underscore_count == 0 || underscore_count == token.size()) {
-    return false;
-  }
-  size_t end = underscore_count;
-  while (end < token.size() && IsAsciiHexDigit(token[end])) {
-    ++end;
-  }
-  if (end == underscore_count) {
-    return false;
-  }
-  int value = 0;
-  try {
-    value = std::stoi(token.substr(underscore_count, end - underscore_count), nullptr, 16);
-  } catch (...) {
-    return false;
-  }
-  if (underscore_count == 1) {
-    *inout_order_row = value;
-  } else {
-    *inout_order_row += value;
-  }
-  return true;
-}
-
-std::vector<ScriptMessageEvent> DefaultKukotScriptEvents() {
+// Module 2 part of the applet script, used when forward.java is not around.
+std::vector<std::string> BuiltinForwardScriptEntries() {
   return {
-      {0x0900, "suh"},  {0x0910, "suh"},  {0x0920, "suh"},  {0x0930, "suh"},
-      {0x0900, "suh2"}, {0x0A00, "suh1"}, {0x0B00, "suh0"}, {0x0B04, "suh"},
-      {0x0B08, "suh"},  {0x0B0C, "suh"},  {0x0B1C, "suh0"}, {0x0B2C, "suh0"},
-      {0x0B30, "suh"},  {0x0B34, "suh"},  {0x0B38, "suh"},  {0x0B48, "suh0"},
-      {0x0B4C, "suh1"}, {0x0B50, "suh1"}, {0x0B54, "suh1"}, {0x0C00, "suh0"},
-      {0x0C10, "suh0"}, {0x0C20, "suh0"}, {0x0C24, "suh"},  {0x0C28, "suh"},
-      {0x0C2C, "suh"},  {0x0C3C, "suh1"}, {0x0C40, "suh2"}, {0x0C44, "suh2"},
-      {0x0C48, "suh2"},
+      "mod 2",
+      "_000 filmbox",
+      "_000 show saari",
+      "_700 show kukot",
+      "_900 msg kukot suh",  "__10 msg kukot suh",   "__10 msg kukot suh",  "__10 msg kukot suh",
+      "_900 msg kukot suh2", "_a00 msg kukot suh1",  "_b00 msg kukot suh0", "__04 msg kukot suh",
+      "__04 msg kukot suh",  "__04 msg kukot suh",   "__10 msg kukot suh0", "__10 msg kukot suh0",
+      "__04 msg kukot suh",  "__04 msg kukot suh",   "__04 msg kukot suh",  "__10 msg kukot suh0",
+      "__04 msg kukot suh1", "__04 msg kukot suh1",  "__04 msg kukot suh1", "_c00 msg kukot suh0",
+      "__10 msg kukot suh0", "__10 msg kukot suh0",  "__04 msg kukot suh",  "__04 msg kukot suh",
+      "__04 msg kukot suh",  "__10 msg kukot suh1",  "__04 msg kukot suh2", "__04 msg kukot suh2",
+      "__04 msg kukot suh2",
+      "_d00 show maku",
+      "msg maku go 160.5",   "msg maku speed -3.0",  "_e00",                "msg maku go 25.5",
+      "msg maku speed 2",    "_e20",                 "msg maku go 0",       "msg maku speed 2.5",
+      "_f00",                "msg maku go 42.5",     "msg maku speed -2",   "_f20",
+      "msg maku ksor",       "msg maku go 55.5",     "msg maku speed 4",    "__8",
+      "msg maku ksor",       "__8",                  "msg maku ksor",       "__4",
+      "msg maku ksor",       "__4",                  "msg maku ksor",       "__4",
+      "msg maku ksor",
+      "_1000 show watercube",
+      "__04 msg watercube pum",  "__04 msg watercube rok",  "__04 msg watercube suh",
+      "_1030 msg watercube pum", "_1100 msg watercube rok", "msg watercube pum",
+      "__10 msg watercube suh0", "__18 msg watercube suh0", "__8 msg watercube suh0",
+      "_1200 msg watercube suh1", "msg watercube pum",      "msg watercube rok",
+      "__10 msg watercube suh0", "msg watercube tex0",      "__10 msg watercube suh1",
+      "msg watercube tex1",      "__10 msg watercube suh0", "msg watercube tex2",
+      "msg feta 1",
+      "_1300 show feta",
+      "_1520 msg feta blackfeta",
+      "_1530 msg feta blackmuna",
+      "_1600 show uppol",
   };
 }
 
-KukotScriptData LoadKukotScriptData() {
-  KukotScriptData out;
-  out.events = DefaultKukotScriptEvents();
-
-  std::vector<std::string> script_entries;
-  if (!LoadForwardJavaScriptEntries(&script_entries)) {
-    return out;
-  }
-
-  int module = 0;
-  int order_row = 0;
-  bool in_kukot = false;
-  std::vector<ScriptMessageEvent> parsed_events;
-  int show_row = -1;
-  int handoff_row = -1;
-
-  for (const std::string& raw_line : script_entries) {
-    std::string line = TrimAscii(raw_line);
-    if (line.empty()) {
-      continue;
-    }
-
-    std::vector<std::string> tokens = SplitWhitespace(line);
-    if (tokens.empty()) {
-      continue;
-    }
-
-    if (!tokens[0].empty() && tokens[0][0] == '_') {
-      ExtractScriptRowPrefix(tokens[0], &order_row);
-      const size_t row_token_len = tokens[0].size();
-      line = TrimAscii(line.substr(std::min(row_token_len, line.size())));
-      tokens = SplitWhitespace(line);
-      if (tokens.empty()) {
-        continue;
-      }
-    }
-
-    if (tokens[0] == "mod" && tokens.size() >= 2) {
-      try {
-        module = std::stoi(tokens[1]);
-      } catch (...) {
-      }
-      continue;
-    }
-    if (tokens[0] == "go") {
-      continue;
-    }
-
-    if (tokens[0] == "show" && tokens.size() >= 2) {
-      const std::string shown = tokens[1];
-      if (module == 2 && shown == "kukot") {
-        in_kukot = true;
-        show_row = order_row;
-      } else if (in_kukot && module == 2 && shown != "kukot") {
-        handoff_row = order_row;
-        break;
-      }
-      continue;
-    }
-
-    if (tokens[0] == "msg" && tokens.size() >= 3) {
-      if (module != 2 || !in_kukot || tokens[1] != "kukot") {
-        continue;
-      }
-      std::string message = tokens[2];
-      for (size_t i = 3; i < tokens.size(); ++i) {
-        message += " ";
-        message += tokens[i];
-      }
-      parsed_events.push_back({order_row, message});
-    }
+ForwardScript CompileForwardScript() {
+  ForwardScript out;
+  std::vector<std::string> entries;
+  out.loaded_from_forward_java = LoadForwardJavaScriptEntries(&entries);
+  if (!out.loaded_from_forward_java) {
+    entries = BuiltinForwardScriptEntries();
   }
+  out.timeline.Compile(entries);
 
-  if (!parsed_events.empty()) {
-    out.events = std::move(parsed_events);
-    out.loaded_from_forward_java = true;
-  }
+  const uint16_t kukot = static_cast<uint16_t>(ScriptSymbol::kKukot);
+  const int show_row = out.timeline.FindRow(2, forward::core::ScriptOp::kShow, kukot);
   if (show_row >= 0) {
-    out.show_row = show_row;
-  }
-  if (handoff_row >= 0) {
-    out.handoff_row = handoff_row;
+    out.kukot_show_row = show_row;
+    const int handoff_row = out.timeline.NextShowRow(2, show_row);
+    if (handoff_row >= 0) {
+      out.kukot_handoff_row = handoff_row;
+    }
   }
   return out;
 }
 
-const KukotScriptData& GetKukotScriptData() {
-  static const KukotScriptData data = LoadKukotScriptData();
-  return data;
+const ForwardScript& GetForwardScript() {
+  static const ForwardScript script = CompileForwardScript();
+  return script;
 }
 
-std::vector<ScriptMessageEvent> DefaultMakuScriptEvents() {
-  return {
-      {0x0D00, "go 160.5"}, {0x0D00, "speed -3.0"}, {0x0E00, "go 25.5"}, {0x0E00, "speed 2"},
-      {0x0E20, "go 0"},     {0x0E20, "speed 2.5"},  {0x0F00, "go 42.5"}, {0x0F00, "speed -2"},
-      {0x0F20, "ksor"},     {0x0F20, "go 55.5"},    {0x0F20, "speed 4"},  {0x0F28, "ksor"},
-      {0x0F30, "ksor"},     {0x0F34, "ksor"},       {0x0F38, "ksor"},     {0x0F3C, "ksor"},
-  };
-}
-
-MakuScriptData LoadMakuScriptData() {
-  MakuScriptData out;
-  out.events = DefaultMakuScriptEvents();
-
-  std::vector<std::string> script_entries;
-  if (!LoadForwardJavaScriptEntries(&script_entries)) {
-    return out;
-  }
-
-  int module = 0;
-  int order_row = 0;
-  bool in_maku = false;
-  std::vector<ScriptMessageEvent> parsed_events;
-  int show_row = -1;
-  int handoff_row = -1;
-
-  for (const std::string& raw_line : script_entries) {
-    std::string line = TrimAscii(raw_line);
-    if (line.empty()) {
-      continue;
-    }
-
-    std::vector<std::string> tokens = SplitWhitespace(line);
-    if (tokens.empty()) {
-      continue;
-    }
-
-    if (!tokens[0].empty() && tokens[0][0] == '_') {
-      ExtractScriptRowPrefix(tokens[0], &order_row);
-      const size_t row_token_len = tokens[0].size();
-      line = TrimAscii(line.substr(std::min(row_token_len, line.size())));
-      tokens = SplitWhitespace(line);
-      if (tokens.empty()) {
-        continue;
-      }
-    }
-
-    if (tokens[0] == "mod" && tokens.size() >= 2) {
-      try {
-        module = std::stoi(tokens[1]);
-      } catch (...) {
-      }
-      continue;
-    }
-    if (tokens[0] == "go") {
-      continue;
-    }
-
-    if (tokens[0] == "show" && tokens.size() >= 2) {
-      const std::string shown = tokens[1];
-      if (module == 2 && shown == "maku") {
-        in_maku = true;
-        show_row = order_row;
-      } else if (in_maku && module == 2 && shown != "maku") {
-        handoff_row = order_row;
-        break;
-      }
-      continue;
-    }
-
-    if (tokens[0] == "msg" && tokens.size() >= 3) {
-      if (module != 2 || !in_maku || tokens[1] != "maku") {
-        continue;
-      }
-      std::string message = tokens[2];
-      for (size_t i = 3; i < tokens.size(); ++i) {
-        message += " ";
-        message += tokens[i];
-      }
-      parsed_events.push_back({order_row, message});
-    }
-  }
-
-  if (!parsed_events.empty()) {
-    out.events = std::move(parsed_events);
-    out.loaded_from_forward_java = true;
-  }
-  if (show_row >= 0) {
-    out.show_row = show_row;
-  }
-  if (handoff_row >= 0) {
-    out.handoff_row = handoff_row;
-  }
-  return out;
+// Script cursor over the module 2 messages addressed to `scene`.
+ScriptCursor MakeSceneScriptCursor(ScriptSymbol scene, bool catch_up) {
+  return ScriptCursor(&GetForwardScript().timeline, 2, static_cast<uint16_t>(scene), catch_up);
 }
 
-const MakuScriptData& GetMakuScriptData() {
-  static const MakuScriptData data = LoadMakuScriptData();
-  return data;
+ScriptSymbol MessageSymbol(const ScriptEvent& event) {
+  return static_cast<ScriptSymbol>(event.message);
 }
 
 Quat BuildSaariKlunssiScriptedRotation(float t_seconds) {
@@ -1360,12 +1387,6 @@ Quat BuildSaariKlunssiScriptedRotation(float t_seconds) {
   return QuatNormalize(QuatMul(qz, QuatMul(qy, qx)));
 }
 
-Vec3 RotateByQuat(const Vec3& v, const Quat& q) {
-  const Quat p{v.x, v.y, v.z, 0.0f};
-  const Quat out = QuatMul(QuatMul(q, p), QuatConjugate(q));
-  return Vec3(out.x, out.y, out.z);
-}
-
 Quat QuatSlerp(const Quat& a_in, const Quat& b_in, float t) {
   Quat a = QuatNormalize(a_in);
   Quat b = QuatNormalize(b_in);
@@ -1459,517 +1480,68 @@ Quat SampleSaariRotationTrackAtMs(const std::vector<SaariSceneAssets::RotTrackKe
   return QuatSlerp(a.value, b.value, std::clamp(f, 0.0f, 1.0f));
 }
 
-bool ParseSaariAseCameraTracks(const std::string& path,
-                               std::vector<SaariSceneAssets::TrackKey>* out_camera,
-                               std::vector<SaariSceneAssets::TrackKey>* out_target,
-                               float* out_fov_degrees) {
-  if (!out_camera || !out_target) {
-    return false;
-  }
-  std::ifstream input(path);
-  if (!input.is_open()) {
-    return false;
-  }
-
-  out_camera->clear();
-  out_target->clear();
-  bool in_tm_animation = false;
-  int tm_depth = 0;
-  std::string active_node;
-  std::string line;
-
-  while (std::getline(input, line)) {
-    const std::vector<std::string> tokens = SplitWhitespace(line);
-    if (tokens.empty()) {
-      if (in_tm_animation) {
-        tm_depth += CountChar(line, '{');
-        tm_depth -= CountChar(line, '}');
-        if (tm_depth <= 0) {
-          in_tm_animation = false;
-          active_node.clear();
+// Parsed ASE scenes are cached keyed on the file contents and the requested object names.
+bool LoadAseSceneCached(const std::string& path,
+                        const std::vector<std::string>* object_names,
+                        AseSceneData* out_scene) {
+  uint64_t salt = object_names ? forward::core::kAssetHashSeed : 0;
+  if (object_names) {
+    for (const std::string& name : *object_names) {
+      salt = forward::core::HashString(name + '\n', salt);
+    }
+  }
+  return LoadThroughAssetCache(
+      AssetCacheKey("ase", path),
+      path,
+      salt,
+      [&](forward::core::AssetCacheReader& reader) {
+        uint8_t has_fov = 0;
+        uint64_t count = 0;
+        if (!reader.Read(&has_fov) || !reader.Read(&out_scene->camera_fov_degrees) ||
+            !reader.ReadVector(&out_scene->camera_track) ||
+            !reader.ReadVector(&out_scene->target_track) || !reader.Read(&count) ||
+            count > reader.Remaining()) {
+          return false;
         }
-      }
-      continue;
-    }
-
-    if (tokens[0] == "*CAMERA_FOV" && tokens.size() >= 2 && out_fov_degrees) {
-      const float fov_rad = std::stof(tokens[1]);
-      *out_fov_degrees = fov_rad * (180.0f / kPi);
-    }
-
-    if (tokens[0] == "*TM_ANIMATION") {
-      in_tm_animation = true;
-      tm_depth = 0;
-      active_node.clear();
-    }
-
-    if (in_tm_animation && tokens[0] == "*NODE_NAME") {
-      const size_t first_quote = line.find('"');
-      const size_t last_quote = line.rfind('"');
-      if (first_quote != std::string::npos && last_quote != std::string::npos &&
-          last_quote > first_quote) {
-        active_node = line.substr(first_quote + 1, last_quote - first_quote - 1);
-      }
-    }
-
-    if (in_tm_animation && tokens[0] == "*CONTROL_POS_SAMPLE" && tokens.size() >= 5) {
-      const double time_ms = std::stod(tokens[1]);
-      const float x = std::stof(tokens[2]);
-      const float y = std::stof(tokens[3]);
-      const float z = std::stof(tokens[4]);
-      if (active_node == "Camera01") {
-        out_camera->push_back({time_ms, Vec3(x, y, z)});
-      } else if (active_node == "Camera01.Target" || active_node == "Camera01.target") {
-        out_target->push_back({time_ms, Vec3(x, y, z)});
-      }
-    }
-
-    if (in_tm_animation) {
-      tm_depth += CountChar(line, '{');
-      tm_depth -= CountChar(line, '}');
-      if (tm_depth <= 0) {
-        in_tm_animation = false;
-        active_node.clear();
-      }
-    }
-  }
-
-  return !out_camera->empty() && !out_target->empty();
+        out_scene->has_camera_fov = has_fov != 0;
+        out_scene->animated_objects.assign(static_cast<size_t>(count), {});
+        for (SaariSceneAssets::AnimatedObject& object : out_scene->animated_objects) {
+          if (!reader.ReadString(&object.name) || !reader.ReadMesh(&object.mesh) ||
+              !reader.Read(&object.base_position) || !reader.Read(&object.base_rotation) ||
+              !reader.ReadVector(&object.position_track) ||
+              !reader.ReadVector(&object.rotation_track)) {
+            return false;
+          }
+        }
+        return true;
+      },
+      [&] { return ParseAseScene(path, object_names, out_scene); },
+      [&](forward::core::AssetCacheWriter& writer) {
+        writer.Write<uint8_t>(out_scene->has_camera_fov ? 1 : 0);
+        writer.Write(out_scene->camera_fov_degrees);
+        writer.WriteVector(out_scene->camera_track);
+        writer.WriteVector(out_scene->target_track);
+        writer.Write<uint64_t>(out_scene->animated_objects.size());
+        for (const SaariSceneAssets::AnimatedObject& object : out_scene->animated_objects) {
+          writer.WriteString(object.name);
+          writer.WriteMesh(object.mesh);
+          writer.Write(object.base_position);
+          writer.Write(object.base_rotation);
+          writer.WriteVector(object.position_track);
+          writer.WriteVector(object.rotation_track);
+        }
+      });
 }
 
-bool ParseAseAnimatedObjects(const std::string& path,
-                             const std::vector<std::string>& allowed_names,
-                             std::vector<SaariSceneAssets::AnimatedObject>* out_objects) {
-  if (!out_objects) {
-    return false;
+Vec3 SampleSaariTrackAtMs(const std::vector<SaariSceneAssets::TrackKey>& track, double t_ms) {
+  if (track.empty()) {
+    return Vec3();
   }
-  std::ifstream input(path);
-  if (!input.is_open()) {
-    return false;
-  }
-
-  struct Face {
-    int a = 0;
-    int b = 0;
-    int c = 0;
-  };
-  struct TVert {
-    float u = 0.0f;
-    float v = 0.0f;
-  };
-  struct TFace {
-    int a = 0;
-    int b = 0;
-    int c = 0;
-  };
-  struct RotDeltaKey {
-    double time_ms = 0.0;
-    Vec3 axis;
-    float angle = 0.0f;
-  };
-  struct RawObject {
-    std::string name;
-    Vec3 tm_pos;
-    Vec3 tm_rot_axis{0.0f, 0.0f, 1.0f};
-    float tm_rot_angle = 0.0f;
-    std::vector<Vec3> vertices_world;
-    std::vector<Face> faces;
-    std::vector<TVert> texverts;
-    std::vector<TFace> tfaces;
-    std::vector<SaariSceneAssets::TrackKey> pos_track;
-    std::vector<RotDeltaKey> rot_track_delta;
-  };
-
-  auto ensure_vec3_size = [](std::vector<Vec3>* v, int idx) {
-    if (idx < 0 || !v) {
-      return;
-    }
-    const size_t need = static_cast<size_t>(idx + 1);
-    if (v->size() < need) {
-      v->resize(need);
-    }
-  };
-  auto ensure_face_size = [](std::vector<Face>* v, int idx) {
-    if (idx < 0 || !v) {
-      return;
-    }
-    const size_t need = static_cast<size_t>(idx + 1);
-    if (v->size() < need) {
-      v->resize(need);
-    }
-  };
-  auto ensure_tvert_size = [](std::vector<TVert>* v, int idx) {
-    if (idx < 0 || !v) {
-      return;
-    }
-    const size_t need = static_cast<size_t>(idx + 1);
-    if (v->size() < need) {
-      v->resize(need);
-    }
-  };
-  auto ensure_tface_size = [](std::vector<TFace>* v, int idx) {
-    if (idx < 0 || !v) {
-      return;
-    }
-    const size_t need = static_cast<size_t>(idx + 1);
-    if (v->size() < need) {
-      v->resize(need);
-    }
-  };
-
-  std::unordered_set<std::string> allowed_name_set;
-  for (const std::string& name : allowed_names) {
-    if (!name.empty()) {
-      allowed_name_set.insert(name);
-    }
-  }
-
-  auto parse_face = [](const std::vector<std::string>& tokens, Face* out_face) -> bool {
-    if (!out_face || tokens.empty()) {
-      return false;
-    }
-    bool has_a = false;
-    bool has_b = false;
-    bool has_c = false;
-    for (size_t i = 0; i + 1 < tokens.size(); ++i) {
-      if (tokens[i] == "A") {
-        out_face->a = std::stoi(tokens[i + 1]);
-        has_a = true;
-      } else if (tokens[i] == "B") {
-        out_face->b = std::stoi(tokens[i + 1]);
-        has_b = true;
-      } else if (tokens[i] == "C") {
-        out_face->c = std::stoi(tokens[i + 1]);
-        has_c = true;
-      }
-    }
-    return has_a && has_b && has_c;
-  };
-
-  auto finalize_object = [&](RawObject&& raw) {
-    if (raw.name.empty() || raw.vertices_world.empty() || raw.faces.empty()) {
-      return;
-    }
-    if (!allowed_name_set.empty() &&
-        allowed_name_set.find(raw.name) == allowed_name_set.end()) {
-      return;
-    }
-
-    SaariSceneAssets::AnimatedObject out;
-    out.name = raw.name;
-    out.base_position = raw.tm_pos;
-    out.base_rotation = QuatFromAxisAngle(raw.tm_rot_axis, raw.tm_rot_angle);
-
-    const Quat inv_base_rot = QuatConjugate(out.base_rotation);
-
-    const bool has_tfaces = !raw.tfaces.empty() && raw.tfaces.size() == raw.faces.size();
-    const bool has_tverts = !raw.texverts.empty();
-    if (has_tfaces && has_tverts) {
-      std::unordered_map<uint64_t, int> remap;
-      out.mesh.positions.reserve(raw.faces.size() * 3u);
-      out.mesh.texcoords.reserve(raw.faces.size() * 3u);
-      out.mesh.triangles.reserve(raw.faces.size());
-      for (size_t fi = 0; fi < raw.faces.size(); ++fi) {
-        const Face& f = raw.faces[fi];
-        const TFace& tf = raw.tfaces[fi];
-        const int vi[3] = {f.a, f.b, f.c};
-        const int ti[3] = {tf.a, tf.b, tf.c};
-        int tri_idx[3] = {-1, -1, -1};
-        for (int corner = 0; corner < 3; ++corner) {
-          const int v_idx = vi[corner];
-          const int t_idx = ti[corner];
-          if (v_idx < 0 || t_idx < 0 ||
-              v_idx >= static_cast<int>(raw.vertices_world.size()) ||
-              t_idx >= static_cast<int>(raw.texverts.size())) {
-            continue;
-          }
-          const uint64_t key =
-              (static_cast<uint64_t>(static_cast<uint32_t>(v_idx)) << 32u) |
-              static_cast<uint32_t>(t_idx);
-          auto it = remap.find(key);
-          if (it == remap.end()) {
-            const Vec3 local = RotateByQuat(raw.vertices_world[static_cast<size_t>(v_idx)] - raw.tm_pos,
-                                            inv_base_rot);
-            const TVert uv = raw.texverts[static_cast<size_t>(t_idx)];
-            const int new_idx = static_cast<int>(out.mesh.positions.size());
-            out.mesh.positions.push_back(local);
-            out.mesh.texcoords.emplace_back(uv.u, 1.0f - uv.v);
-            remap.emplace(key, new_idx);
-            tri_idx[corner] = new_idx;
-          } else {
-            tri_idx[corner] = it->second;
-          }
-        }
-        if (tri_idx[0] >= 0 && tri_idx[1] >= 0 && tri_idx[2] >= 0) {
-          out.mesh.triangles.push_back({tri_idx[0], tri_idx[1], tri_idx[2]});
-        }
-      }
-    } else {
-      out.mesh.positions.reserve(raw.vertices_world.size());
-      for (const Vec3& p_world : raw.vertices_world) {
-        const Vec3 local = RotateByQuat(p_world - raw.tm_pos, inv_base_rot);
-        out.mesh.positions.push_back(local);
-      }
-      out.mesh.triangles.reserve(raw.faces.size());
-      for (const Face& f : raw.faces) {
-        if (f.a < 0 || f.b < 0 || f.c < 0) {
-          continue;
-        }
-        if (f.a >= static_cast<int>(out.mesh.positions.size()) ||
-            f.b >= static_cast<int>(out.mesh.positions.size()) ||
-            f.c >= static_cast<int>(out.mesh.positions.size())) {
-          continue;
-        }
-        out.mesh.triangles.push_back({f.a, f.b, f.c});
-      }
-    }
-
-    if (out.mesh.positions.empty() || out.mesh.triangles.empty()) {
-      return;
-    }
-    out.mesh.RebuildVertexNormals();
-    if (out.mesh.Empty()) {
-      return;
-    }
-
-    std::sort(raw.pos_track.begin(), raw.pos_track.end(), [](const auto& a, const auto& b) {
-      return a.time_ms < b.time_ms;
-    });
-    out.position_track = std::move(raw.pos_track);
-
-    std::sort(raw.rot_track_delta.begin(),
-              raw.rot_track_delta.end(),
-              [](const auto& a, const auto& b) { return a.time_ms < b.time_ms; });
-    if (!raw.rot_track_delta.empty()) {
-      Quat accum{0.0f, 0.0f, 0.0f, 1.0f};
-      out.rotation_track.reserve(raw.rot_track_delta.size());
-      for (const RotDeltaKey& key : raw.rot_track_delta) {
-        const Quat delta = QuatFromAxisAngle(key.axis, key.angle);
-        // Java path accumulates rot samples by multiplying current sample with previous absolute.
-        accum = QuatNormalize(QuatMul(delta, accum));
-        out.rotation_track.push_back({key.time_ms, accum});
-      }
-    }
-
-    out_objects->push_back(std::move(out));
-  };
-
-  out_objects->clear();
-  RawObject current;
-
-  bool in_geom = false;
-  int geom_depth = 0;
-
-  bool in_node_tm = false;
-  int node_tm_depth = 0;
-
-  bool in_mesh = false;
-  int mesh_depth = 0;
-  bool in_vertex_list = false;
-  int vertex_list_depth = 0;
-  bool in_face_list = false;
-  int face_list_depth = 0;
-  bool in_tvert_list = false;
-  int tvert_list_depth = 0;
-  bool in_tface_list = false;
-  int tface_list_depth = 0;
-
-  bool in_tm_animation = false;
-  int tm_animation_depth = 0;
-  std::string active_track_node;
-
-  std::string line;
-  while (std::getline(input, line)) {
-    const int brace_delta = CountChar(line, '{') - CountChar(line, '}');
-    const std::vector<std::string> tokens = SplitWhitespace(line);
-    std::string line_colon = line;
-    std::replace(line_colon.begin(), line_colon.end(), ':', ' ');
-    const std::vector<std::string> tokens_colon = SplitWhitespace(line_colon);
-
-    if (!in_geom) {
-      if (!tokens.empty() && tokens[0] == "*GEOMOBJECT") {
-        in_geom = true;
-        geom_depth = 0;
-        current = RawObject{};
-      }
-    }
-
-    if (in_geom) {
-      if (!tokens.empty() && tokens[0] == "*NODE_NAME" && current.name.empty() && !in_node_tm &&
-          !in_tm_animation) {
-        current.name = ExtractQuoted(line);
-      }
-
-      if (!tokens.empty() && tokens[0] == "*NODE_TM") {
-        in_node_tm = true;
-        node_tm_depth = 0;
-      }
-      if (in_node_tm && !tokens.empty()) {
-        if (tokens[0] == "*TM_POS" && tokens.size() >= 4) {
-          current.tm_pos.Set(std::stof(tokens[1]), std::stof(tokens[2]), std::stof(tokens[3]));
-        } else if (tokens[0] == "*TM_ROTAXIS" && tokens.size() >= 4) {
-          current.tm_rot_axis.Set(
-              std::stof(tokens[1]), std::stof(tokens[2]), std::stof(tokens[3]));
-        } else if (tokens[0] == "*TM_ROTANGLE" && tokens.size() >= 2) {
-          current.tm_rot_angle = std::stof(tokens[1]);
-        }
-      }
-
-      if (!tokens.empty() && tokens[0] == "*MESH") {
-        in_mesh = true;
-        mesh_depth = 0;
-      }
-      if (in_mesh) {
-        if (!tokens.empty() && tokens[0] == "*MESH_VERTEX_LIST") {
-          in_vertex_list = true;
-          vertex_list_depth = 0;
-        }
-        if (!tokens.empty() && tokens[0] == "*MESH_FACE_LIST") {
-          in_face_list = true;
-          face_list_depth = 0;
-        }
-        if (!tokens.empty() && tokens[0] == "*MESH_TVERTLIST") {
-          in_tvert_list = true;
-          tvert_list_depth = 0;
-        }
-        if (!tokens.empty() && tokens[0] == "*MESH_TFACELIST") {
-          in_tface_list = true;
-          tface_list_depth = 0;
-        }
-        if (in_vertex_list && !tokens.empty() && tokens[0] == "*MESH_VERTEX" && tokens.size() >= 5) {
-          const int idx = std::stoi(tokens[1]);
-          ensure_vec3_size(&current.vertices_world, idx);
-          current.vertices_world[static_cast<size_t>(idx)] =
-              Vec3(std::stof(tokens[2]), std::stof(tokens[3]), std::stof(tokens[4]));
-        }
-        if (in_face_list && !tokens_colon.empty() && tokens_colon[0] == "*MESH_FACE") {
-          int idx = -1;
-          if (tokens_colon.size() >= 2) {
-            idx = std::stoi(tokens_colon[1]);
-          }
-          Face face{};
-          if (idx >= 0 && parse_face(tokens_colon, &face)) {
-            ensure_face_size(&current.faces, idx);
-            current.faces[static_cast<size_t>(idx)] = face;
-          }
-        }
-        if (in_tvert_list && !tokens.empty() && tokens[0] == "*MESH_TVERT" && tokens.size() >= 4) {
-          const int idx = std::stoi(tokens[1]);
-          ensure_tvert_size(&current.texverts, idx);
-          current.texverts[static_cast<size_t>(idx)] = TVert{std::stof(tokens[2]), std::stof(tokens[3])};
-        }
-        if (in_tface_list && !tokens.empty() && tokens[0] == "*MESH_TFACE" && tokens.size() >= 5) {
-          const int idx = std::stoi(tokens[1]);
-          ensure_tface_size(&current.tfaces, idx);
-          current.tfaces[static_cast<size_t>(idx)] = TFace{
-              std::stoi(tokens[2]), std::stoi(tokens[3]), std::stoi(tokens[4])};
-        }
-      }
-
-      if (!tokens.empty() && tokens[0] == "*TM_ANIMATION") {
-        in_tm_animation = true;
-        tm_animation_depth = 0;
-        active_track_node.clear();
-      }
-      if (in_tm_animation && !tokens.empty()) {
-        if (tokens[0] == "*NODE_NAME") {
-          active_track_node = ExtractQuoted(line);
-        } else if (active_track_node == current.name && tokens[0] == "*CONTROL_POS_SAMPLE" &&
-                   tokens.size() >= 5) {
-          current.pos_track.push_back(
-              {std::stod(tokens[1]), Vec3(std::stof(tokens[2]), std::stof(tokens[3]), std::stof(tokens[4]))});
-        } else if (active_track_node == current.name && tokens[0] == "*CONTROL_ROT_SAMPLE" &&
-                   tokens.size() >= 6) {
-          current.rot_track_delta.push_back({std::stod(tokens[1]),
-                                             Vec3(std::stof(tokens[2]),
-                                                  std::stof(tokens[3]),
-                                                  std::stof(tokens[4])),
-                                             std::stof(tokens[5])});
-        }
-      }
-    }
-
-    if (in_node_tm) {
-      node_tm_depth += brace_delta;
-      if (node_tm_depth <= 0) {
-        in_node_tm = false;
-      }
-    }
-    if (in_vertex_list) {
-      vertex_list_depth += brace_delta;
-      if (vertex_list_depth <= 0) {
-        in_vertex_list = false;
-      }
-    }
-    if (in_face_list) {
-      face_list_depth += brace_delta;
-      if (face_list_depth <= 0) {
-        in_face_list = false;
-      }
-    }
-    if (in_tvert_list) {
-      tvert_list_depth += brace_delta;
-      if (tvert_list_depth <= 0) {
-        in_tvert_list = false;
-      }
-    }
-    if (in_tface_list) {
-      tface_list_depth += brace_delta;
-      if (tface_list_depth <= 0) {
-        in_tface_list = false;
-      }
-    }
-    if (in_mesh) {
-      mesh_depth += brace_delta;
-      if (mesh_depth <= 0) {
-        in_mesh = false;
-      }
-    }
-    if (in_tm_animation) {
-      tm_animation_depth += brace_delta;
-      if (tm_animation_depth <= 0) {
-        in_tm_animation = false;
-        active_track_node.clear();
-      }
-    }
-    if (in_geom) {
-      geom_depth += brace_delta;
-      if (geom_depth <= 0) {
-        in_geom = false;
-        finalize_object(std::move(current));
-      }
-    }
-  }
-
-  if (in_geom) {
-    finalize_object(std::move(current));
-  }
-  return !out_objects->empty();
-}
-
-bool ParseSaariAseObjects(const std::string& path,
-                          std::vector<SaariSceneAssets::AnimatedObject>* out_objects) {
-  static const std::vector<std::string> kSaariObjectNames = {"meditate", "klunssi"};
-  return ParseAseAnimatedObjects(path, kSaariObjectNames, out_objects);
-}
-
-bool ParseMakuAseCameraTracks(const std::string& path,
-                              std::vector<SaariSceneAssets::TrackKey>* out_camera,
-                              std::vector<SaariSceneAssets::TrackKey>* out_target,
-                              float* out_fov_degrees) {
-  // Dedicated Maku path: same source parser, isolated so scene-specific fixes don't affect Saari/Watercube.
-  return ParseSaariAseCameraTracks(path, out_camera, out_target, out_fov_degrees);
-}
-
-Vec3 SampleSaariTrackAtMs(const std::vector<SaariSceneAssets::TrackKey>& track, double t_ms) {
-  if (track.empty()) {
-    return Vec3();
-  }
-  if (t_ms <= track.front().time_ms) {
-    return track.front().value;
-  }
-  if (t_ms >= track.back().time_ms) {
-    return track.back().value;
+  if (t_ms <= track.front().time_ms) {
+    return track.front().value;
+  }
+  if (t_ms >= track.back().time_ms) {
+    return track.back().value;
   }
 
   auto it = std::upper_bound(
@@ -2314,10 +1886,236 @@ void UpdateWindowTitle(SDL_Window* window,
   if (state.debug_maku_no_fog) {
     title << " | maku-no-fog";
   }
+  if (state.debug_overdraw) {
+    title << " | overdraw";
+  }
 
   SDL_SetWindowTitle(window, title.str().c_str());
 }
 
+// Frames before the end time or row are rendered; the first one at or past it
+// is not.
+bool HeadlessRangeEnded(const HeadlessRun& run, double timeline_seconds, const XmTiming& timing) {
+  if (run.end_seconds >= 0.0 && timeline_seconds >= run.end_seconds) {
+    return true;
+  }
+  if (run.end_order_row < 0 || !timing.valid) {
+    return false;
+  }
+  return timing.module_slot > run.end_module_slot ||
+         (timing.module_slot == run.end_module_slot &&
+          PackOrderRow(timing.order, timing.row) >= run.end_order_row);
+}
+
+// Keeps zones until `max_events` are held. Returns true on the call that fills
+// the capture.
+bool CollectTrace(TraceCapture* trace, const std::vector<ProfileEvent>& events, size_t dropped) {
+  trace->dropped += dropped;
+  const size_t before = trace->events.size();
+  if (before >= trace->max_events) {
+    return false;
+  }
+  const size_t kept = std::min(events.size(), trace->max_events - before);
+  trace->events.insert(trace->events.end(), events.begin(), events.begin() + kept);
+  if (trace->events.size() < trace->max_events) {
+    return false;
+  }
+  std::cerr << "trace: " << trace->max_events << " zones recorded, recording stopped\n";
+  return true;
+}
+
+void RecordStallWindow(StallRecorder* stall, const std::vector<ProfileEvent>& events) {
+  stall->events.insert(stall->events.end(), events.begin(), events.end());
+  const uint64_t window_ns = static_cast<uint64_t>(stall->window_seconds * 1e9);
+  const uint64_t now_ns = Profiler::NowNs();
+  while (!stall->events.empty() && (stall->events.size() > kMaxStallEvents ||
+                                    stall->events.front().end_ns + window_ns < now_ns)) {
+    stall->events.pop_front();
+  }
+}
+
+// Returns the path of the trace written for this stall, or an empty path.
+std::filesystem::path DumpStallWindow(StallRecorder* stall, uint64_t frame, double frame_ms) {
+  ++stall->stalls;
+  std::cerr << "stall: frame " << frame << " took " << std::fixed << std::setprecision(2)
+            << frame_ms << " ms (budget " << stall->budget_ms << " ms)";
+  const uint64_t now_ns = Profiler::NowNs();
+  if (stall->events.empty() || stall->dumps >= kMaxStallDumps || now_ns < stall->next_dump_ns) {
+    std::cerr << "\n";
+    return {};
+  }
+  std::error_code ec;
+  std::filesystem::create_directories(stall->directory, ec);
+  std::ostringstream name;
+  name << "stall_" << std::setfill('0') << std::setw(6) << frame << ".json";
+  const std::filesystem::path path = stall->directory / name.str();
+  const std::vector<ProfileEvent> window(stall->events.begin(), stall->events.end());
+  std::string error;
+  if (!Profiler::WriteChromeTrace(path.string(), window, &error)) {
+    std::cerr << ", trace not written: " << error << "\n";
+    return {};
+  }
+  std::cerr << ", last " << stall->window_seconds << " s written to " << path.string() << "\n";
+  ++stall->dumps;
+  stall->next_dump_ns = now_ns + static_cast<uint64_t>(stall->window_seconds * 1e9);
+  return path;
+}
+
+const char* MetricsSceneName(const DemoState& state) {
+  return state.scene_mode == SceneMode::kMute95DominaSequence
+             ? SequenceStageName(state.sequence_stage)
+             : SceneModeName(state.scene_mode);
+}
+
+void AddMetricsFrame(MetricsStream* metrics,
+                     const DemoState& state,
+                     double frame_ms,
+                     const RenderStats& render,
+                     const AllocationCounters& allocations) {
+  metrics->elapsed_seconds += frame_ms / 1000.0;
+  metrics->frame_ms.push_back(frame_ms);
+  metrics->histogram.Add(frame_ms);
+  metrics->render.Add(render);
+  metrics->allocations += allocations;
+  SceneFrameTimes& scene = metrics->scenes[MetricsSceneName(state)];
+  ++scene.frames;
+  scene.total_ms += frame_ms;
+  scene.max_ms = std::max(scene.max_ms, frame_ms);
+  scene.render.Add(render);
+  scene.allocations += allocations;
+}
+
+// Allocations per frame, averaged over `frames`.
+void WriteAllocationsJson(std::ostream& out, const AllocationCounters& allocations, size_t frames) {
+  if (!forward::core::AllocationTrackingEnabled()) {
+    out << "null";
+    return;
+  }
+  const double scale = 1.0 / static_cast<double>(std::max<size_t>(frames, 1));
+  out << "{\"count\": " << static_cast<double>(allocations.count) * scale
+      << ", \"bytes\": " << static_cast<double>(allocations.bytes) * scale << "}";
+}
+
+// Renderer3D work per frame, averaged over `frames`.
+void WriteRenderStatsJson(std::ostream& out, const RenderStats& render, size_t frames) {
+  const double scale = 1.0 / static_cast<double>(std::max<size_t>(frames, 1));
+  out << "{\"draws\": " << static_cast<double>(render.draws) * scale
+      << ", \"triangles\": " << static_cast<double>(render.triangles_submitted) * scale
+      << ", \"near_rejected\": " << static_cast<double>(render.triangles_near_rejected) * scale
+      << ", \"near_clipped\": " << static_cast<double>(render.triangles_near_clipped) * scale
+      << ", \"backface_culled\": "
+      << static_cast<double>(render.triangles_backface_culled) * scale
+      << ", \"zero_area\": " << static_cast<double>(render.triangles_zero_area) * scale
+      << ", \"pixels_tested\": " << static_cast<double>(render.pixels_tested) * scale
+      << ", \"pixels_depth_rejected\": "
+      << static_cast<double>(render.pixels_depth_rejected) * scale
+      << ", \"pixels_shaded\": " << static_cast<double>(render.pixels_shaded) * scale << "}";
+}
+
+// `audio` is null while music is off.
+void WriteMetricsLine(MetricsStream* metrics,
+                      double wall_seconds,
+                      uint64_t frame,
+                      const DemoState& state,
+                      const XmPlayer* audio,
+                      const StallRecorder& stall,
+                      const FrameArena& arena,
+                      const RenderTargetPool& targets) {
+  std::ostream& out = *metrics->out;
+  const forward::core::FrameTimeSummary summary =
+      forward::core::SummarizeFrameTimes(metrics->frame_ms);
+  out << std::fixed << std::setprecision(3) << "{\"t\": " << wall_seconds
+      << ", \"frame\": " << frame << ", \"timeline_s\": " << state.timeline_seconds
+      << ", \"scene\": \"" << MetricsSceneName(state) << "\", \"mode\": \""
+      << SceneModeName(state.scene_mode) << "\", \"stage\": \""
+      << SequenceStageName(state.sequence_stage) << "\", \"order_row\": "
+      << state.music_order_row << ", \"frames\": " << summary.frames
+      << ", \"fps\": " << static_cast<double>(summary.frames) /
+                               std::max(metrics->elapsed_seconds, 0.0001)
+      << ", \"frame_ms\": {\"mean\": " << summary.mean_ms << ", \"p50\": " << summary.p50_ms
+      << ", \"p95\": " << summary.p95_ms << ", \"p99\": " << summary.p99_ms
+      << ", \"max\": " << summary.max_ms << "}, \"histogram\": {\"le_ms\": [";
+  for (size_t i = 0; i < forward::core::kFrameTimeBucketsMs.size(); ++i) {
+    out << (i ? ", " : "") << forward::core::kFrameTimeBucketsMs[i];
+  }
+  out << "], \"counts\": [";
+  for (size_t i = 0; i < metrics->histogram.counts.size(); ++i) {
+    out << (i ? ", " : "") << metrics->histogram.counts[i];
+  }
+  out << "]}, \"scenes\": {";
+  bool first = true;
+  for (const auto& [name, times] : metrics->scenes) {
+    out << (first ? "" : ", ") << "\"" << name << "\": {\"frames\": " << times.frames
+        << ", \"mean_ms\": " << times.total_ms / static_cast<double>(times.frames)
+        << ", \"max_ms\": " << times.max_ms << ", \"render\": ";
+    WriteRenderStatsJson(out, times.render, times.frames);
+    out << ", \"alloc\": ";
+    WriteAllocationsJson(out, times.allocations, times.frames);
+    out << "}";
+    first = false;
+  }
+  out << "}, \"render\": ";
+  WriteRenderStatsJson(out, metrics->render, summary.frames);
+  const AllocationCounters process = ProcessAllocations();
+  const AllocationCounters all_threads = process - metrics->process_mark;
+  out << ", \"alloc\": ";
+  WriteAllocationsJson(out, metrics->allocations, summary.frames);
+  out << ", \"alloc_all_threads\": ";
+  WriteAllocationsJson(out, all_threads, summary.frames);
+  if (audio) {
+    const XmTiming timing = audio->GetTiming();
+    const uint64_t now = SDL_GetPerformanceCounter();
+    const double clock_ms = InterpolateClockMs(timing, now);
+    const double snapshot_age_ms =
+        timing.host_counter == 0
+            ? 0.0
+            : static_cast<double>(now - timing.host_counter) * 1000.0 /
+                  static_cast<double>(SDL_GetPerformanceFrequency());
+    out << ", \"audio\": {\"clock_ms\": " << clock_ms
+        << ", \"timeline_lead_ms\": " << state.timeline_seconds * 1000.0 - clock_ms
+        << ", \"snapshot_age_ms\": " << snapshot_age_ms
+        << ", \"queued_ms\": " << audio->QueuedAudioMs()
+        << ", \"underruns\": " << audio->UnderrunCount() << "}";
+  }
+  out << ", \"arena\": {\"high_water_bytes\": " << arena.HighWater()
+      << ", \"capacity_bytes\": " << arena.Capacity()
+      << "}, \"render_targets\": {\"count\": " << targets.TargetCount()
+      << ", \"peak_in_use\": " << targets.PeakInUse()
+      << ", \"resident_bytes\": " << targets.ResidentBytes() << "}, \"stalls\": " << stall.stalls
+      << ", \"rss_bytes\": " << ResidentSetBytes() << "}\n";
+  out.flush();
+
+  metrics->elapsed_seconds = 0.0;
+  metrics->frame_ms.clear();
+  metrics->histogram.Clear();
+  metrics->render = RenderStats{};
+  metrics->allocations = AllocationCounters{};
+  metrics->process_mark = process;
+  metrics->scenes.clear();
+}
+
+void WriteMetricsStall(MetricsStream* metrics,
+                       double wall_seconds,
+                       uint64_t frame,
+                       double frame_ms,
+                       const DemoState& state,
+                       const std::filesystem::path& trace_path) {
+  *metrics->out << std::fixed << std::setprecision(3) << "{\"t\": " << wall_seconds
+                << ", \"event\": \"stall\", \"frame\": " << frame << ", \"frame_ms\": "
+                << frame_ms << ", \"scene\": \"" << MetricsSceneName(state)
+                << "\", \"trace\": \"" << trace_path.generic_string() << "\"}\n";
+  metrics->out->flush();
+}
+
+void PrintAllocationSites(size_t max_sites) {
+  for (const AllocationSite& site : TakeAllocationSites(max_sites)) {
+    std::cerr << "  " << site.count << " allocations, " << site.bytes << " bytes:\n";
+    for (const std::string& frame : site.frames) {
+      std::cerr << "    " << frame << "\n";
+    }
+  }
+}
+
 void DrawScrollingLayer(Surface32& surface,
                         const Image32& image,
                         int scroll_offset,
@@ -2331,9 +2129,7 @@ void DrawScrollingLayer(Surface32& surface,
       ((scroll_offset % image.height) + image.height) % image.height;
   const int first_h = std::min(kLogicalHeight, image.height - wrapped);
 
-  surface.AlphaBlitToBack(image.pixels.data(),
-                          image.width,
-                          image.height,
+  surface.AlphaBlitToBack(image,
                           0,
                           wrapped,
                           0,
@@ -2343,9 +2139,7 @@ void DrawScrollingLayer(Surface32& surface,
                           global_alpha);
 
   if (first_h < kLogicalHeight) {
-    surface.AlphaBlitToBack(image.pixels.data(),
-                            image.width,
-                            image.height,
+    surface.AlphaBlitToBack(image,
                             0,
                             0,
                             0,
@@ -2382,6 +2176,7 @@ Image32 BuildDebugCheckerTexture(int width,
 void DrawQuickWinPostLayer(Surface32& surface,
                            const DemoState& state,
                            const QuickWinPostLayer& post) {
+  FORWARD_PROFILE_ZONE("post.phorward");
   if (!state.show_post || !post.enabled || post.primary.Empty()) {
     return;
   }
@@ -2614,6 +2409,7 @@ void DrawUppolFrame(Surface32& surface,
                     const DemoState& state,
                     const UppolSceneAssets& assets,
                     UppolRuntime& runtime) {
+  FORWARD_PROFILE_ZONE("uppol");
   if (!assets.enabled || assets.phorward.Empty()) {
     surface.ClearBack(PackArgb(0, 0, 0));
     surface.SwapBuffers();
@@ -2683,7 +2479,7 @@ void ConfigureFetaInstance(RenderInstance& instance, const FetaSceneAssets& feta
   instance.wire_color = PackArgb(110, 255, 220);
   instance.draw_fill = true;
   instance.draw_wire = false;
-  instance.texture = feta.enabled ? &feta.babyenv : nullptr;
+  instance.texture = feta.enabled ? ImageView(feta.babyenv) : ImageView();
   instance.use_mesh_uv = true;
   instance.texture_wrap = true;
   instance.enable_backface_culling = true;
@@ -2700,7 +2496,7 @@ void ConfigureFetaHaloInstance(RenderInstance& instance,
   instance.wire_color = 0;
   instance.draw_fill = true;
   instance.draw_wire = false;
-  instance.texture = feta.enabled ? &feta.babyenv : nullptr;
+  instance.texture = feta.enabled ? ImageView(feta.babyenv) : ImageView();
   instance.use_mesh_uv = true;
   instance.texture_wrap = true;
   instance.enable_backface_culling = true;
@@ -2717,7 +2513,7 @@ void ConfigureKaaakmaBackgroundInstance(RenderInstance& instance,
   instance.wire_color = 0;
   instance.draw_fill = true;
   instance.draw_wire = false;
-  instance.texture = &background.texture;
+  instance.texture = background.texture;
   instance.use_mesh_uv = false;
   instance.texture_wrap = true;
   instance.enable_backface_culling = false;
@@ -2911,9 +2707,7 @@ void DrawMute95Credits(Surface32& surface,
 
   if (!pair.first.Empty() && alpha_first > 0.0f) {
     surface.AdditiveBlitToBack(
-        pair.first.pixels.data(),
-        pair.first.width,
-        pair.first.height,
+        pair.first,
         src_x,
         src_y,
         dst_x,
@@ -2924,9 +2718,7 @@ void DrawMute95Credits(Surface32& surface,
   }
   if (!pair.second.Empty() && alpha_second > 0.0f) {
     surface.AdditiveBlitToBack(
-        pair.second.pixels.data(),
-        pair.second.width,
-        pair.second.height,
+        pair.second,
         src_x,
         src_y,
         dst_x,
@@ -2943,6 +2735,7 @@ void DrawMute95FrameAtTime(Surface32& surface,
                            double scene_seconds,
                            double frame_dt_seconds,
                            int order_row) {
+  FORWARD_PROFILE_ZONE("mute95");
   if (!assets.enabled) {
     surface.ClearBack(PackArgb(0, 0, 0));
     surface.SwapBuffers();
@@ -3080,6 +2873,7 @@ void DrawDominaFrameAtTime(Surface32& surface,
                            DominaRuntime& runtime,
                            double scene_seconds,
                            bool trigger_script_fade_event) {
+  FORWARD_PROFILE_ZONE("domina");
   if (!assets.enabled) {
     surface.ClearBack(PackArgb(0, 0, 0));
     surface.SwapBuffers();
@@ -3197,6 +2991,7 @@ void TriggerSaariMessage(SaariRuntime& runtime, bool suh_full) {
 }
 
 void ApplySaariShockOverlay(Surface32& surface, SaariRuntime& runtime, int line_count) {
+  FORWARD_PROFILE_ZONE("saari.shock");
   if (line_count <= 0 || runtime.noise_lut.empty() || runtime.scanline_order.empty()) {
     return;
   }
@@ -3234,12 +3029,17 @@ void DrawSaariFrameAtTime(Surface32& surface,
                           SaariRuntime& runtime,
                           Camera& camera,
                           Renderer3D& renderer,
+                          FrameArena& arena,
+                          RenderTargetPool& targets,
+                          RenderPassGraph& passes,
+                          int layer_downscale,
                           RenderInstance& backdrop_instance,
                           RenderInstance& terrain_instance,
                           RenderInstance& object_instance,
                           double scene_seconds,
                           int order_row,
                           bool trigger_script_messages) {
+  FORWARD_PROFILE_ZONE("saari");
   if (!saari.enabled || saari.terrain.Empty()) {
     surface.ClearBack(PackArgb(0, 0, 0));
     surface.SwapBuffers();
@@ -3306,7 +3106,7 @@ void DrawSaariFrameAtTime(Surface32& surface,
     Vec3 position;
     Quat rotation;
   };
-  std::vector<SaariObjectPose> object_poses;
+  ArenaVector<SaariObjectPose> object_poses{ArenaAllocator<SaariObjectPose>(&arena)};
   if (!saari.animated_objects.empty()) {
     object_poses.reserve(saari.animated_objects.size());
     const Quat meditate_pi = QuatFromAxisAngle(Vec3(0.0f, 0.0f, 1.0f), kPi);
@@ -3340,8 +3140,8 @@ void DrawSaariFrameAtTime(Surface32& surface,
     terrain_origin.y = saari.target_track.front().value.y;
   }
 
-  surface.ClearBack(PackArgb(220, 230, 245));
-  if (!saari.backdrop_mesh.Empty() && !saari.backdrop_texture.Empty()) {
+  const bool draw_backdrop = !saari.backdrop_mesh.Empty() && !saari.backdrop_texture.Empty();
+  if (draw_backdrop) {
     backdrop_instance.rotation_radians.Set(0.0f, 0.0f, 0.0f);
     backdrop_instance.translation = camera.position;
     backdrop_instance.uniform_scale = saari.backdrop_scale;
@@ -3349,11 +3149,10 @@ void DrawSaariFrameAtTime(Surface32& surface,
     backdrop_instance.draw_fill = true;
     backdrop_instance.draw_wire = false;
     backdrop_instance.use_basis_rotation = false;
-    backdrop_instance.texture = &saari.backdrop_texture;
+    backdrop_instance.texture = saari.backdrop_texture;
     backdrop_instance.use_mesh_uv = true;
     backdrop_instance.texture_wrap = true;
     backdrop_instance.enable_backface_culling = false;
-    renderer.DrawMesh(surface, saari.backdrop_mesh, camera, backdrop_instance);
   }
 
   terrain_instance.rotation_radians.Set(0.0f, 0.0f, 0.0f);
@@ -3364,24 +3163,21 @@ void DrawSaariFrameAtTime(Surface32& surface,
   terrain_instance.draw_fill = true;
   terrain_instance.draw_wire = false;
   terrain_instance.use_basis_rotation = false;
-  terrain_instance.texture = &saari.terrain_texture;
+  terrain_instance.texture = saari.terrain_texture;
   terrain_instance.use_mesh_uv = true;
   terrain_instance.texture_wrap = true;
   terrain_instance.enable_backface_culling = true;
 
   // kmjakmk-style mirrored branch: draw a reflected terrain pass first,
   // then sea surface, then main terrain.
-  static Surface32 reflection_surface(kLogicalWidth, kLogicalHeight, true);
-  reflection_surface.ClearBack(0x00000000u);
   RenderInstance reflection_instance = terrain_instance;
-  reflection_instance.texture = !saari.water_texture.Empty() ? &saari.water_texture : &saari.terrain_texture;
+  reflection_instance.texture = !saari.water_texture.Empty() ? saari.water_texture : saari.terrain_texture;
   reflection_instance.texture_unlit = true;
   reflection_instance.use_basis_rotation = true;
   reflection_instance.basis_x = Vec3(1.0f, 0.0f, 0.0f);
   reflection_instance.basis_y = Vec3(0.0f, 1.0f, 0.0f);
   reflection_instance.basis_z = Vec3(0.0f, 0.0f, -1.0f);
   reflection_instance.enable_backface_culling = false;
-  renderer.DrawMesh(reflection_surface, saari.terrain, camera, reflection_instance);
 
   RenderInstance reflection_object_instance = object_instance;
   reflection_object_instance.uniform_scale = 1.0f;
@@ -3389,42 +3185,16 @@ void DrawSaariFrameAtTime(Surface32& surface,
   reflection_object_instance.wire_color = 0;
   reflection_object_instance.draw_fill = true;
   reflection_object_instance.draw_wire = false;
-  reflection_object_instance.texture = &saari.backdrop_texture;
+  reflection_object_instance.texture = saari.backdrop_texture;
   reflection_object_instance.use_mesh_uv = false;
   reflection_object_instance.texture_wrap = true;
   reflection_object_instance.enable_backface_culling = false;
-  for (const SaariObjectPose& pose : object_poses) {
-    if (!pose.mesh || pose.mesh->Empty()) {
-      continue;
-    }
-    reflection_object_instance.translation = Vec3(pose.position.x, pose.position.y, -pose.position.z);
-    SetRenderInstanceBasisFromQuat(reflection_object_instance, pose.rotation);
-    reflection_object_instance.basis_x.z = -reflection_object_instance.basis_x.z;
-    reflection_object_instance.basis_y.z = -reflection_object_instance.basis_y.z;
-    reflection_object_instance.basis_z.z = -reflection_object_instance.basis_z.z;
-    renderer.DrawMesh(reflection_surface, *pose.mesh, camera, reflection_object_instance);
-  }
-
-  reflection_surface.SwapBuffers();
-  surface.AlphaBlitToBack(reflection_surface.FrontPixels(),
-                          kLogicalWidth,
-                          kLogicalHeight,
-                          0,
-                          0,
-                          0,
-                          0,
-                          kLogicalWidth,
-                          kLogicalHeight,
-                          140);
 
   RenderInstance sea_instance = terrain_instance;
-  sea_instance.texture = !saari.water_texture.Empty() ? &saari.water_texture : &saari.terrain_texture;
+  sea_instance.texture = !saari.water_texture.Empty() ? saari.water_texture : saari.terrain_texture;
   sea_instance.texture_unlit = true;
   sea_instance.enable_backface_culling = false;
-  renderer.DrawMesh(surface, saari.sea, camera, sea_instance);
-
   terrain_instance.texture_unlit = false;
-  renderer.DrawMesh(surface, saari.terrain, camera, terrain_instance);
 
   if (!object_poses.empty()) {
     object_instance.uniform_scale = 1.0f;
@@ -3432,23 +3202,68 @@ void DrawSaariFrameAtTime(Surface32& surface,
     object_instance.wire_color = 0;
     object_instance.draw_fill = true;
     object_instance.draw_wire = false;
-    object_instance.texture = &saari.backdrop_texture;
+    object_instance.texture = saari.backdrop_texture;
     object_instance.use_mesh_uv = false;
     object_instance.texture_wrap = true;
     object_instance.enable_backface_culling = true;
+  }
 
+  // The mirrored pass has its own target, so it renders while the backdrop
+  // goes into the frame. It only shows through at alpha 140, so it can be
+  // drawn at reduced size and stretched back.
+  const RenderTargetPool::Lease reflection =
+      targets.Acquire(kLogicalWidth / layer_downscale, kLogicalHeight / layer_downscale);
+  Surface32& reflection_surface = *reflection;
+  passes.AddPass("saari.backdrop", {}, {&surface}, [&](Renderer3D& context) {
+    surface.ClearBack(PackArgb(220, 230, 245));
+    if (draw_backdrop) {
+      context.DrawMesh(surface, saari.backdrop_mesh, camera, backdrop_instance);
+    }
+  });
+  passes.AddPass("saari.reflection", {}, {&reflection_surface}, [&](Renderer3D& context) {
+    reflection_surface.ClearBack(0x00000000u);
+    context.DrawMesh(reflection_surface, saari.terrain, camera, reflection_instance);
     for (const SaariObjectPose& pose : object_poses) {
       if (!pose.mesh || pose.mesh->Empty()) {
         continue;
       }
-      object_instance.translation = pose.position;
-      SetRenderInstanceBasisFromQuat(object_instance, pose.rotation);
-      renderer.DrawMesh(surface, *pose.mesh, camera, object_instance);
+      reflection_object_instance.translation = Vec3(pose.position.x, pose.position.y, -pose.position.z);
+      SetRenderInstanceBasisFromQuat(reflection_object_instance, pose.rotation);
+      reflection_object_instance.basis_x.z = -reflection_object_instance.basis_x.z;
+      reflection_object_instance.basis_y.z = -reflection_object_instance.basis_y.z;
+      reflection_object_instance.basis_z.z = -reflection_object_instance.basis_z.z;
+      context.DrawMesh(reflection_surface, *pose.mesh, camera, reflection_object_instance);
+    }
+    reflection_surface.SwapBuffers();
+  });
+  passes.AddPass("saari.scene", {&reflection_surface}, {&surface}, [&](Renderer3D& context) {
+    surface.AlphaBlitScaledToBack(
+        reflection_surface.FrontView(), 0, 0, kLogicalWidth, kLogicalHeight, 140);
+    {
+      FORWARD_PROFILE_ZONE("saari.sea");
+      context.DrawMesh(surface, saari.sea, camera, sea_instance);
+    }
+    {
+      FORWARD_PROFILE_ZONE("saari.terrain");
+      context.DrawMesh(surface, saari.terrain, camera, terrain_instance);
+    }
+    if (!object_poses.empty()) {
+      FORWARD_PROFILE_ZONE("saari.objects");
+      for (const SaariObjectPose& pose : object_poses) {
+        if (!pose.mesh || pose.mesh->Empty()) {
+          continue;
+        }
+        object_instance.translation = pose.position;
+        SetRenderInstanceBasisFromQuat(object_instance, pose.rotation);
+        context.DrawMesh(surface, *pose.mesh, camera, object_instance);
+      }
     }
-  }
 
-  const int lines = static_cast<int>(runtime.shock_percent * static_cast<float>(kLogicalHeight) / 100.0f);
-  ApplySaariShockOverlay(surface, runtime, lines);
+    const int lines =
+        static_cast<int>(runtime.shock_percent * static_cast<float>(kLogicalHeight) / 100.0f);
+    ApplySaariShockOverlay(surface, runtime, lines);
+  });
+  passes.Execute(renderer);
   surface.SwapBuffers();
 }
 
@@ -3458,6 +3273,9 @@ void DrawSaariFrame(Surface32& surface,
                     SaariRuntime& runtime,
                     Camera& camera,
                     Renderer3D& renderer,
+                    FrameArena& arena,
+                    RenderTargetPool& targets,
+                    RenderPassGraph& passes,
                     RenderInstance& backdrop_instance,
                     RenderInstance& terrain_instance,
                     RenderInstance& object_instance) {
@@ -3468,6 +3286,10 @@ void DrawSaariFrame(Surface32& surface,
                        runtime,
                        camera,
                        renderer,
+                       arena,
+                       targets,
+                       passes,
+                       LayerDownscale(state),
                        backdrop_instance,
                        terrain_instance,
                        object_instance,
@@ -3476,15 +3298,11 @@ void DrawSaariFrame(Surface32& surface,
                        true);
 }
 
-bool RowCrossed(int previous_row, int current_row, int target_row) {
-  if (previous_row < 0 || current_row < 0 || previous_row == current_row) {
-    return false;
-  }
-  if (previous_row < current_row) {
-    return target_row > previous_row && target_row <= current_row;
-  }
-  // Wrapped or jumped backwards.
-  return target_row > previous_row || target_row <= current_row;
+bool IsPendingCheckpoint(const std::vector<int>& checkpoints,
+                         const std::unordered_set<int>& captured_rows,
+                         int order_row) {
+  return captured_rows.find(order_row) == captured_rows.end() &&
+         std::find(checkpoints.begin(), checkpoints.end(), order_row) != checkpoints.end();
 }
 
 std::string FormatOrderRowHex(int order_row) {
@@ -3513,6 +3331,23 @@ bool ParseOrderRowArgument(const std::string& value, int* out_order_row) {
   }
 }
 
+// "[M:]order-row", where M is module 1 or 2 and defaults to `default_slot`.
+bool ParseModuleOrderRowArgument(std::string value,
+                                 int default_slot,
+                                 int* out_slot,
+                                 int* out_order_row) {
+  int slot = default_slot;
+  if (value.size() > 2 && value[1] == ':' && (value[0] == '1' || value[0] == '2')) {
+    slot = value[0] - '0';
+    value = value.substr(2);
+  }
+  if (!out_slot || !ParseOrderRowArgument(value, out_order_row)) {
+    return false;
+  }
+  *out_slot = slot;
+  return true;
+}
+
 bool WritePpmImage(const std::filesystem::path& output_path,
                    const uint32_t* pixels,
                    int width,
@@ -3554,7 +3389,7 @@ bool TryLoadWatercubeReferenceFrame(const std::filesystem::path& ref_dir, int or
       if (!std::filesystem::exists(candidate)) {
         continue;
       }
-      if (forward::core::LoadImage32(candidate.string(), *out, &error) && !out->Empty()) {
+      if (LoadImage32Cached(candidate.string(), *out, &error) && !out->Empty()) {
         return true;
       }
     }
@@ -3617,41 +3452,32 @@ void CaptureWatercubeCheckpointFrame(const WatercubeValidationHarness& harness,
   }
 }
 
+// Checkpoints fire on the row events delivered since the previous frame, so
+// a slow frame cannot skip one and captures do not depend on the frame rate.
 void MaybeCaptureWatercubeCheckpoint(WatercubeValidationHarness* harness,
                                      const DemoState& state,
+                                     std::span<const XmRowEvent> row_events,
                                      const XmTiming& timing,
                                      const Surface32& surface,
                                      const WatercubeRuntime& runtime) {
   if (!harness || !harness->enabled) {
     return;
   }
-  if (!timing.valid || timing.module_slot != 2) {
-    return;
-  }
   if (state.scene_mode != SceneMode::kMute95DominaSequence ||
       state.sequence_stage != SequenceStage::kWatercube) {
     return;
   }
 
-  const int order_row = PackOrderRow(timing.order, timing.row);
-  if (harness->last_order_row < 0) {
-    harness->last_order_row = order_row;
-  }
-
-  for (int checkpoint : harness->checkpoints) {
-    if (harness->captured_rows.find(checkpoint) != harness->captured_rows.end()) {
-      continue;
-    }
-    const bool reached =
-        (order_row == checkpoint) || RowCrossed(harness->last_order_row, order_row, checkpoint);
-    if (!reached) {
+  for (const XmRowEvent& event : row_events) {
+    const int order_row = PackOrderRow(event.order, event.row);
+    if (event.module_slot != 2 ||
+        !IsPendingCheckpoint(harness->checkpoints, harness->captured_rows, order_row)) {
       continue;
     }
-    CaptureWatercubeCheckpointFrame(*harness, checkpoint, timing, surface, runtime);
-    harness->captured_rows.insert(checkpoint);
-    std::cerr << "watercube checkpoint captured: 0x" << FormatOrderRowHex(checkpoint) << "\n";
+    CaptureWatercubeCheckpointFrame(*harness, order_row, timing, surface, runtime);
+    harness->captured_rows.insert(order_row);
+    std::cerr << "watercube checkpoint captured: 0x" << FormatOrderRowHex(order_row) << "\n";
   }
-  harness->last_order_row = order_row;
 }
 
 bool TryLoadMakuReferenceFrame(const std::filesystem::path& ref_dir, int order_row, Image32* out) {
@@ -3668,7 +3494,7 @@ bool TryLoadMakuReferenceFrame(const std::filesystem::path& ref_dir, int order_r
       if (!std::filesystem::exists(candidate)) {
         continue;
       }
-      if (forward::core::LoadImage32(candidate.string(), *out, &error) && !out->Empty()) {
+      if (LoadImage32Cached(candidate.string(), *out, &error) && !out->Empty()) {
         return true;
       }
     }
@@ -3743,6 +3569,7 @@ void CaptureMakuCheckpointFrame(const MakuValidationHarness& harness,
 
 void MaybeCaptureMakuCheckpoint(MakuValidationHarness* harness,
                                 const DemoState& state,
+                                std::span<const XmRowEvent> row_events,
                                 const XmTiming& timing,
                                 const Surface32& surface,
                                 const MakuRuntime& runtime) {
@@ -3752,38 +3579,25 @@ void MaybeCaptureMakuCheckpoint(MakuValidationHarness* harness,
   const bool in_sequence_maku =
       state.scene_mode == SceneMode::kMute95DominaSequence && state.sequence_stage == SequenceStage::kMaku;
   const bool in_direct_maku = state.scene_mode == SceneMode::kMaku;
-  if (!in_sequence_maku && !in_direct_maku) {
-    return;
-  }
-
-  int order_row = -1;
-  if (in_sequence_maku && timing.valid && timing.module_slot == 2) {
-    order_row = PackOrderRow(timing.order, timing.row);
-  } else if (in_direct_maku) {
-    order_row = harness->direct_row_hint;
-  }
-  if (order_row < 0) {
-    return;
-  }
 
-  if (harness->last_order_row < 0) {
-    harness->last_order_row = order_row;
-  }
-
-  for (int checkpoint : harness->checkpoints) {
-    if (harness->captured_rows.find(checkpoint) != harness->captured_rows.end()) {
-      continue;
+  auto capture = [&](int order_row) {
+    if (!IsPendingCheckpoint(harness->checkpoints, harness->captured_rows, order_row)) {
+      return;
     }
-    const bool reached =
-        (order_row == checkpoint) || RowCrossed(harness->last_order_row, order_row, checkpoint);
-    if (!reached) {
-      continue;
+    CaptureMakuCheckpointFrame(*harness, order_row, state, timing, surface, runtime);
+    harness->captured_rows.insert(order_row);
+    std::cerr << "maku checkpoint captured: 0x" << FormatOrderRowHex(order_row) << "\n";
+  };
+  if (in_sequence_maku) {
+    for (const XmRowEvent& event : row_events) {
+      if (event.module_slot == 2) {
+        capture(PackOrderRow(event.order, event.row));
+      }
     }
-    CaptureMakuCheckpointFrame(*harness, checkpoint, state, timing, surface, runtime);
-    harness->captured_rows.insert(checkpoint);
-    std::cerr << "maku checkpoint captured: 0x" << FormatOrderRowHex(checkpoint) << "\n";
+  } else if (in_direct_maku) {
+    // Direct mode has no music; the scene is frozen at the requested row.
+    capture(harness->direct_row_hint);
   }
-  harness->last_order_row = order_row;
 }
 
 bool TryLoadFetaReferenceFrame(const std::filesystem::path& ref_dir,
@@ -3807,7 +3621,7 @@ bool TryLoadFetaReferenceFrame(const std::filesystem::path& ref_dir,
       if (!std::filesystem::exists(candidate)) {
         continue;
       }
-      if (forward::core::LoadImage32(candidate.string(), *out, &error) && !out->Empty()) {
+      if (LoadImage32Cached(candidate.string(), *out, &error) && !out->Empty()) {
         return true;
       }
     }
@@ -3835,6 +3649,24 @@ const char* SceneModeName(SceneMode mode) {
   return "unknown";
 }
 
+const char* SequenceStageName(SequenceStage stage) {
+  switch (stage) {
+    case SequenceStage::kMute95:
+      return "mute95";
+    case SequenceStage::kDomina:
+      return "domina";
+    case SequenceStage::kSaari:
+      return "saari";
+    case SequenceStage::kKukot:
+      return "kukot";
+    case SequenceStage::kMaku:
+      return "maku";
+    case SequenceStage::kWatercube:
+      return "watercube";
+  }
+  return "unknown";
+}
+
 void CaptureFetaCheckpointFrame(const FetaValidationHarness& harness,
                                 int order_row,
                                 const DemoState& state,
@@ -3860,7 +3692,7 @@ void CaptureFetaCheckpointFrame(const FetaValidationHarness& harness,
     metrics << "palette_255_black=" << (runtime.palette_index_255_black ? 1 : 0) << "\n";
     metrics << "blackfeta_start_seconds=" << runtime.blackfeta_start_seconds << "\n";
     metrics << "blackmuna_start_seconds=" << runtime.blackmuna_start_seconds << "\n";
-    metrics << "next_script_event=" << runtime.next_script_event << "\n";
+    metrics << "next_script_event=" << runtime.script_cursor.Position() << "\n";
   }
 
   if (harness.has_reference_dir) {
@@ -3894,42 +3726,30 @@ void CaptureFetaCheckpointFrame(const FetaValidationHarness& harness,
 
 void MaybeCaptureFetaCheckpoint(FetaValidationHarness* harness,
                                 const DemoState& state,
+                                std::span<const XmRowEvent> row_events,
                                 const XmTiming& timing,
                                 const Surface32& surface,
                                 const FetaRuntime& runtime) {
-  if (!harness || !harness->enabled) {
-    return;
-  }
-  if (!timing.valid || timing.module_slot != 2 || !state.script_driven) {
+  if (!harness || !harness->enabled || !state.script_driven) {
     return;
   }
 
-  const int order_row = PackOrderRow(timing.order, timing.row);
-  if (harness->last_order_row < 0) {
-    harness->last_order_row = order_row;
-  }
-
-  for (int checkpoint : harness->checkpoints) {
-    if (harness->captured_rows.find(checkpoint) != harness->captured_rows.end()) {
-      continue;
-    }
-    const bool reached =
-        (order_row == checkpoint) || RowCrossed(harness->last_order_row, order_row, checkpoint);
-    if (!reached) {
+  for (const XmRowEvent& event : row_events) {
+    const int order_row = PackOrderRow(event.order, event.row);
+    if (event.module_slot != 2 ||
+        !IsPendingCheckpoint(harness->checkpoints, harness->captured_rows, order_row)) {
       continue;
     }
-    CaptureFetaCheckpointFrame(*harness, checkpoint, state, timing, surface, runtime);
-    harness->captured_rows.insert(checkpoint);
-    std::cerr << "feta checkpoint captured: 0x" << FormatOrderRowHex(checkpoint) << "\n";
+    CaptureFetaCheckpointFrame(*harness, order_row, state, timing, surface, runtime);
+    harness->captured_rows.insert(order_row);
+    std::cerr << "feta checkpoint captured: 0x" << FormatOrderRowHex(order_row) << "\n";
   }
-  harness->last_order_row = order_row;
 }
 
 void InitializeKukotRuntime(KukotRuntime& runtime) {
   runtime.flash_intensity = 0.0f;
   runtime.flash_decay = 0.0f;
-  runtime.next_script_event = 0;
-  runtime.last_order_row = -1;
+  runtime.script_cursor = MakeSceneScriptCursor(ScriptSymbol::kKukot, true);
   runtime.prev_scene_seconds = 0.0;
   runtime.rng_state = 0x4b554b4fu;
 
@@ -3965,7 +3785,6 @@ void InitializeKukotRuntime(KukotRuntime& runtime) {
     p.energy = RandomRange(&runtime.rng_state, 0.90f, 1.10f);
   }
 
-  runtime.deformed_meshes.clear();
   runtime.frame_packed10.assign(static_cast<size_t>(kLogicalWidth) *
                                     static_cast<size_t>(kLogicalHeight),
                                 0u);
@@ -3975,58 +3794,35 @@ void InitializeKukotRuntime(KukotRuntime& runtime) {
   runtime.initialized = true;
 }
 
-void ApplyKukotMessage(KukotRuntime& runtime, const std::string& message) {
-  if (message == "suh") {
-    runtime.flash_intensity = 50.0f;
-    runtime.flash_decay = 200.0f;
-    return;
-  }
-  if (message == "suh0") {
-    runtime.flash_intensity = 100.0f;
-    runtime.flash_decay = 150.0f;
-    return;
-  }
-  if (message == "suh1") {
-    runtime.flash_intensity = 128.0f;
-    runtime.flash_decay = 50.0f;
-    return;
-  }
-  if (message == "suh2") {
-    runtime.flash_intensity = 256.0f;
-    runtime.flash_decay = 70.0f;
+void ApplyKukotMessage(KukotRuntime& runtime, const ScriptEvent& event) {
+  switch (MessageSymbol(event)) {
+    case ScriptSymbol::kSuh:
+      runtime.flash_intensity = 50.0f;
+      runtime.flash_decay = 200.0f;
+      break;
+    case ScriptSymbol::kSuh0:
+      runtime.flash_intensity = 100.0f;
+      runtime.flash_decay = 150.0f;
+      break;
+    case ScriptSymbol::kSuh1:
+      runtime.flash_intensity = 128.0f;
+      runtime.flash_decay = 50.0f;
+      break;
+    case ScriptSymbol::kSuh2:
+      runtime.flash_intensity = 256.0f;
+      runtime.flash_decay = 70.0f;
+      break;
+    default:
+      break;
   }
 }
 
 void RunKukotScriptAtOrderRow(KukotRuntime& runtime, int order_row) {
-  if (order_row < 0) {
-    return;
-  }
-  const std::vector<ScriptMessageEvent>& events = GetKukotScriptData().events;
-  if (events.empty()) {
-    return;
-  }
-
-  const int previous_row = runtime.last_order_row;
-  if (runtime.last_order_row < 0) {
-    runtime.last_order_row = order_row;
-  }
-
-  while (runtime.next_script_event < static_cast<int>(events.size())) {
-    const ScriptMessageEvent& ev = events[static_cast<size_t>(runtime.next_script_event)];
-    bool reached = false;
-    if (previous_row < 0) {
-      reached = order_row >= ev.order_row;
-    } else {
-      reached = (order_row == ev.order_row) ||
-                RowCrossed(runtime.last_order_row, order_row, ev.order_row);
-    }
-    if (!reached) {
-      break;
-    }
-    ApplyKukotMessage(runtime, ev.message);
-    ++runtime.next_script_event;
+  FORWARD_PROFILE_ZONE("script.kukot");
+  runtime.script_cursor.Advance(order_row);
+  while (const ScriptEvent* event = runtime.script_cursor.Next()) {
+    ApplyKukotMessage(runtime, *event);
   }
-  runtime.last_order_row = order_row;
 }
 
 void ConvertArgbBufferToPacked10(const uint32_t* argb, uint32_t* packed10, size_t count) {
@@ -4043,6 +3839,7 @@ void ConvertArgbBufferToPacked10(const uint32_t* argb, uint32_t* packed10, size_
 }
 
 void ApplyKukotFlashOverlayPacked(uint32_t* packed10, KukotRuntime& runtime, int amount) {
+  FORWARD_PROFILE_ZONE("kukot.flash");
   if (amount == 0 || !packed10 || runtime.flash_lut_10.empty() ||
       runtime.flash_scanline_order.empty()) {
     return;
@@ -4075,6 +3872,7 @@ void ApplyKukotFlashOverlayPacked(uint32_t* packed10, KukotRuntime& runtime, int
 }
 
 void ApplyKukotHorizontalFeedbackBlurPacked(uint32_t* packed10, float blend) {
+  FORWARD_PROFILE_ZONE("kukot.blur");
   if (!packed10) {
     return;
   }
@@ -4082,6 +3880,7 @@ void ApplyKukotHorizontalFeedbackBlurPacked(uint32_t* packed10, float blend) {
 }
 
 void ApplyKukotTemporalAddHalfPacked(uint32_t* packed10, const uint32_t* prev_packed10) {
+  FORWARD_PROFILE_ZONE("kukot.temporal");
   if (!packed10 || !prev_packed10) {
     return;
   }
@@ -4089,23 +3888,12 @@ void ApplyKukotTemporalAddHalfPacked(uint32_t* packed10, const uint32_t* prev_pa
   legacy10::AddHalfSaturating(packed10, prev_packed10, count);
 }
 
-void ApplyKukotProceduralDeformation(const Mesh& source, float phase, Mesh* out_mesh) {
-  if (!out_mesh) {
-    return;
-  }
-  if (source.Empty()) {
-    out_mesh->Clear();
-    return;
-  }
-
-  if (out_mesh->triangles.size() != source.triangles.size()) {
-    out_mesh->triangles = source.triangles;
-  }
-  if (out_mesh->texcoords.size() != source.texcoords.size()) {
-    out_mesh->texcoords = source.texcoords;
-  }
-  out_mesh->positions.resize(source.positions.size());
-  out_mesh->normals.clear();
+// `out_positions` and `out_normals` hold one entry per source position.
+void ApplyKukotProceduralDeformation(const Mesh& source,
+                                     float phase,
+                                     std::span<Vec3> out_positions,
+                                     std::span<Vec3> out_normals) {
+  FORWARD_PROFILE_ZONE("kukot.deform");
 
   // Java kukot path (mmajmmk.kKAMAJa, jAkKAma=2):
   // pivot (0,0.8,0), then per-vertex XY rotation:
@@ -4125,9 +3913,9 @@ void ApplyKukotProceduralDeformation(const Mesh& source, float phase, Mesh* out_
     const float y = p.y * c + p.x * s;
     p.x = x;
     p.y = y + kPivotY;
-    out_mesh->positions[i] = p;
+    out_positions[i] = p;
   }
-  out_mesh->RebuildVertexNormals();
+  ComputeVertexNormals(out_positions, source.triangles, out_normals);
 }
 
 void DrawKukotParticles(Surface32& surface,
@@ -4135,6 +3923,7 @@ void DrawKukotParticles(Surface32& surface,
                         const KukotSceneAssets& kukot,
                         KukotRuntime& runtime,
                         double scene_seconds) {
+  FORWARD_PROFILE_ZONE("kukot.particles");
   (void)scene_seconds;
   if (kukot.flare.Empty() || runtime.particles.empty()) {
     return;
@@ -4160,9 +3949,7 @@ void DrawKukotParticles(Surface32& surface,
     const uint8_t intensity = static_cast<uint8_t>(
         std::clamp(static_cast<int>(std::lround(intensity_f)), 96, 255));
 
-    surface.AdditiveBlitScaledToBack(kukot.flare.pixels.data(),
-                                     kukot.flare.width,
-                                     kukot.flare.height,
+    surface.AdditiveBlitScaledToBack(kukot.flare,
                                      sx - sprite_size / 2,
                                      sy - sprite_size / 2,
                                      sprite_size,
@@ -4177,9 +3964,11 @@ void DrawKukotFrameAtTime(Surface32& surface,
                           KukotRuntime& runtime,
                           Camera& camera,
                           Renderer3D& renderer,
+                          FrameArena& arena,
                           RenderInstance& object_instance,
                           double scene_seconds,
                           bool trigger_script_messages) {
+  FORWARD_PROFILE_ZONE("kukot");
   if (!kukot.enabled || kukot.object_texture.Empty() || kukot.random_tile.Empty() ||
       kukot.animated_objects.empty()) {
     surface.ClearBack(PackArgb(0, 0, 0));
@@ -4223,9 +4012,7 @@ void DrawKukotFrameAtTime(Surface32& surface,
   const int y_offsets[2] = {-random_y, -random_y + 128};
   for (int yy = 0; yy < 2; ++yy) {
     for (int xx = 0; xx < 4; ++xx) {
-      surface.AlphaBlitToBack(kukot.random_tile.pixels.data(),
-                              kukot.random_tile.width,
-                              kukot.random_tile.height,
+      surface.AlphaBlitToBack(kukot.random_tile,
                               0,
                               0,
                               x_offsets[xx],
@@ -4241,14 +4028,11 @@ void DrawKukotFrameAtTime(Surface32& surface,
   object_instance.wire_color = 0;
   object_instance.draw_fill = true;
   object_instance.draw_wire = false;
-  object_instance.texture = &kukot.object_texture;
+  object_instance.texture = kukot.object_texture;
   object_instance.use_mesh_uv = false;
   object_instance.texture_wrap = true;
   object_instance.enable_backface_culling = true;
 
-  if (runtime.deformed_meshes.size() != kukot.animated_objects.size()) {
-    runtime.deformed_meshes.resize(kukot.animated_objects.size());
-  }
   const float deform_phase = static_cast<float>(scene_seconds * 1.9);
 
   for (size_t i = 0; i < kukot.animated_objects.size(); ++i) {
@@ -4256,6 +4040,7 @@ void DrawKukotFrameAtTime(Surface32& surface,
     if (obj.mesh.Empty()) {
       continue;
     }
+    FORWARD_PROFILE_ZONE("kukot.object");
     Vec3 obj_pos = obj.base_position;
     if (!obj.position_track.empty()) {
       obj_pos = SampleTrackJavaLoopEndpointClampedAtMs(obj.position_track, t_ms);
@@ -4268,9 +4053,10 @@ void DrawKukotFrameAtTime(Surface32& surface,
     object_instance.translation = obj_pos;
     SetRenderInstanceBasisFromQuat(object_instance, obj_rot);
 
-    Mesh& deformed_mesh = runtime.deformed_meshes[i];
-    ApplyKukotProceduralDeformation(obj.mesh, deform_phase, &deformed_mesh);
-    renderer.DrawMesh(surface, deformed_mesh, camera, object_instance);
+    ArenaVector<Vec3> positions(obj.mesh.positions.size(), ArenaAllocator<Vec3>(&arena));
+    ArenaVector<Vec3> normals(obj.mesh.positions.size(), ArenaAllocator<Vec3>(&arena));
+    ApplyKukotProceduralDeformation(obj.mesh, deform_phase, positions, normals);
+    renderer.DrawMesh(surface, obj.mesh, positions, normals, camera, object_instance);
   }
 
   DrawKukotParticles(surface, camera, kukot, runtime, scene_seconds);
@@ -4325,8 +4111,7 @@ void InitializeMakuRuntime(MakuRuntime& runtime) {
   runtime.ksor_enabled = false;
   runtime.flash_intensity = 0.0f;
   runtime.flash_decay = 0.0f;
-  runtime.next_script_event = 0;
-  runtime.last_order_row = -1;
+  runtime.script_cursor = MakeSceneScriptCursor(ScriptSymbol::kMaku, true);
   runtime.last_camera_position = Vec3(0.0f, 0.0f, 0.0f);
   runtime.last_camera_target = Vec3(0.0f, 0.0f, 0.0f);
   runtime.last_eval_seconds = 0.0;
@@ -4334,76 +4119,45 @@ void InitializeMakuRuntime(MakuRuntime& runtime) {
   runtime.initialized = true;
 }
 
-void ApplyMakuMessage(MakuRuntime& runtime, const std::string& message, double scene_seconds) {
-  if (message == "suh") {
-    runtime.flash_intensity = 120.0f;
-    runtime.flash_decay = 200.0f;
-    return;
-  }
-  if (message == "suh0") {
-    runtime.flash_intensity = 128.0f;
-    runtime.flash_decay = 50.0f;
-    return;
-  }
-  if (message == "suh1") {
-    runtime.flash_intensity = 128.0f;
-    runtime.flash_decay = 50.0f;
-    return;
-  }
-  if (message == "suh2") {
-    runtime.flash_intensity = 256.0f;
-    runtime.flash_decay = 70.0f;
-    return;
-  }
-  if (message == "ksor") {
-    runtime.ksor_enabled = !runtime.ksor_enabled;
-    return;
-  }
-  if (message == "roll") {
-    runtime.roll_enabled = !runtime.roll_enabled;
-    return;
-  }
-  if (message.rfind("go ", 0) == 0) {
-    runtime.go_base_seconds = std::stof(message.substr(3));
-    runtime.go_anchor_seconds = scene_seconds;
-    return;
-  }
-  if (message.rfind("speed ", 0) == 0) {
-    runtime.playback_speed = std::stof(message.substr(6));
+void ApplyMakuMessage(MakuRuntime& runtime, const ScriptEvent& event, double scene_seconds) {
+  switch (MessageSymbol(event)) {
+    case ScriptSymbol::kSuh:
+      runtime.flash_intensity = 120.0f;
+      runtime.flash_decay = 200.0f;
+      break;
+    case ScriptSymbol::kSuh0:
+    case ScriptSymbol::kSuh1:
+      runtime.flash_intensity = 128.0f;
+      runtime.flash_decay = 50.0f;
+      break;
+    case ScriptSymbol::kSuh2:
+      runtime.flash_intensity = 256.0f;
+      runtime.flash_decay = 70.0f;
+      break;
+    case ScriptSymbol::kKsor:
+      runtime.ksor_enabled = !runtime.ksor_enabled;
+      break;
+    case ScriptSymbol::kRoll:
+      runtime.roll_enabled = !runtime.roll_enabled;
+      break;
+    case ScriptSymbol::kGo:
+      runtime.go_base_seconds = event.argument;
+      runtime.go_anchor_seconds = scene_seconds;
+      break;
+    case ScriptSymbol::kSpeed:
+      runtime.playback_speed = event.argument;
+      break;
+    default:
+      break;
   }
 }
 
 void RunMakuScriptAtOrderRow(MakuRuntime& runtime, int order_row, double scene_seconds) {
-  if (order_row < 0) {
-    return;
-  }
-
-  const std::vector<ScriptMessageEvent>& events = GetMakuScriptData().events;
-  if (events.empty()) {
-    return;
-  }
-
-  const int previous_row = runtime.last_order_row;
-  if (runtime.last_order_row < 0) {
-    runtime.last_order_row = order_row;
-  }
-
-  while (runtime.next_script_event < static_cast<int>(events.size())) {
-    const ScriptMessageEvent& ev = events[static_cast<size_t>(runtime.next_script_event)];
-    bool reached = false;
-    if (previous_row < 0) {
-      reached = order_row >= ev.order_row;
-    } else {
-      reached = (order_row == ev.order_row) ||
-                RowCrossed(runtime.last_order_row, order_row, ev.order_row);
-    }
-    if (!reached) {
-      break;
-    }
-    ApplyMakuMessage(runtime, ev.message, scene_seconds);
-    ++runtime.next_script_event;
+  FORWARD_PROFILE_ZONE("script.maku");
+  runtime.script_cursor.Advance(order_row);
+  while (const ScriptEvent* event = runtime.script_cursor.Next()) {
+    ApplyMakuMessage(runtime, *event, scene_seconds);
   }
-  runtime.last_order_row = order_row;
 }
 
 void DrawMakuFrameAtTime(Surface32& surface,
@@ -4415,6 +4169,7 @@ void DrawMakuFrameAtTime(Surface32& surface,
                          RenderInstance& terrain_instance,
                          double scene_seconds,
                          bool trigger_script_messages) {
+  FORWARD_PROFILE_ZONE("maku");
   if (!maku.enabled || maku.terrain.Empty() || maku.terrain_texture.Empty()) {
     surface.ClearBack(PackArgb(0, 0, 0));
     surface.SwapBuffers();
@@ -4469,12 +4224,16 @@ void DrawMakuFrameAtTime(Surface32& surface,
   terrain_instance.draw_fill = true;
   terrain_instance.draw_wire = false;
   terrain_instance.use_basis_rotation = false;
-  terrain_instance.texture = state.debug_maku_no_fog ? &s_maku_debug_checker : &maku.terrain_texture;
+  terrain_instance.texture =
+      state.debug_maku_no_fog ? ImageView(s_maku_debug_checker) : ImageView(maku.terrain_texture);
   terrain_instance.use_mesh_uv = true;
   terrain_instance.texture_wrap = true;
   terrain_instance.texture_unlit = state.debug_maku_no_fog;
   terrain_instance.enable_backface_culling = true;
-  renderer.DrawMesh(surface, maku.terrain, camera, terrain_instance);
+  {
+    FORWARD_PROFILE_ZONE("maku.terrain");
+    renderer.DrawMesh(surface, maku.terrain, camera, terrain_instance);
+  }
 
   if (!state.debug_maku_no_fog && runtime.flash_intensity > 0.0f) {
     const float w = std::clamp(runtime.flash_intensity / 256.0f, 0.0f, 1.0f);
@@ -4509,9 +4268,7 @@ void DrawMakuFrameAtTime(Surface32& surface,
         const uint8_t wb = static_cast<uint8_t>(std::clamp((b * 5 + 255 * 3) / 8, 0, 255));
         back[i] = PackArgb(wr, wg, wb);
       }
-      surface.AlphaBlitToBack(front,
-                              kLogicalWidth,
-                              kLogicalHeight,
+      surface.AlphaBlitToBack(surface.FrontView(),
                               0,
                               0,
                               0,
@@ -4572,8 +4329,7 @@ void InitializeWatercubeRuntime(const WatercubeSceneAssets& watercube, Watercube
   runtime.shock_amount = 0.0f;
   runtime.shock_decay = 0.0f;
   runtime.tex_strip_offset = 0;
-  runtime.next_script_event = 0;
-  runtime.last_order_row = -1;
+  runtime.script_cursor = MakeSceneScriptCursor(ScriptSymbol::kWatercube, false);
 
   runtime.flash_lut_10.assign(1000, 0u);
   for (uint32_t& c : runtime.flash_lut_10) {
@@ -4598,97 +4354,54 @@ void InitializeWatercubeRuntime(const WatercubeSceneAssets& watercube, Watercube
   runtime.initialized = true;
 }
 
-void ApplyWatercubeMessage(WatercubeRuntime& runtime, const std::string& message) {
-  if (message == "suh") {
-    runtime.flash_amount = 50.0f;
-    runtime.flash_decay = 200.0f;
-    return;
-  }
-  if (message == "suh0") {
-    runtime.flash_amount = 100.0f;
-    runtime.flash_decay = 150.0f;
-    return;
-  }
-  if (message == "suh1") {
-    runtime.flash_amount = 128.0f;
-    runtime.flash_decay = 120.0f;
-    return;
-  }
-  if (message == "suh2") {
-    runtime.flash_amount = 256.0f;
-    runtime.flash_decay = 90.0f;
-    return;
-  }
-  if (message == "rok") {
-    runtime.roll_impulse = 1.0f;
-    return;
-  }
-  if (message == "pum") {
-    runtime.shock_amount = 100.0f;
-    runtime.shock_decay = 130.0f;
-    return;
-  }
-  if (message == "tex0") {
-    runtime.tex_strip_offset = -80;
-    return;
-  }
-  if (message == "tex1") {
-    runtime.tex_strip_offset = -160;
-    return;
-  }
-  if (message == "tex2") {
-    runtime.tex_strip_offset = -240;
-    return;
-  }
-  if (message == "tex3") {
-    runtime.tex_strip_offset = -320;
+void ApplyWatercubeMessage(WatercubeRuntime& runtime, const ScriptEvent& event) {
+  switch (MessageSymbol(event)) {
+    case ScriptSymbol::kSuh:
+      runtime.flash_amount = 50.0f;
+      runtime.flash_decay = 200.0f;
+      break;
+    case ScriptSymbol::kSuh0:
+      runtime.flash_amount = 100.0f;
+      runtime.flash_decay = 150.0f;
+      break;
+    case ScriptSymbol::kSuh1:
+      runtime.flash_amount = 128.0f;
+      runtime.flash_decay = 120.0f;
+      break;
+    case ScriptSymbol::kSuh2:
+      runtime.flash_amount = 256.0f;
+      runtime.flash_decay = 90.0f;
+      break;
+    case ScriptSymbol::kRok:
+      runtime.roll_impulse = 1.0f;
+      break;
+    case ScriptSymbol::kPum:
+      runtime.shock_amount = 100.0f;
+      runtime.shock_decay = 130.0f;
+      break;
+    case ScriptSymbol::kTex0:
+      runtime.tex_strip_offset = -80;
+      break;
+    case ScriptSymbol::kTex1:
+      runtime.tex_strip_offset = -160;
+      break;
+    case ScriptSymbol::kTex2:
+      runtime.tex_strip_offset = -240;
+      break;
+    case ScriptSymbol::kTex3:
+      runtime.tex_strip_offset = -320;
+      break;
+    default:
+      break;
   }
 }
 
 void RunWatercubeScriptAtOrderRow(WatercubeRuntime& runtime, int order_row) {
-  if (order_row < 0) {
-    return;
-  }
-  struct WatercubeEvent {
-    int order_row;
-    const char* message;
-  };
-  static const std::array<WatercubeEvent, 18> kEvents = {{
-      {0x1004, "pum"},
-      {0x1008, "rok"},
-      {0x100C, "suh"},
-      {0x1030, "pum"},
-      {0x1100, "rok"},
-      {0x1100, "pum"},
-      {0x1110, "suh0"},
-      {0x1128, "suh0"},
-      {0x1130, "suh0"},
-      {0x1200, "suh1"},
-      {0x1200, "pum"},
-      {0x1200, "rok"},
-      {0x1210, "suh0"},
-      {0x1210, "tex0"},
-      {0x1220, "suh1"},
-      {0x1220, "tex1"},
-      {0x1230, "suh0"},
-      {0x1230, "tex2"},
-  }};
-
-  if (runtime.last_order_row < 0) {
-    runtime.last_order_row = order_row;
-  }
-
-  while (runtime.next_script_event < static_cast<int>(kEvents.size())) {
-    const WatercubeEvent& ev = kEvents[static_cast<size_t>(runtime.next_script_event)];
-    const bool reached = (order_row == ev.order_row) ||
-                         RowCrossed(runtime.last_order_row, order_row, ev.order_row);
-    if (!reached) {
-      break;
-    }
-    ApplyWatercubeMessage(runtime, ev.message);
-    ++runtime.next_script_event;
+  FORWARD_PROFILE_ZONE("script.watercube");
+  runtime.script_cursor.Advance(order_row);
+  while (const ScriptEvent* event = runtime.script_cursor.Next()) {
+    ApplyWatercubeMessage(runtime, *event);
   }
-  runtime.last_order_row = order_row;
 }
 
 void WatercubeInjectRing(WatercubeRuntime& runtime) {
@@ -4715,42 +4428,8 @@ void WatercubeInjectRing(WatercubeRuntime& runtime) {
   }
 }
 
-void WatercubeWaveStep(const std::vector<uint32_t>& src, std::vector<uint32_t>* dst, int width, int height) {
-  if (!dst || src.empty() || dst->empty() || width < 4 || height < 4) {
-    return;
-  }
-
-  const int n3_start = width * 2;
-  const int n4 = width + width;
-  const int n5 = static_cast<int>(legacy10::kCarryMask);
-  const int n6 = n4 - 2;
-  const int n7 = n4 + 2;
-  const int n8 = n4 + n4;
-
-  int n3 = n3_start;
-  for (int n9 = 2; n9 < height - 2; n9 += 2) {
-    int n10 = n3 - n4 + 1;
-    int n11 = n3 + 1;
-    for (int n12 = 1; n12 < width - 1; n12 += 2) {
-      const int n14 = static_cast<int>(src[static_cast<size_t>(n10)]) +
-                      static_cast<int>(src[static_cast<size_t>(n10 + n6)]) +
-                      static_cast<int>(src[static_cast<size_t>(n10 + n7)]) +
-                      static_cast<int>(src[static_cast<size_t>(n10 + n8)]);
-      const int n15 = static_cast<int>((*dst)[static_cast<size_t>(n11)]);
-      const int n16 = (n14 >> 1) + n5 - n15;
-      const int n17 = n16 & n5;
-      const int n13 = n16 & (n17 - (n17 >> 8));
-      (*dst)[static_cast<size_t>(n11 - width)] = static_cast<uint32_t>(n13);
-      (*dst)[static_cast<size_t>(n11 - width + 1)] = static_cast<uint32_t>(n13);
-      (*dst)[static_cast<size_t>(n11++)] = static_cast<uint32_t>(n13);
-      (*dst)[static_cast<size_t>(n11++)] = static_cast<uint32_t>(n13);
-      n10 += 2;
-    }
-    n3 += 2 * width;
-  }
-}
-
 void ApplyWatercubeFlashNoise(Surface32& surface, WatercubeRuntime& runtime, int amount_signed) {
+  FORWARD_PROFILE_ZONE("watercube.flash");
   if (amount_signed == 0 || runtime.flash_lut_10.empty() || runtime.flash_scanline_order.empty()) {
     return;
   }
@@ -4819,12 +4498,11 @@ void AdditiveBlitAdditiveMode49(Surface32& surface,
                                 const Camera& camera,
                                 const RenderInstance& instance,
                                 Renderer3D& renderer) {
+  FORWARD_PROFILE_ZONE("watercube.layer");
   layer_surface.ClearBack(PackArgb(0, 0, 0));
   renderer.DrawMesh(layer_surface, mesh, camera, instance);
   layer_surface.SwapBuffers();
-  surface.AdditiveBlitToBack(layer_surface.FrontPixels(),
-                             kLogicalWidth,
-                             kLogicalHeight,
+  surface.AdditiveBlitToBack(layer_surface.FrontView(),
                              0,
                              0,
                              0,
@@ -4863,14 +4541,13 @@ void ComposeWatercubePanelBuffer(WatercubeRuntime& runtime) {
 void ApplyWatercubeShockOverlay(Surface32& surface,
                                 const WatercubeSceneAssets& watercube,
                                 WatercubeRuntime& runtime) {
+  FORWARD_PROFILE_ZONE("watercube.shock");
   if (runtime.shock_amount <= 0.0f) {
     return;
   }
   const int n = -static_cast<int>(JavaRandomNextDoubleRaw(&runtime.java_random_state) * 384.0);
   const int n2 = -static_cast<int>(JavaRandomNextDoubleRaw(&runtime.java_random_state) * 352.0);
-  surface.AdditiveBlitToBack(watercube.scroll_texture.pixels.data(),
-                             watercube.scroll_texture.width,
-                             watercube.scroll_texture.height,
+  surface.AdditiveBlitToBack(watercube.scroll_texture,
                              0,
                              0,
                              n,
@@ -4878,9 +4555,7 @@ void ApplyWatercubeShockOverlay(Surface32& surface,
                              watercube.scroll_texture.width,
                              watercube.scroll_texture.height,
                              255);
-  surface.AdditiveBlitToBack(watercube.scroll_texture.pixels.data(),
-                             watercube.scroll_texture.width,
-                             watercube.scroll_texture.height,
+  surface.AdditiveBlitToBack(watercube.scroll_texture,
                              0,
                              0,
                              n + 640,
@@ -4888,9 +4563,7 @@ void ApplyWatercubeShockOverlay(Surface32& surface,
                              watercube.scroll_texture.width,
                              watercube.scroll_texture.height,
                              255);
-  surface.AdditiveBlitToBack(watercube.scroll_texture.pixels.data(),
-                             watercube.scroll_texture.width,
-                             watercube.scroll_texture.height,
+  surface.AdditiveBlitToBack(watercube.scroll_texture,
                              0,
                              0,
                              n + 640,
@@ -4898,9 +4571,7 @@ void ApplyWatercubeShockOverlay(Surface32& surface,
                              watercube.scroll_texture.width,
                              watercube.scroll_texture.height,
                              255);
-  surface.AdditiveBlitToBack(watercube.scroll_texture.pixels.data(),
-                             watercube.scroll_texture.width,
-                             watercube.scroll_texture.height,
+  surface.AdditiveBlitToBack(watercube.scroll_texture,
                              0,
                              0,
                              n,
@@ -4910,41 +4581,7 @@ void ApplyWatercubeShockOverlay(Surface32& surface,
                              255);
 }
 
-void DrawWatercubeFrameAtTime(Surface32& surface,
-                              Surface32& watercube_layer_surface,
-                              const DemoState& state,
-                              const WatercubeSceneAssets& watercube,
-                              WatercubeRuntime& runtime,
-                              Camera& camera,
-                              Renderer3D& renderer,
-                              RenderInstance& object_instance,
-                              double scene_seconds,
-                              bool trigger_script_messages) {
-  if (!watercube.enabled || watercube.animated_objects.empty() || watercube.scroll_texture.Empty() ||
-      watercube.box_texture.Empty() || watercube.panel_overlay.Empty() || watercube.ring_texture.Empty() ||
-      watercube.ripple_texture.Empty()) {
-    surface.ClearBack(PackArgb(0, 0, 0));
-    surface.SwapBuffers();
-    return;
-  }
-  if (!runtime.initialized) {
-    InitializeWatercubeRuntime(watercube, runtime);
-  }
-
-  const int order_row = (state.music_module_slot == 2) ? state.music_order_row : -1;
-  if (trigger_script_messages) {
-    RunWatercubeScriptAtOrderRow(runtime, order_row);
-  }
-
-  const float dt = static_cast<float>(std::clamp(state.frame_dt_seconds, 1.0 / 240.0, 0.1));
-  runtime.frame_counter += 1;
-  runtime.kluns1_rot_x += 0.02f;
-  runtime.kluns1_rot_z += 0.07f;
-  if (watercube.has_kluns2) {
-    runtime.kluns2_rot_x -= 0.02f;
-    runtime.kluns2_rot_z += 0.07f;
-  }
-
+void StepWatercubeRipple(WatercubeRuntime& runtime) {
   WatercubeInjectRing(runtime);
   if (runtime.source_is_b) {
     WatercubeWaveStep(runtime.ripple_b, &runtime.ripple_a, runtime.ripple_width, runtime.ripple_height);
@@ -4981,6 +4618,44 @@ void DrawWatercubeFrameAtTime(Surface32& surface,
   legacy10::ConvertBufferToArgb(runtime.ripple_combined.data(),
                                 runtime.water_dynamic_argb.pixels.data(),
                                 runtime.ripple_combined.size());
+}
+
+void DrawWatercubeFrameAtTime(Surface32& surface,
+                              Surface32& watercube_layer_surface,
+                              const DemoState& state,
+                              const WatercubeSceneAssets& watercube,
+                              WatercubeRuntime& runtime,
+                              Camera& camera,
+                              Renderer3D& renderer,
+                              RenderPassGraph& passes,
+                              RenderInstance& object_instance,
+                              double scene_seconds,
+                              bool trigger_script_messages) {
+  FORWARD_PROFILE_ZONE("watercube");
+  if (!watercube.enabled || watercube.animated_objects.empty() || watercube.scroll_texture.Empty() ||
+      watercube.box_texture.Empty() || watercube.panel_overlay.Empty() || watercube.ring_texture.Empty() ||
+      watercube.ripple_texture.Empty()) {
+    surface.ClearBack(PackArgb(0, 0, 0));
+    surface.SwapBuffers();
+    return;
+  }
+  if (!runtime.initialized) {
+    InitializeWatercubeRuntime(watercube, runtime);
+  }
+
+  const int order_row = (state.music_module_slot == 2) ? state.music_order_row : -1;
+  if (trigger_script_messages) {
+    RunWatercubeScriptAtOrderRow(runtime, order_row);
+  }
+
+  const float dt = static_cast<float>(std::clamp(state.frame_dt_seconds, 1.0 / 240.0, 0.1));
+  runtime.frame_counter += 1;
+  runtime.kluns1_rot_x += 0.02f;
+  runtime.kluns1_rot_z += 0.07f;
+  if (watercube.has_kluns2) {
+    runtime.kluns2_rot_x -= 0.02f;
+    runtime.kluns2_rot_z += 0.07f;
+  }
 
   const double t_eval_seconds = scene_seconds * 1.8 + 2.0;
   const double t_ms = t_eval_seconds * 1000.0;
@@ -4994,8 +4669,7 @@ void DrawWatercubeFrameAtTime(Surface32& surface,
   SetCameraLookAt(camera, cam_pos, cam_target, Vec3(0.0f, 0.0f, 1.0f));
   ApplyCameraRoll(camera, runtime.roll_impulse * 2.0f * kPi);
   camera.fov_degrees = watercube.camera_fov_degrees;
-
-  surface.ClearBack(PackArgb(0, 0, 0));
+  runtime.roll_impulse *= 0.917f;
 
   object_instance.uniform_scale = 1.0f;
   object_instance.fill_color = PackArgb(255, 255, 255);
@@ -5007,98 +4681,113 @@ void DrawWatercubeFrameAtTime(Surface32& surface,
   object_instance.texture_unlit = false;
   object_instance.enable_backface_culling = true;
 
-  for (const SaariSceneAssets::AnimatedObject& obj : watercube.animated_objects) {
-    if (obj.mesh.Empty()) {
-      continue;
-    }
-    Vec3 obj_pos = obj.base_position;
-    if (!obj.position_track.empty()) {
-      obj_pos = SampleSaariTrackAtMs(obj.position_track, t_ms);
-    }
-    Quat obj_rot = obj.base_rotation;
-    if (!obj.rotation_track.empty()) {
-      obj_rot = SampleSaariRotationTrackAtMs(obj.rotation_track, t_ms, obj.base_rotation);
-    }
-    object_instance.translation = obj_pos;
-    SetRenderInstanceBasisFromQuat(object_instance, obj_rot);
-    if (obj.name == "TriPatch01") {
-      object_instance.texture = &runtime.water_dynamic_argb;
-      object_instance.texture_unlit = true;
-      AdditiveBlitAdditiveMode49(surface, watercube_layer_surface, obj.mesh, camera, object_instance, renderer);
-    } else {
-      object_instance.texture = &watercube.box_texture;
-      object_instance.texture_unlit = false;
-      renderer.DrawMesh(surface, obj.mesh, camera, object_instance);
+  // The ripple step and the panel buffer share nothing with each other or
+  // with the meshes. The water patch comes first in the object list and the
+  // boxes paint over it, so the objects wait for the ripple.
+  passes.AddPass("watercube.ripple", {}, {&runtime.water_dynamic_argb}, [&](Renderer3D&) {
+    StepWatercubeRipple(runtime);
+  });
+  // The panel, flash noise and shock all draw from the scene's Java RNG; both
+  // passes list it as written so its draws keep their order.
+  passes.AddPass("watercube.panel",
+                 {},
+                 {&runtime.panel_dynamic_argb, &runtime.java_random_state},
+                 [&](Renderer3D&) { ComposeWatercubePanelBuffer(runtime); });
+  passes.AddPass("watercube.objects",
+                 {&runtime.water_dynamic_argb},
+                 {&surface, &watercube_layer_surface},
+                 [&](Renderer3D& context) {
+    surface.ClearBack(PackArgb(0, 0, 0));
+    for (const SaariSceneAssets::AnimatedObject& obj : watercube.animated_objects) {
+      if (obj.mesh.Empty()) {
+        continue;
+      }
+      FORWARD_PROFILE_ZONE("watercube.object");
+      Vec3 obj_pos = obj.base_position;
+      if (!obj.position_track.empty()) {
+        obj_pos = SampleSaariTrackAtMs(obj.position_track, t_ms);
+      }
+      Quat obj_rot = obj.base_rotation;
+      if (!obj.rotation_track.empty()) {
+        obj_rot = SampleSaariRotationTrackAtMs(obj.rotation_track, t_ms, obj.base_rotation);
+      }
+      object_instance.translation = obj_pos;
+      SetRenderInstanceBasisFromQuat(object_instance, obj_rot);
+      if (obj.name == "TriPatch01") {
+        object_instance.texture = runtime.water_dynamic_argb;
+        object_instance.texture_unlit = true;
+        AdditiveBlitAdditiveMode49(surface, watercube_layer_surface, obj.mesh, camera, object_instance, context);
+      } else {
+        object_instance.texture = watercube.box_texture;
+        object_instance.texture_unlit = false;
+        context.DrawMesh(surface, obj.mesh, camera, object_instance);
+      }
     }
-  }
 
-  object_instance.use_basis_rotation = false;
-  object_instance.uniform_scale = 0.45f;
-  object_instance.texture = &watercube.env_texture;
-  object_instance.texture_unlit = false;
-  if (!watercube.kluns1.Empty()) {
-    object_instance.translation = Vec3(0.0f, 0.0f, 20.0f);
-    object_instance.rotation_radians = Vec3(runtime.kluns1_rot_x, 0.0f, runtime.kluns1_rot_z);
-    renderer.DrawMesh(surface, watercube.kluns1, camera, object_instance);
-  }
-  if (watercube.has_kluns2 && !watercube.kluns2.Empty()) {
-    object_instance.translation = Vec3(0.0f, 0.0f, -20.0f);
-    object_instance.rotation_radians = Vec3(runtime.kluns2_rot_x, 0.0f, runtime.kluns2_rot_z);
-    renderer.DrawMesh(surface, watercube.kluns2, camera, object_instance);
-  }
-
-  ComposeWatercubePanelBuffer(runtime);
-  if (runtime.panel_scale == 2) {
-    surface.AdditiveBlitScaledToBack(runtime.panel_dynamic_argb.pixels.data(),
-                                     runtime.panel_dynamic_argb.width,
-                                     runtime.panel_dynamic_argb.height,
-                                     126 * runtime.panel_scale,
-                                     0,
-                                     128 * runtime.panel_scale,
-                                     128 * runtime.panel_scale,
-                                     255);
-  } else {
-    surface.AdditiveBlitScaledToBack(runtime.panel_dynamic_argb.pixels.data(),
-                                     runtime.panel_dynamic_argb.width,
-                                     runtime.panel_dynamic_argb.height,
-                                     126 * runtime.panel_scale,
-                                     0,
-                                     128,
-                                     128,
+    object_instance.use_basis_rotation = false;
+    object_instance.uniform_scale = 0.45f;
+    object_instance.texture = watercube.env_texture;
+    object_instance.texture_unlit = false;
+    if (!watercube.kluns1.Empty()) {
+      object_instance.translation = Vec3(0.0f, 0.0f, 20.0f);
+      object_instance.rotation_radians = Vec3(runtime.kluns1_rot_x, 0.0f, runtime.kluns1_rot_z);
+      FORWARD_PROFILE_ZONE("watercube.kluns1");
+      context.DrawMesh(surface, watercube.kluns1, camera, object_instance);
+    }
+    if (watercube.has_kluns2 && !watercube.kluns2.Empty()) {
+      object_instance.translation = Vec3(0.0f, 0.0f, -20.0f);
+      object_instance.rotation_radians = Vec3(runtime.kluns2_rot_x, 0.0f, runtime.kluns2_rot_z);
+      FORWARD_PROFILE_ZONE("watercube.kluns2");
+      context.DrawMesh(surface, watercube.kluns2, camera, object_instance);
+    }
+  });
+  passes.AddPass("watercube.overlay",
+                 {&runtime.panel_dynamic_argb},
+                 {&surface, &runtime.java_random_state},
+                 [&](Renderer3D&) {
+    if (runtime.panel_scale == 2) {
+      surface.AdditiveBlitScaledToBack(runtime.panel_dynamic_argb,
+                                       126 * runtime.panel_scale,
+                                       0,
+                                       128 * runtime.panel_scale,
+                                       128 * runtime.panel_scale,
+                                       255);
+    } else {
+      surface.AdditiveBlitScaledToBack(runtime.panel_dynamic_argb,
+                                       126 * runtime.panel_scale,
+                                       0,
+                                       128,
+                                       128,
+                                       255);
+    }
+
+    surface.AdditiveBlitScaledToBack(watercube.scroll_texture,
+                                     static_cast<int>(-scene_seconds * 135.0),
+                                     -260,
+                                     1280,
+                                     960,
                                      255);
-  }
-
-  surface.AdditiveBlitScaledToBack(watercube.scroll_texture.pixels.data(),
-                                   watercube.scroll_texture.width,
-                                   watercube.scroll_texture.height,
-                                   static_cast<int>(-scene_seconds * 135.0),
-                                   -260,
-                                   1280,
-                                   960,
-                                   255);
-  if (runtime.tex_strip_offset != 0) {
-    surface.AdditiveBlitToBack(watercube.scroll_texture.pixels.data(),
-                               watercube.scroll_texture.width,
-                               watercube.scroll_texture.height,
-                               0,
-                               0,
-                               -200,
-                               runtime.tex_strip_offset,
-                               watercube.scroll_texture.width,
-                               watercube.scroll_texture.height,
-                               255);
-  }
-
-  runtime.roll_impulse *= 0.917f;
-  if (runtime.flash_amount > 0.0f) {
-    ApplyWatercubeFlashNoise(surface, runtime, static_cast<int>(runtime.flash_amount));
-    runtime.flash_amount = std::max(0.0f, runtime.flash_amount - runtime.flash_decay * dt);
-  }
-  if (runtime.shock_amount > 0.0f) {
-    ApplyWatercubeShockOverlay(surface, watercube, runtime);
-    runtime.shock_amount = std::max(0.0f, runtime.shock_amount - runtime.shock_decay * dt);
-  }
+    if (runtime.tex_strip_offset != 0) {
+      surface.AdditiveBlitToBack(watercube.scroll_texture,
+                                 0,
+                                 0,
+                                 -200,
+                                 runtime.tex_strip_offset,
+                                 watercube.scroll_texture.width,
+                                 watercube.scroll_texture.height,
+                                 255);
+    }
 
+    if (runtime.flash_amount > 0.0f) {
+      ApplyWatercubeFlashNoise(surface, runtime, static_cast<int>(runtime.flash_amount));
+      runtime.flash_amount = std::max(0.0f, runtime.flash_amount - runtime.flash_decay * dt);
+    }
+    if (runtime.shock_amount > 0.0f) {
+      ApplyWatercubeShockOverlay(surface, watercube, runtime);
+      runtime.shock_amount = std::max(0.0f, runtime.shock_amount - runtime.shock_decay * dt);
+    }
+  });
+  passes.Execute(renderer);
   surface.SwapBuffers();
 }
 
@@ -5108,17 +4797,20 @@ void DrawWatercubeFrameAtTime(Surface32& surface,
                               WatercubeRuntime& runtime,
                               Camera& camera,
                               Renderer3D& renderer,
+                              RenderTargetPool& targets,
+                              RenderPassGraph& passes,
                               RenderInstance& object_instance,
                               double scene_seconds,
                               bool trigger_script_messages) {
-  static Surface32 watercube_layer_surface(kLogicalWidth, kLogicalHeight, true);
+  const RenderTargetPool::Lease layer = targets.Acquire(kLogicalWidth, kLogicalHeight);
   DrawWatercubeFrameAtTime(surface,
-                           watercube_layer_surface,
+                           *layer,
                            state,
                            watercube,
                            runtime,
                            camera,
                            renderer,
+                           passes,
                            object_instance,
                            scene_seconds,
                            trigger_script_messages);
@@ -5153,6 +4845,7 @@ void InitializeMmaamkaParticles(MmaamkaParticlePass& pass, int count, double tim
 }
 
 void StepMmaamkaParticles(MmaamkaParticlePass& pass, double timeline_seconds) {
+  FORWARD_PROFILE_ZONE("feta.particles.step");
   if (!pass.enabled || pass.flare.Empty()) {
     return;
   }
@@ -5195,6 +4888,7 @@ void DrawMmaamkaParticles(Surface32& surface,
                           const Camera& camera,
                           const MmaamkaParticlePass& pass,
                           double timeline_seconds) {
+  FORWARD_PROFILE_ZONE("feta.particles");
   if (!pass.enabled || pass.flare.Empty()) {
     return;
   }
@@ -5224,9 +4918,7 @@ void DrawMmaamkaParticles(Surface32& surface,
 
     const int dst_x = sx - sprite_size / 2;
     const int dst_y = sy - sprite_size / 2;
-    surface.AdditiveBlitScaledToBack(pass.flare.pixels.data(),
-                                     pass.flare.width,
-                                     pass.flare.height,
+    surface.AdditiveBlitScaledToBack(pass.flare,
                                      dst_x,
                                      dst_y,
                                      sprite_size,
@@ -5266,65 +4958,36 @@ void InitializeFetaRuntime(FetaRuntime& runtime) {
   runtime.current_indices_a = true;
   runtime.blackfeta_start_seconds = 0.0;
   runtime.blackmuna_start_seconds = 0.0;
-  runtime.last_order_row = -1;
-  runtime.next_script_event = 0;
+  runtime.script_cursor = MakeSceneScriptCursor(ScriptSymbol::kFeta, true);
   SetFetaPalette(runtime, true);
   runtime.initialized = true;
 }
 
-void ApplyFetaMessage(FetaRuntime& runtime, const std::string& message, double scene_seconds) {
-  if (message == "1") {
-    SetFetaPalette(runtime, true);
-    return;
-  }
-  if (message == "2") {
-    SetFetaPalette(runtime, false);
-    return;
-  }
-  if (message == "blackfeta") {
-    runtime.blackfeta_start_seconds = scene_seconds;
-    return;
-  }
-  if (message == "blackmuna") {
-    runtime.blackmuna_start_seconds = scene_seconds;
+void ApplyFetaMessage(FetaRuntime& runtime, const ScriptEvent& event, double scene_seconds) {
+  switch (MessageSymbol(event)) {
+    case ScriptSymbol::kPalette1:
+      SetFetaPalette(runtime, true);
+      break;
+    case ScriptSymbol::kPalette2:
+      SetFetaPalette(runtime, false);
+      break;
+    case ScriptSymbol::kBlackfeta:
+      runtime.blackfeta_start_seconds = scene_seconds;
+      break;
+    case ScriptSymbol::kBlackmuna:
+      runtime.blackmuna_start_seconds = scene_seconds;
+      break;
+    default:
+      break;
   }
 }
 
 void RunFetaScriptAtOrderRow(FetaRuntime& runtime, int order_row, double scene_seconds) {
-  if (order_row < 0) {
-    return;
+  FORWARD_PROFILE_ZONE("script.feta");
+  runtime.script_cursor.Advance(order_row);
+  while (const ScriptEvent* event = runtime.script_cursor.Next()) {
+    ApplyFetaMessage(runtime, *event, scene_seconds);
   }
-  struct FetaEvent {
-    int order_row;
-    const char* message;
-  };
-  static const std::array<FetaEvent, 3> kEvents = {{
-      {0x1230, "1"},
-      {0x1520, "blackfeta"},
-      {0x1530, "blackmuna"},
-  }};
-
-  const int previous_row = runtime.last_order_row;
-  if (runtime.last_order_row < 0) {
-    runtime.last_order_row = order_row;
-  }
-
-  while (runtime.next_script_event < static_cast<int>(kEvents.size())) {
-    const FetaEvent& ev = kEvents[static_cast<size_t>(runtime.next_script_event)];
-    bool reached = false;
-    if (previous_row < 0) {
-      reached = order_row >= ev.order_row;
-    } else {
-      reached = (order_row == ev.order_row) ||
-                RowCrossed(runtime.last_order_row, order_row, ev.order_row);
-    }
-    if (!reached) {
-      break;
-    }
-    ApplyFetaMessage(runtime, ev.message, scene_seconds);
-    ++runtime.next_script_event;
-  }
-  runtime.last_order_row = order_row;
 }
 
 void BuildFetaMeshMask(Surface32& mask_surface,
@@ -5335,7 +4998,7 @@ void BuildFetaMeshMask(Surface32& mask_surface,
                        FetaRuntime& runtime) {
   mask_surface.ClearBack(PackArgb(0, 0, 0));
   RenderInstance mask_instance = mesh_instance;
-  mask_instance.texture = nullptr;
+  mask_instance.texture = {};
   mask_instance.use_mesh_uv = false;
   mask_instance.texture_wrap = false;
   mask_instance.texture_unlit = true;
@@ -5355,83 +5018,27 @@ void BuildFetaMeshMask(Surface32& mask_surface,
 void ApplyFetaIndexedPostComposite(Surface32& surface,
                                    FetaRuntime& runtime,
                                    double scene_seconds) {
+  FORWARD_PROFILE_ZONE("feta.composite");
   uint32_t* back = surface.BackPixelsMutable();
   if (!back) {
     return;
   }
-
-  const size_t pixel_count = static_cast<size_t>(kLogicalWidth) * static_cast<size_t>(kLogicalHeight);
-  for (size_t i = 0; i < pixel_count; ++i) {
-    const uint32_t c = back[i];
-    runtime.packed_frame[i] = legacy10::PackRgb8To10(static_cast<uint8_t>((c >> 16u) & 0xFFu),
-                                                      static_cast<uint8_t>((c >> 8u) & 0xFFu),
-                                                      static_cast<uint8_t>(c & 0xFFu));
-  }
-
   const std::vector<uint8_t>& src =
       runtime.current_indices_a ? runtime.indices_a : runtime.indices_b;
   std::vector<uint8_t>& dst =
       runtime.current_indices_a ? runtime.indices_b : runtime.indices_a;
-
-  const double scale = 1.0 / 1.100000023841858;
-  const int n26 = static_cast<int>(scale * 65536.0);
-  const int n27 = 0;
-  const int n28 = 0;
-  const int n29 = static_cast<int>(scale * 65536.0);
-  const int cx = kLogicalWidth / 2;
-  const int cy = kLogicalHeight / 2;
-  int row_u = static_cast<int>((-(cx * scale) * 65536.0) + (cx * 65536.0));
-  int row_v = static_cast<int>((-(cy * scale) * 65536.0) + (cy * 65536.0));
-
-  const bool masked_mode = runtime.blackfeta_start_seconds == 0.0;
-  int dst_index = 0;
-  for (int y = 0; y < kLogicalHeight; ++y) {
-    int u = row_u;
-    int v = row_v;
-    for (int x = 0; x < kLogicalWidth; ++x) {
-      (void)x;
-      if (masked_mode && runtime.mesh_mask[static_cast<size_t>(dst_index)] != 0u) {
-        dst[static_cast<size_t>(dst_index)] = 255u;
-      } else {
-        const int sx = (u >> 16) & 0x1FF;
-        const int sy = (v >> 16) & 0x0FF;
-        const uint8_t idx =
-            static_cast<uint8_t>(src[static_cast<size_t>((sy << 9) | sx)] >> 1u);
-        dst[static_cast<size_t>(dst_index)] = idx;
-        if (idx != 0u) {
-          runtime.packed_frame[static_cast<size_t>(dst_index)] = legacy10::AddSaturating(
-              runtime.packed_frame[static_cast<size_t>(dst_index)],
-              runtime.palette_packed10[static_cast<size_t>(idx)]);
-        }
-      }
-      ++dst_index;
-      u += n26;
-      v += n27;
-    }
-    row_u += n28;
-    row_v += n29;
-  }
+  forward::core::ApplyFetaIndexedComposite(back,
+                                           kLogicalWidth,
+                                           kLogicalHeight,
+                                           src.data(),
+                                           dst.data(),
+                                           runtime.mesh_mask.data(),
+                                           runtime.palette_packed10,
+                                           runtime.packed_frame.data(),
+                                           runtime.blackfeta_start_seconds,
+                                           runtime.blackmuna_start_seconds,
+                                           scene_seconds);
   runtime.current_indices_a = !runtime.current_indices_a;
-
-  if (runtime.blackfeta_start_seconds != 0.0) {
-    int n = static_cast<int>(std::min(255.0, std::max(0.0, (scene_seconds - runtime.blackfeta_start_seconds) *
-                                                                0.7 * 255.0)));
-    int n2 = 0;
-    if (runtime.blackmuna_start_seconds != 0.0) {
-      n2 = static_cast<int>(std::min(
-          255.0, std::max(0.0, (scene_seconds - runtime.blackmuna_start_seconds) * 0.4 * 255.0)));
-    }
-    const uint32_t dark_feta = legacy10::PackColor24To10(static_cast<uint32_t>(n * 65793));
-    const uint32_t dark_muna = legacy10::PackColor24To10(static_cast<uint32_t>(n2 * 65793));
-    for (size_t i = 0; i < pixel_count; ++i) {
-      const uint32_t dark = (runtime.mesh_mask[i] != 0u) ? dark_feta : dark_muna;
-      runtime.packed_frame[i] = legacy10::SubSaturating(runtime.packed_frame[i], dark);
-    }
-  }
-
-  for (size_t i = 0; i < pixel_count; ++i) {
-    back[i] = legacy10::Unpack10ToArgb(runtime.packed_frame[i]);
-  }
 }
 
 void DrawFetaFrame(Surface32& surface,
@@ -5442,18 +5049,18 @@ void DrawFetaFrame(Surface32& surface,
                    FetaRuntime& feta_runtime,
                    Camera& camera,
                    Renderer3D& renderer,
+                   RenderTargetPool& targets,
+                   RenderPassGraph& passes,
                    RenderInstance& mesh_instance,
                    RenderInstance& halo_instance,
                    RenderInstance& background_instance,
-                   Surface32& halo_surface,
                    const FetaSceneAssets& feta,
                    const QuickWinPostLayer& post) {
+  FORWARD_PROFILE_ZONE("feta");
   if (!feta_runtime.initialized) {
     InitializeFetaRuntime(feta_runtime);
   }
 
-  surface.ClearBack(PackArgb(2, 3, 8));
-
   const float t = static_cast<float>(state.timeline_seconds);
   const double scene_seconds = std::max(0.0, state.timeline_seconds - state.scene_start_seconds);
 
@@ -5464,55 +5071,81 @@ void DrawFetaFrame(Surface32& surface,
   camera.fov_degrees = state.feta_fov_degrees;
 
   ConfigureFetaInstance(mesh_instance, feta, t);
-
   if (background.enabled) {
     ConfigureKaaakmaBackgroundInstance(background_instance, background, camera, t);
-    renderer.DrawMesh(surface, background.mesh, camera, background_instance);
   }
 
+  struct HaloPass {
+    float scale;
+    uint8_t intensity;
+    uint32_t tint;
+  };
+  static const std::array<HaloPass, 3> kHaloPasses = {
+      HaloPass{1.025f, 150, PackArgb(90, 255, 120)},
+      HaloPass{1.055f, 100, PackArgb(120, 255, 145)},
+      HaloPass{1.090f, 50, PackArgb(165, 255, 185)},
+  };
+  // Each shell has its own target so the three render concurrently; the
+  // saturating adds that composite them do not depend on order. Added at
+  // 50-150 of 255, the shells can render at reduced size and be stretched back.
+  const int halo_downscale = LayerDownscale(state);
+  std::array<RenderInstance, kHaloPasses.size()> halo_instances;
+  std::array<RenderTargetPool::Lease, kHaloPasses.size()> halos;
   if (feta.enabled) {
-    struct HaloPass {
-      float scale;
-      uint8_t intensity;
-      uint32_t tint;
-    };
-    static const std::array<HaloPass, 3> kHaloPasses = {
-        HaloPass{1.025f, 150, PackArgb(90, 255, 120)},
-        HaloPass{1.055f, 100, PackArgb(120, 255, 145)},
-        HaloPass{1.090f, 50, PackArgb(165, 255, 185)},
-    };
-
-    for (const HaloPass& pass : kHaloPasses) {
-      halo_surface.ClearBack(PackArgb(0, 0, 0));
+    for (size_t i = 0; i < kHaloPasses.size(); ++i) {
       halo_instance.uniform_scale = mesh_instance.uniform_scale;
-      ConfigureFetaHaloInstance(halo_instance, feta, t, pass.scale, pass.tint);
-      renderer.DrawMesh(halo_surface, mesh, camera, halo_instance);
-      halo_surface.SwapBuffers();
-      surface.AdditiveBlitToBack(halo_surface.FrontPixels(),
-                                 kLogicalWidth,
-                                 kLogicalHeight,
-                                 0,
-                                 0,
-                                 0,
-                                 0,
-                                 kLogicalWidth,
-                                 kLogicalHeight,
-                                 pass.intensity);
-    }
-  }
-
-  renderer.DrawMesh(surface, mesh, camera, mesh_instance);
-
-  StepMmaamkaParticles(particles, state.timeline_seconds);
-  DrawMmaamkaParticles(surface, camera, particles, state.timeline_seconds);
-
-  static Surface32 feta_mask_surface(kLogicalWidth, kLogicalHeight, true);
-  BuildFetaMeshMask(feta_mask_surface, mesh, camera, renderer, mesh_instance, feta_runtime);
-  ApplyFetaIndexedPostComposite(surface, feta_runtime, scene_seconds);
-
-  DrawQuickWinPostLayer(surface, state, post);
-  surface.SwapBuffers();
-}
+      ConfigureFetaHaloInstance(
+          halo_instance, feta, t, kHaloPasses[i].scale, kHaloPasses[i].tint);
+      halo_instances[i] = halo_instance;
+      halos[i] = targets.Acquire(kLogicalWidth / halo_downscale, kLogicalHeight / halo_downscale);
+      Surface32* halo_surface = halos[i].get();
+      const RenderInstance* instance = &halo_instances[i];
+      passes.AddPass("feta.halo", {}, {halo_surface},
+                     [halo_surface, instance, &mesh, &camera](Renderer3D& context) {
+                       halo_surface->ClearBack(PackArgb(0, 0, 0));
+                       context.DrawMesh(*halo_surface, mesh, camera, *instance);
+                       halo_surface->SwapBuffers();
+                     });
+    }
+  }
+
+  const RenderTargetPool::Lease feta_mask = targets.Acquire(kLogicalWidth, kLogicalHeight);
+  passes.AddPass("feta.mask", {}, {feta_mask.get(), &feta_runtime.mesh_mask},
+                 [&](Renderer3D& context) {
+                   BuildFetaMeshMask(
+                       *feta_mask, mesh, camera, context, mesh_instance, feta_runtime);
+                 });
+  passes.AddPass("feta.background", {}, {&surface}, [&](Renderer3D& context) {
+    surface.ClearBack(PackArgb(2, 3, 8));
+    if (background.enabled) {
+      context.DrawMesh(surface, background.mesh, camera, background_instance);
+    }
+  });
+  passes.AddPass("feta.mesh",
+                 {halos[0].get(), halos[1].get(), halos[2].get()},
+                 {&surface, &particles},
+                 [&](Renderer3D& context) {
+                   for (size_t i = 0; i < halos.size(); ++i) {
+                     if (halos[i].get()) {
+                       surface.AdditiveBlitScaledToBack(halos[i]->FrontView(),
+                                                        0,
+                                                        0,
+                                                        kLogicalWidth,
+                                                        kLogicalHeight,
+                                                        kHaloPasses[i].intensity);
+                     }
+                   }
+                   context.DrawMesh(surface, mesh, camera, mesh_instance);
+                   StepMmaamkaParticles(particles, state.timeline_seconds);
+                   DrawMmaamkaParticles(surface, camera, particles, state.timeline_seconds);
+                 });
+  passes.AddPass("feta.post", {&feta_runtime.mesh_mask}, {&surface}, [&](Renderer3D&) {
+    ApplyFetaIndexedPostComposite(surface, feta_runtime, scene_seconds);
+    DrawQuickWinPostLayer(surface, state, post);
+  });
+  passes.Execute(renderer);
+  surface.SwapBuffers();
+}
 
 void DrawMute95DominaSequenceFrame(Surface32& surface,
                                    const DemoState& state,
@@ -5530,6 +5163,9 @@ void DrawMute95DominaSequenceFrame(Surface32& surface,
                                    WatercubeRuntime& watercube_runtime,
                                    Camera& camera,
                                    Renderer3D& renderer,
+                                   FrameArena& arena,
+                                   RenderTargetPool& targets,
+                                   RenderPassGraph& passes,
                                    RenderInstance& saari_backdrop_instance,
                                    RenderInstance& saari_terrain_instance,
                                    RenderInstance& saari_object_instance,
@@ -5553,6 +5189,7 @@ void DrawMute95DominaSequenceFrame(Surface32& surface,
                          kukot_runtime,
                          camera,
                          renderer,
+                         arena,
                          saari_object_instance,
                          sequence_seconds,
                          true);
@@ -5577,6 +5214,8 @@ void DrawMute95DominaSequenceFrame(Surface32& surface,
                              watercube_runtime,
                              camera,
                              renderer,
+                             targets,
+                             passes,
                              watercube_object_instance,
                              sequence_seconds,
                              true);
@@ -5587,6 +5226,10 @@ void DrawMute95DominaSequenceFrame(Surface32& surface,
                        saari_runtime,
                        camera,
                        renderer,
+                       arena,
+                       targets,
+                       passes,
+                       LayerDownscale(state),
                        saari_backdrop_instance,
                        saari_terrain_instance,
                        saari_object_instance,
@@ -5617,6 +5260,9 @@ void DrawFrame(Surface32& surface,
                FetaRuntime& feta_runtime,
                Camera& camera,
                Renderer3D& renderer,
+               FrameArena& arena,
+               RenderTargetPool& targets,
+               RenderPassGraph& passes,
                RenderInstance& mesh_instance,
                RenderInstance& halo_instance,
                RenderInstance& background_instance,
@@ -5624,9 +5270,9 @@ void DrawFrame(Surface32& surface,
                RenderInstance& saari_terrain_instance,
                RenderInstance& saari_object_instance,
                RenderInstance& watercube_object_instance,
-               Surface32& halo_surface,
                const FetaSceneAssets& feta,
                const QuickWinPostLayer& post) {
+  FORWARD_PROFILE_ZONE("DrawFrame");
   if (state.scene_mode == SceneMode::kMute95) {
     DrawMute95Frame(surface, state, mute95_assets, mute95_runtime);
     return;
@@ -5642,6 +5288,9 @@ void DrawFrame(Surface32& surface,
                    saari_runtime,
                    camera,
                    renderer,
+                   arena,
+                   targets,
+                   passes,
                    saari_backdrop_instance,
                    saari_terrain_instance,
                    saari_object_instance);
@@ -5681,6 +5330,9 @@ void DrawFrame(Surface32& surface,
                                   watercube_runtime,
                                   camera,
                                   renderer,
+                                  arena,
+                                  targets,
+                                  passes,
                                   saari_backdrop_instance,
                                   saari_terrain_instance,
                                   saari_object_instance,
@@ -5696,22 +5348,814 @@ void DrawFrame(Surface32& surface,
                 feta_runtime,
                 camera,
                 renderer,
+                targets,
+                passes,
                 mesh_instance,
                 halo_instance,
                 background_instance,
-                halo_surface,
                 feta,
                 post);
 }
 
+// Per-scene loaders register their decode/parse work on a task graph so they can
+// run both in the startup graph and later on their own when a stage is streamed back in.
+void AddMute95LoadTasks(forward::core::TaskGraph& graph, Mute95SceneAssets* mute95) {
+  using TaskId = forward::core::TaskGraph::TaskId;
+  static const std::array<std::pair<const char*, const char*>, 5> kCreditFiles = {{
+      {"images/kosmos/sav1.jpg", "images/kosmos/sav2.jpg"},
+      {"images/kosmos/jmag1.jpg", "images/kosmos/jmag2.jpg"},
+      {"images/kosmos/jugi1.jpg", "images/kosmos/jugi2.jpg"},
+      {"images/kosmos/anis1.jpg", "images/kosmos/anis2.jpg"},
+      {"images/kosmos/car1.jpg", "images/kosmos/car2.jpg"},
+  }};
+
+  std::vector<TaskId> mute95_tasks;
+  for (size_t i = 0; i < kCreditFiles.size(); ++i) {
+    Image32* first = &mute95->credits[i].first;
+    Image32* second = &mute95->credits[i].second;
+    mute95_tasks.push_back(graph.AddTask(kCreditFiles[i].first, [first, path = kCreditFiles[i].first] {
+      std::string image_error;
+      if (!LoadForwardImage(path, first, &image_error)) {
+        std::cerr << "mute95 credit load failed: " + image_error + "\n";
+      }
+    }));
+    mute95_tasks.push_back(graph.AddTask(kCreditFiles[i].second, [second, path = kCreditFiles[i].second] {
+      std::string image_error;
+      if (!LoadForwardImage(path, second, &image_error)) {
+        std::cerr << "mute95 credit load failed: " + image_error + "\n";
+      }
+    }));
+  }
+
+  mute95_tasks.push_back(graph.AddTask("mute95 palette", [mute95] {
+    const std::string palette_path = ResolveForwardAssetPath("images/kosmos/krad3.gif");
+    mute95->has_palette = !palette_path.empty() && LoadGifGlobalPalette(palette_path, &mute95->palette);
+    if (!mute95->has_palette) {
+      std::cerr << "mute95 palette load failed: unable to parse GIF global palette\n";
+    }
+  }));
+
+  graph.AddTask("mute95 finalize", [mute95] {
+    bool all_credits_loaded = true;
+    for (const auto& pair : mute95->credits) {
+      all_credits_loaded = all_credits_loaded && !pair.first.Empty() && !pair.second.Empty();
+    }
+    mute95->enabled = all_credits_loaded && mute95->has_palette;
+  }, mute95_tasks);
+}
+
+void AddSaariLoadTasks(forward::core::TaskGraph& graph, SaariSceneAssets* saari) {
+  using TaskId = forward::core::TaskGraph::TaskId;
+  // Terrain and sea are derived from the heightmap together, so they share one cache entry.
+  const TaskId terrain_task = graph.AddTask("saari terrain", [saari] {
+    const std::string height_path = ResolveForwardAssetPath("images/scape/saarih15.gif");
+    const bool ok = LoadThroughAssetCache(
+        "saari-terrain",
+        height_path,
+        0,
+        [saari](forward::core::AssetCacheReader& reader) {
+          return reader.ReadMesh(&saari->terrain) && reader.ReadMesh(&saari->sea);
+        },
+        [saari] {
+          std::string image_error;
+          Image32 saari_height;
+          if (!LoadForwardImage("images/scape/saarih15.gif", &saari_height, &image_error)) {
+            std::cerr << "saari heightmap load failed: " + image_error + "\n";
+            return false;
+          }
+          if (!BuildSaariTerrainMeshFromHeightmap(saari_height, &saari->terrain)) {
+            std::cerr << "saari terrain mesh build failed\n";
+            return false;
+          }
+          if (!BuildSaariSeaMeshFromTerrain(saari->terrain, &saari->sea)) {
+            std::cerr << "saari sea mesh build failed\n";
+            return false;
+          }
+          return true;
+        },
+        [saari](forward::core::AssetCacheWriter& writer) {
+          writer.WriteMesh(saari->terrain);
+          writer.WriteMesh(saari->sea);
+        });
+    if (!ok) {
+      saari->terrain.Clear();
+      saari->sea.Clear();
+    }
+  });
+
+  const TaskId texture_task = graph.AddTask("saari texture", [saari] {
+    std::string image_error;
+    if (!LoadForwardImage("images/scape/saari.gif", &saari->scape_image, &image_error)) {
+      std::cerr << "saari texture load failed: " + image_error + "\n";
+      return;
+    }
+    const ImageView scape(saari->scape_image);
+    saari->terrain_texture = scape.TopHalf();
+    saari->water_texture = scape.BottomHalf();
+    if (saari->terrain_texture.Empty()) {
+      saari->terrain_texture = scape;
+    }
+    if (saari->water_texture.Empty()) {
+      saari->water_texture = saari->terrain_texture;
+    }
+  });
+  const TaskId backdrop_task = graph.AddTask("saari backdrop", [saari] {
+    std::string image_error;
+    if (!LoadForwardImage("images/verax/tai1sp.jpg", &saari->backdrop_image, &image_error)) {
+      std::cerr << "saari backdrop load failed: " + image_error + "\n";
+      return;
+    }
+    saari->backdrop_texture = ImageView(saari->backdrop_image).SubRect(0, 0, 256, 256);
+  });
+
+  auto backdrop_mesh_ok = std::make_shared<bool>(false);
+  const TaskId backdrop_mesh_task = graph.AddTask("saari half8", [saari, backdrop_mesh_ok] {
+    std::string error;
+    const std::string half8_path = ResolveForwardAssetPath("meshes/half8.igu");
+    if (!half8_path.empty() &&
+        LoadIguMeshCached(half8_path, saari->backdrop_mesh, &error) &&
+        !saari->backdrop_mesh.Empty()) {
+      // Java kaaakma constructor mirrors sky U coordinates (u = 1 - u).
+      FlipMeshUvU(&saari->backdrop_mesh);
+      const float r = saari->backdrop_mesh.BoundingRadius();
+      saari->backdrop_scale = (r > 0.001f) ? (10000.0f / r) : 10000.0f;
+      *backdrop_mesh_ok = true;
+    } else {
+      std::cerr << "saari backdrop mesh load failed\n";
+    }
+  });
+
+  const std::string saari_ase_path = ResolveForwardAssetPath("asses/alku6.ase");
+  const TaskId ase_task = graph.AddTask("alku6 ase", [saari, saari_ase_path] {
+    static const std::vector<std::string> kSaariObjectNames = {"meditate", "klunssi"};
+    AseSceneData ase;
+    if (saari_ase_path.empty() || !LoadAseSceneCached(saari_ase_path, &kSaariObjectNames, &ase)) {
+      std::cerr << "saari ASE load failed\n";
+      return;
+    }
+    if (ase.has_camera_fov) {
+      saari->camera_fov_degrees = ase.camera_fov_degrees;
+    }
+    if (!ase.HasCameraTracks()) {
+      std::cerr << "saari camera tracks parse failed\n";
+    }
+    saari->camera_track = std::move(ase.camera_track);
+    saari->target_track = std::move(ase.target_track);
+    saari->animated_objects = std::move(ase.animated_objects);
+    if (saari->animated_objects.empty()) {
+      std::cerr << "saari ASE object parse failed\n";
+    } else {
+      std::cerr << "saari ASE objects loaded: " + std::to_string(saari->animated_objects.size()) +
+                       "\n";
+    }
+  });
+
+  graph.AddTask("saari finalize", [saari, backdrop_mesh_ok] {
+    saari->enabled = !saari->terrain.Empty() && !saari->sea.Empty() &&
+                     !saari->terrain_texture.Empty() && !saari->water_texture.Empty() &&
+                     !saari->backdrop_texture.Empty() && *backdrop_mesh_ok;
+  }, {terrain_task, texture_task, backdrop_task, backdrop_mesh_task, ase_task});
+}
+
+void AddKukotLoadTasks(forward::core::TaskGraph& graph, KukotSceneAssets* kukot) {
+  using TaskId = forward::core::TaskGraph::TaskId;
+  const TaskId env_task = graph.AddTask("kukot env", [kukot] {
+    const std::string envplane_path = ResolveForwardAssetPath("images/envplane.gif");
+    const bool ok = !envplane_path.empty() && LoadThroughAssetCache(
+        "kukot-env",
+        envplane_path,
+        0,
+        [kukot](forward::core::AssetCacheReader& reader) {
+          return reader.ReadImage(&kukot->object_texture);
+        },
+        [kukot, &envplane_path] {
+          std::array<uint32_t, 256> env_palette{};
+          bool has_env_palette = LoadGifGlobalPalette(envplane_path, &env_palette);
+          if (!has_env_palette) {
+            std::string image_error;
+            Image32 envplane_image;
+            if (LoadForwardImage("images/envplane.gif", &envplane_image, &image_error) &&
+                !envplane_image.Empty()) {
+              const int y = 0;
+              for (int i = 0; i < 256; ++i) {
+                const int x = (i * std::max(1, envplane_image.width - 1)) / 255;
+                env_palette[static_cast<size_t>(i)] =
+                    envplane_image.pixels[static_cast<size_t>(y) *
+                                              static_cast<size_t>(envplane_image.width) +
+                                          static_cast<size_t>(x)];
+              }
+              has_env_palette = true;
+            }
+          }
+          if (has_env_palette) {
+            kukot->object_texture = BuildKukotEnvTextureFromPalette(env_palette, 48.0f, 192.0f, 80.0f);
+          }
+          return has_env_palette;
+        },
+        [kukot](forward::core::AssetCacheWriter& writer) { writer.WriteImage(kukot->object_texture); });
+    if (!ok) {
+      std::cerr << "kukot envplane load failed\n";
+    }
+  });
+  const TaskId tile_task = graph.AddTask("kukot tile", [kukot] {
+    constexpr uint32_t kTileSeed = 0x06C0FFEEu;
+    LoadThroughAssetCache(
+        "kukot-tile",
+        std::string(),
+        kTileSeed,
+        [kukot](forward::core::AssetCacheReader& reader) { return reader.ReadImage(&kukot->random_tile); },
+        [kukot] {
+          kukot->random_tile = BuildKukotRandomTile(kTileSeed);
+          return true;
+        },
+        [kukot](forward::core::AssetCacheWriter& writer) { writer.WriteImage(kukot->random_tile); });
+  });
+  const TaskId flare_task = graph.AddTask("kukot flare", [kukot] {
+    std::string image_error;
+    if (!LoadForwardImage("images/flare1.jpg", &kukot->flare, &image_error)) {
+      std::cerr << "kukot flare load failed: " + image_error + "\n";
+    }
+  });
+
+  auto tracks_ok = std::make_shared<bool>(false);
+  auto objects_ok = std::make_shared<bool>(false);
+  const std::string kukot_ase_path = ResolveForwardAssetPath("asses/under1.ase");
+  const TaskId ase_task = graph.AddTask("under1 ase", [kukot, kukot_ase_path, tracks_ok, objects_ok] {
+    static const std::vector<std::string> kKukotObjectNames = {"kellu", "kellu01", "kellu02"};
+    AseSceneData ase;
+    const bool loaded =
+        !kukot_ase_path.empty() && LoadAseSceneCached(kukot_ase_path, &kKukotObjectNames, &ase);
+    if (ase.has_camera_fov) {
+      kukot->camera_fov_degrees = ase.camera_fov_degrees;
+    }
+    *tracks_ok = loaded && ase.HasCameraTracks();
+    *objects_ok = loaded && !ase.animated_objects.empty();
+    kukot->camera_track = std::move(ase.camera_track);
+    kukot->target_track = std::move(ase.target_track);
+    kukot->animated_objects = std::move(ase.animated_objects);
+    if (!*tracks_ok) {
+      std::cerr << "kukot camera tracks parse failed\n";
+    }
+    if (!*objects_ok) {
+      std::cerr << "kukot ASE object parse failed\n";
+    } else {
+      std::cerr << "kukot ASE objects loaded: " + std::to_string(kukot->animated_objects.size()) +
+                       "\n";
+    }
+  });
+
+  graph.AddTask("kukot finalize", [kukot, tracks_ok, objects_ok] {
+    kukot->enabled = !kukot->object_texture.Empty() && !kukot->random_tile.Empty() &&
+                     !kukot->flare.Empty() && *tracks_ok && *objects_ok;
+  }, {env_task, tile_task, flare_task, ase_task});
+}
+
+void AddMakuLoadTasks(forward::core::TaskGraph& graph, MakuSceneAssets* maku) {
+  using TaskId = forward::core::TaskGraph::TaskId;
+  const TaskId terrain_task = graph.AddTask("maku terrain", [maku] {
+    const bool ok = LoadThroughAssetCache(
+        "maku-terrain",
+        ResolveForwardAssetPath("images/scape/loopk40.gif"),
+        0,
+        [maku](forward::core::AssetCacheReader& reader) { return reader.ReadMesh(&maku->terrain); },
+        [maku] {
+          std::string image_error;
+          Image32 maku_height;
+          if (!LoadForwardImage("images/scape/loopk40.gif", &maku_height, &image_error)) {
+            std::cerr << "maku heightmap load failed: " + image_error + "\n";
+            return false;
+          }
+          if (!BuildTerrainMeshFromHeightmap(maku_height, 200.0f, 1.94f, 0, &maku->terrain)) {
+            std::cerr << "maku terrain mesh build failed\n";
+            return false;
+          }
+          return true;
+        },
+        [maku](forward::core::AssetCacheWriter& writer) { writer.WriteMesh(maku->terrain); });
+    if (!ok) {
+      maku->terrain.Clear();
+    }
+  });
+  const TaskId texture_task = graph.AddTask("maku texture", [maku] {
+    std::string image_error;
+    if (!LoadForwardImage("images/scape/loopa2.gif", &maku->terrain_texture, &image_error)) {
+      std::cerr << "maku texture load failed: " + image_error + "\n";
+    }
+  });
+
+  auto tracks_ok = std::make_shared<bool>(false);
+  const TaskId tracks_task = graph.AddTask("vuori5 tracks", [maku, tracks_ok] {
+    const std::string maku_ase_path = ResolveForwardAssetPath("asses/vuori5.ase");
+    // Maku only needs the camera, so geometry objects are skipped entirely.
+    AseSceneData ase;
+    *tracks_ok = !maku_ase_path.empty() && LoadAseSceneCached(maku_ase_path, nullptr, &ase) &&
+                 ase.HasCameraTracks();
+    if (ase.has_camera_fov) {
+      maku->camera_fov_degrees = ase.camera_fov_degrees;
+    }
+    maku->camera_track = std::move(ase.camera_track);
+    maku->target_track = std::move(ase.target_track);
+    if (!*tracks_ok) {
+      std::cerr << "maku camera tracks parse failed\n";
+    }
+  });
+
+  graph.AddTask("maku finalize", [maku, tracks_ok] {
+    maku->enabled = !maku->terrain.Empty() && !maku->terrain_texture.Empty() && *tracks_ok;
+  }, {terrain_task, texture_task, tracks_task});
+}
+
+void AddWatercubeLoadTasks(forward::core::TaskGraph& graph, WatercubeSceneAssets* watercube) {
+  using TaskId = forward::core::TaskGraph::TaskId;
+  struct WatercubeTexture {
+    const char* path;
+    const char* label;
+    Image32* target;
+  };
+  const std::array<WatercubeTexture, 5> textures = {{
+      {"images/1.jpg", "panel overlay", &watercube->panel_overlay},
+      {"images/txt1.jpg", "scroll texture", &watercube->scroll_texture},
+      {"images/reunus2.jpg", "box texture", &watercube->box_texture},
+      {"images/rinku2.jpg", "ring texture", &watercube->ring_texture},
+      {"images/riple2.jpg", "ripple texture", &watercube->ripple_texture},
+  }};
+  std::vector<TaskId> watercube_tasks;
+  for (const WatercubeTexture& tex : textures) {
+    watercube_tasks.push_back(graph.AddTask(tex.path, [tex] {
+      std::string image_error;
+      LoadForwardImage(tex.path, tex.target, &image_error);
+      if (tex.target->Empty()) {
+        std::cerr << std::string("watercube ") + tex.label + " load failed: " + image_error + "\n";
+      }
+    }));
+  }
+  watercube_tasks.push_back(graph.AddTask("watercube env", [watercube] {
+    std::string image_error;
+    if (!LoadForwardImage("images/env3.jpg", &watercube->env_texture, &image_error)) {
+      std::cerr << "watercube env texture load failed: " + image_error + "\n";
+    }
+  }));
+
+  auto tracks_ok = std::make_shared<bool>(false);
+  auto objects_ok = std::make_shared<bool>(false);
+  const std::string watercube_ase_path = ResolveForwardAssetPath("asses/nosto3.ase");
+  watercube_tasks.push_back(graph.AddTask("nosto3 ase", [watercube, watercube_ase_path, tracks_ok, objects_ok] {
+    static const std::vector<std::string> kWatercubeObjectNames = {"Box01", "TriPatch01"};
+    AseSceneData ase;
+    const bool loaded = !watercube_ase_path.empty() &&
+                        LoadAseSceneCached(watercube_ase_path, &kWatercubeObjectNames, &ase);
+    if (ase.has_camera_fov) {
+      watercube->camera_fov_degrees = ase.camera_fov_degrees;
+    }
+    *tracks_ok = loaded && ase.HasCameraTracks();
+    *objects_ok = loaded && !ase.animated_objects.empty();
+    watercube->camera_track = std::move(ase.camera_track);
+    watercube->target_track = std::move(ase.target_track);
+    watercube->animated_objects = std::move(ase.animated_objects);
+    if (!*tracks_ok) {
+      std::cerr << "watercube camera tracks parse failed\n";
+    }
+    if (!*objects_ok) {
+      std::cerr << "watercube ASE object parse failed\n";
+    } else {
+      std::cerr << "watercube ASE objects loaded: " +
+                       std::to_string(watercube->animated_objects.size()) + "\n";
+    }
+  }));
+
+  watercube_tasks.push_back(graph.AddTask("kluns1", [watercube] {
+    std::string error;
+    const std::string kluns1_path = ResolveForwardAssetPath("meshes/kluns1.igu");
+    if (!kluns1_path.empty() && !LoadIguMeshCached(kluns1_path, watercube->kluns1, &error)) {
+      std::cerr << "watercube kluns1 load failed: " + error + "\n";
+      watercube->kluns1.Clear();
+    }
+  }));
+  watercube_tasks.push_back(graph.AddTask("kluns2", [watercube] {
+    std::string error;
+    const std::string kluns2_path = ResolveForwardAssetPath("meshes/kluns2.igu");
+    if (!kluns2_path.empty() && LoadIguMeshCached(kluns2_path, watercube->kluns2, &error)) {
+      watercube->has_kluns2 = !watercube->kluns2.Empty();
+    }
+  }));
+
+  graph.AddTask("watercube finalize", [watercube, tracks_ok, objects_ok] {
+    const bool textures_ok = !watercube->panel_overlay.Empty() && !watercube->scroll_texture.Empty() &&
+                             !watercube->box_texture.Empty() && !watercube->ring_texture.Empty() &&
+                             !watercube->ripple_texture.Empty();
+    watercube->enabled = textures_ok && *tracks_ok && *objects_ok;
+  }, watercube_tasks);
+}
+
+// Streams sequence-stage assets around the active stage. The stage that will be
+// active `lookahead_rows` module rows from now is loaded (if evicted) and has its
+// runtime initialized on a background thread, so the transition frame only swaps
+// state in. Streamable stages that are neither active nor upcoming are released.
+class SceneLifecycleManager {
+ public:
+  struct SceneRefs {
+    Mute95SceneAssets* mute95 = nullptr;
+    Mute95Runtime* mute95_runtime = nullptr;
+    DominaRuntime* domina_runtime = nullptr;
+    SaariSceneAssets* saari = nullptr;
+    SaariRuntime* saari_runtime = nullptr;
+    KukotSceneAssets* kukot = nullptr;
+    KukotRuntime* kukot_runtime = nullptr;
+    MakuSceneAssets* maku = nullptr;
+    MakuRuntime* maku_runtime = nullptr;
+    WatercubeSceneAssets* watercube = nullptr;
+    WatercubeRuntime* watercube_runtime = nullptr;
+    // Source of the modules' real row timing; null without music.
+    XmPlayer* music = nullptr;
+  };
+
+  SceneLifecycleManager(const SceneRefs& refs, int lookahead_rows)
+      : refs_(refs), lookahead_rows_(lookahead_rows) {
+    BindStreamable(SequenceStage::kMute95,
+                   "mute95",
+                   refs.mute95,
+                   refs.mute95_runtime,
+                   &AddMute95LoadTasks,
+                   [](const Mute95SceneAssets&, Mute95Runtime& runtime) {
+                     InitializeMute95Runtime(runtime);
+                   });
+    Slot& domina = SlotFor(SequenceStage::kDomina);
+    domina.name = "domina";
+    domina.reset_runtime = [runtime = refs.domina_runtime] { runtime->initialized = false; };
+    BindStreamable(SequenceStage::kSaari,
+                   "saari",
+                   refs.saari,
+                   refs.saari_runtime,
+                   &AddSaariLoadTasks,
+                   [](const SaariSceneAssets&, SaariRuntime& runtime) {
+                     InitializeSaariRuntime(runtime);
+                   });
+    BindStreamable(SequenceStage::kKukot,
+                   "kukot",
+                   refs.kukot,
+                   refs.kukot_runtime,
+                   &AddKukotLoadTasks,
+                   [](const KukotSceneAssets&, KukotRuntime& runtime) {
+                     InitializeKukotRuntime(runtime);
+                   });
+    BindStreamable(SequenceStage::kMaku,
+                   "maku",
+                   refs.maku,
+                   refs.maku_runtime,
+                   &AddMakuLoadTasks,
+                   [](const MakuSceneAssets&, MakuRuntime& runtime) {
+                     InitializeMakuRuntime(runtime);
+                   });
+    BindStreamable(SequenceStage::kWatercube,
+                   "watercube",
+                   refs.watercube,
+                   refs.watercube_runtime,
+                   &AddWatercubeLoadTasks,
+                   [](const WatercubeSceneAssets& assets, WatercubeRuntime& runtime) {
+                     InitializeWatercubeRuntime(assets, runtime);
+                   });
+    if (Enabled()) {
+      worker_ = std::thread([this] { WorkerLoop(); });
+    }
+  }
+
+  ~SceneLifecycleManager() {
+    {
+      std::lock_guard<std::mutex> lock(jobs_mutex_);
+      stopping_ = true;
+    }
+    jobs_cv_.notify_all();
+    if (worker_.joinable()) {
+      worker_.join();
+    }
+  }
+
+  SceneLifecycleManager(const SceneLifecycleManager&) = delete;
+  SceneLifecycleManager& operator=(const SceneLifecycleManager&) = delete;
+
+  bool Enabled() const { return lookahead_rows_ > 0; }
+
+  // Polls background jobs, then schedules prefetch/eviction for the current position.
+  void Update(const DemoState& state, const XmTiming& timing, double fallback_script_seconds) {
+    if (!Enabled()) {
+      return;
+    }
+    for (Slot& slot : slots_) {
+      if (JobState(slot) == Job::kDone) {
+        FinishJob(slot);
+      }
+    }
+
+    if (state.scene_mode != SceneMode::kMute95DominaSequence) {
+      // Feta/uppol close the script; none of the streamed stages are needed after them.
+      if (state.script_driven &&
+          (state.scene_mode == SceneMode::kFeta || state.scene_mode == SceneMode::kUppol)) {
+        for (Slot& slot : slots_) {
+          Evict(slot);
+        }
+      }
+      return;
+    }
+
+    const SequenceStage current = state.sequence_stage;
+    SequenceStage upcoming = current;
+    XmTiming ahead;
+    if (timing.valid) {
+      // Without seek tables there is no reliable lead; the stage then loads on entry.
+      if (AdvanceTimingByRows(timing, lookahead_rows_, &ahead)) {
+        upcoming = DetermineSequenceStage(ahead,
+                                          refs_.saari->enabled,
+                                          refs_.kukot->enabled,
+                                          refs_.maku->enabled,
+                                          refs_.watercube->enabled,
+                                          0.0);
+      }
+    } else {
+      upcoming = DetermineSequenceStage(timing,
+                                        refs_.saari->enabled,
+                                        refs_.kukot->enabled,
+                                        refs_.maku->enabled,
+                                        refs_.watercube->enabled,
+                                        fallback_script_seconds +
+                                            lookahead_rows_ * SecondsPerRow());
+    }
+
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      const SequenceStage stage = static_cast<SequenceStage>(i);
+      if (stage != current && stage != upcoming) {
+        Evict(slots_[i]);
+      }
+    }
+    if (upcoming != current) {
+      Prefetch(SlotFor(upcoming));
+    }
+  }
+
+  // Called on a sequence stage transition. Blocks only if the stage is not resident
+  // yet; uses the pre-initialized runtime when the prefetch got to it in time.
+  void EnterStage(SequenceStage stage) {
+    Slot& slot = SlotFor(stage);
+    EnsureResident(stage);
+    if (slot.runtime_prepared && slot.take_runtime) {
+      slot.take_runtime();
+      slot.runtime_prepared = false;
+    } else if (slot.reset_runtime) {
+      slot.reset_runtime();
+    }
+  }
+
+  // Synchronously brings a stage's assets back (used by direct scene switches).
+  void EnsureResident(SequenceStage stage) {
+    Slot& slot = SlotFor(stage);
+    if (JobState(slot) != Job::kIdle) {
+      const uint64_t wait_start = SDL_GetPerformanceCounter();
+      {
+        std::unique_lock<std::mutex> lock(jobs_mutex_);
+        done_cv_.wait(lock, [&slot] { return slot.job == Job::kDone; });
+      }
+      const double waited_ms =
+          static_cast<double>(SDL_GetPerformanceCounter() - wait_start) * 1000.0 /
+          static_cast<double>(SDL_GetPerformanceFrequency());
+      if (waited_ms > 1.0) {
+        std::cerr << "scene prefetch: waited " << static_cast<int>(waited_ms) << " ms for "
+                  << slot.name << "\n";
+      }
+      FinishJob(slot);
+    }
+    if (!slot.resident && slot.prepare) {
+      std::cerr << "scene prefetch: loading " << slot.name << " synchronously\n";
+      slot.runtime_prepared = slot.prepare(true);
+      slot.commit_assets();
+      slot.resident = true;
+    }
+  }
+
+ private:
+  // Row duration at the default speed 6 / 125 bpm, for a script running
+  // without any module loaded.
+  static constexpr double kNominalSecondsPerRow = 0.12;
+
+  enum class Job { kIdle, kQueued, kRunning, kDone };
+
+  struct Slot {
+    std::string name;
+    bool streamable = false;
+    bool resident = true;
+    bool runtime_prepared = false;
+    bool job_loads_assets = false;
+    uint64_t job_start_counter = 0;
+    // `job` and `job_result` are shared with the worker under jobs_mutex_.
+    Job job = Job::kIdle;
+    bool job_result = false;
+    std::function<bool(bool)> prepare;
+    std::function<void()> commit_assets;
+    std::function<void()> take_runtime;
+    std::function<void()> reset_runtime;
+    std::function<void()> release;
+  };
+
+  template <typename Assets, typename Runtime>
+  struct StagedScene {
+    Assets assets;
+    Runtime runtime;
+  };
+
+  template <typename Assets, typename Runtime, typename InitRuntime>
+  void BindStreamable(SequenceStage stage,
+                      const char* name,
+                      Assets* live,
+                      Runtime* live_runtime,
+                      void (*add_tasks)(forward::core::TaskGraph&, Assets*),
+                      InitRuntime init_runtime) {
+    auto staged = std::make_shared<StagedScene<Assets, Runtime>>();
+    Slot& slot = SlotFor(stage);
+    slot.name = name;
+    slot.streamable = true;
+    // Runs on the background thread: only touches the staged copy, and reads the
+    // live assets only while they are resident and unused by the active stage.
+    slot.prepare = [staged, live, add_tasks, init_runtime](bool load_assets) {
+      staged->runtime = Runtime{};
+      const Assets* source = live;
+      if (load_assets) {
+        staged->assets = Assets{};
+        forward::core::TaskGraph graph;
+        add_tasks(graph, &staged->assets);
+        graph.Wait();
+        source = &staged->assets;
+      }
+      if (!source->enabled) {
+        return false;
+      }
+      init_runtime(*source, staged->runtime);
+      return true;
+    };
+    slot.commit_assets = [staged, live] {
+      const bool enabled = live->enabled;
+      *live = std::move(staged->assets);
+      staged->assets = Assets{};
+      live->enabled = enabled;
+    };
+    slot.take_runtime = [staged, live_runtime] {
+      *live_runtime = std::move(staged->runtime);
+      staged->runtime = Runtime{};
+    };
+    slot.reset_runtime = [live_runtime] { live_runtime->initialized = false; };
+    slot.release = [staged, live, live_runtime] {
+      const bool enabled = live->enabled;
+      *live = Assets{};
+      live->enabled = enabled;
+      *live_runtime = Runtime{};
+      staged->runtime = Runtime{};
+    };
+  }
+
+  Slot& SlotFor(SequenceStage stage) { return slots_[static_cast<size_t>(stage)]; }
+
+  // The position `rows` rows of playback after `timing`, stepped through the
+  // modules' seek tables so pattern lengths are the modules' own. Module 1
+  // hands over to module 2 at kMod1ToMod2Row. False without the tables.
+  bool AdvanceTimingByRows(const XmTiming& timing, int rows, XmTiming* out_timing) const {
+    XmPlayer* music = refs_.music;
+    if (!music) {
+      return false;
+    }
+    int slot = timing.module_slot <= 1 ? 1 : 2;
+    int index = music->SeekRowIndex(slot, timing.order, timing.row);
+    if (index < 0) {
+      return false;
+    }
+    index += rows;
+    if (slot == 1) {
+      const int switch_index = music->SeekRowIndex(1, kMod1ToMod2Row >> 8, kMod1ToMod2Row & 0xFF);
+      if (switch_index < 0) {
+        return false;
+      }
+      if (index >= switch_index) {
+        index -= switch_index;
+        slot = 2;
+      }
+    }
+    const int last = music->SeekRowCount(slot) - 1;
+    XmSeekPoint point;
+    if (last < 0 || !music->SeekPointAtIndex(slot, std::min(index, last), &point)) {
+      return false;
+    }
+    *out_timing = timing;
+    out_timing->module_slot = slot;
+    out_timing->order = point.order;
+    out_timing->row = point.row;
+    return true;
+  }
+
+  // Mean row duration of the first module's playback, which the script's
+  // seconds fallback covers; nominal when no module is loaded.
+  double SecondsPerRow() const {
+    XmPlayer* music = refs_.music;
+    const int rows = music ? music->SeekRowCount(1) : 0;
+    XmSeekPoint first;
+    XmSeekPoint last;
+    if (rows < 2 || !music->SeekPointAtIndex(1, 0, &first) ||
+        !music->SeekPointAtIndex(1, rows - 1, &last) ||
+        last.module_time_ms <= first.module_time_ms) {
+      return kNominalSecondsPerRow;
+    }
+    return static_cast<double>(last.module_time_ms - first.module_time_ms) / 1000.0 /
+           static_cast<double>(rows - 1);
+  }
+
+  Job JobState(const Slot& slot) {
+    std::lock_guard<std::mutex> lock(jobs_mutex_);
+    return slot.job;
+  }
+
+  // Queuing a job only flips the slot's state, so the frame that starts a
+  // prefetch does not allocate or start a thread.
+  void Prefetch(Slot& slot) {
+    if (!slot.prepare || slot.runtime_prepared || !worker_.joinable()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(jobs_mutex_);
+      if (slot.job != Job::kIdle) {
+        return;
+      }
+      slot.job_loads_assets = !slot.resident;
+      slot.job_start_counter = SDL_GetPerformanceCounter();
+      slot.job = Job::kQueued;
+    }
+    jobs_cv_.notify_one();
+  }
+
+  // One persistent thread runs the queued prepare jobs in slot order.
+  void WorkerLoop() {
+    FORWARD_PROFILE_THREAD("scene prefetch");
+    std::unique_lock<std::mutex> lock(jobs_mutex_);
+    while (true) {
+      Slot* queued = nullptr;
+      jobs_cv_.wait(lock, [this, &queued] {
+        for (Slot& slot : slots_) {
+          if (slot.job == Job::kQueued) {
+            queued = &slot;
+            break;
+          }
+        }
+        return stopping_ || queued;
+      });
+      if (stopping_) {
+        return;
+      }
+      queued->job = Job::kRunning;
+      const bool load_assets = queued->job_loads_assets;
+      lock.unlock();
+      const bool result = queued->prepare(load_assets);
+      lock.lock();
+      queued->job_result = result;
+      queued->job = Job::kDone;
+      done_cv_.notify_all();
+    }
+  }
+
+  void FinishJob(Slot& slot) {
+    {
+      std::lock_guard<std::mutex> lock(jobs_mutex_);
+      slot.runtime_prepared = slot.job_result;
+      slot.job = Job::kIdle;
+    }
+    if (slot.job_loads_assets) {
+      slot.commit_assets();
+      slot.resident = true;
+    }
+    const double ms = static_cast<double>(SDL_GetPerformanceCounter() - slot.job_start_counter) *
+                      1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    std::cerr << "scene prefetch: " << slot.name
+              << (slot.job_loads_assets ? " loaded" : " prepared") << " in " << static_cast<int>(ms)
+              << " ms\n";
+  }
+
+  void Evict(Slot& slot) {
+    if (!slot.streamable || !slot.resident || JobState(slot) != Job::kIdle) {
+      return;
+    }
+    slot.release();
+    slot.resident = false;
+    slot.runtime_prepared = false;
+    std::cerr << "scene prefetch: released " << slot.name << "\n";
+  }
+
+  SceneRefs refs_;
+  int lookahead_rows_ = 0;
+  std::array<Slot, 6> slots_;
+  std::mutex jobs_mutex_;
+  std::condition_variable jobs_cv_;
+  std::condition_variable done_cv_;
+  bool stopping_ = false;
+  std::thread worker_;
+};
+
 }  // namespace
 
 int main(int argc, char** argv) {
   SDL_SetMainReady();
-  if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_TIMER | SDL_INIT_EVENTS) != 0) {
-    std::cerr << "SDL_Init failed: " << SDL_GetError() << "\n";
-    return 1;
-  }
 
   const std::string mesh_path = ResolveMeshPath();
   if (mesh_path.empty()) {
@@ -5721,16 +6165,26 @@ int main(int argc, char** argv) {
   }
 
   Mesh mesh;
-  std::string mesh_error;
-  if (!forward::core::LoadIguMesh(mesh_path, mesh, &mesh_error)) {
-    std::cerr << "LoadIguMesh failed: " << mesh_error << "\n";
-    SDL_Quit();
-    return 1;
-  }
 
   bool disable_audio = false;
   bool verbose_audio = false;
+  bool offline_audio = false;
+  std::string audio_wav_path;
   int maku_bootstrap_row = kMod2ToMakuRow;
+  int seek_module_slot = 2;
+  int seek_order_row = -1;
+  int prefetch_rows = kDefaultPrefetchRows;
+  int audio_ahead_ms = XmPlayer::kDefaultMixAheadMs;
+  std::string asset_cache_dir = kDefaultAssetCacheDir;
+  HeadlessRun headless;
+  BenchRun bench;
+  bench.enabled = FORWARD_BENCH_BUILD != 0;
+  std::filesystem::path dump_frames_dir;
+  TraceCapture trace;
+  MetricsStream metrics;
+  StallRecorder stall;
+  bool report_allocation_sites = false;
+  int render_workers = -1;
   WatercubeValidationHarness watercube_harness;
   MakuValidationHarness maku_harness;
   FetaValidationHarness feta_harness;
@@ -5740,6 +6194,11 @@ int main(int argc, char** argv) {
       disable_audio = true;
     } else if (arg == "--verbose-audio") {
       verbose_audio = true;
+    } else if (arg == "--audio-offline") {
+      offline_audio = true;
+    } else if (arg.rfind("--audio-wav=", 0) == 0) {
+      offline_audio = true;
+      audio_wav_path = arg.substr(std::string("--audio-wav=").size());
     } else if (arg == "--watercube-capture") {
       watercube_harness.enabled = true;
       watercube_harness.output_dir =
@@ -5768,6 +6227,129 @@ int main(int argc, char** argv) {
       } else {
         std::cerr << "warning: invalid --maku-row value: " << arg << "\n";
       }
+    } else if (arg.rfind("--seek-row=", 0) == 0) {
+      if (!ParseModuleOrderRowArgument(arg.substr(std::string("--seek-row=").size()),
+                                       2,
+                                       &seek_module_slot,
+                                       &seek_order_row)) {
+        std::cerr << "warning: invalid --seek-row value: " << arg << "\n";
+      }
+    } else if (arg == "--headless") {
+      headless.enabled = true;
+    } else if (arg.rfind("--frames=", 0) == 0) {
+      try {
+        headless.max_frames = std::max(1, std::stoi(arg.substr(std::string("--frames=").size())));
+      } catch (...) {
+        std::cerr << "warning: invalid --frames value: " << arg << "\n";
+      }
+    } else if (arg.rfind("--fps=", 0) == 0) {
+      try {
+        headless.fps = std::max(1, std::stoi(arg.substr(std::string("--fps=").size())));
+      } catch (...) {
+        std::cerr << "warning: invalid --fps value: " << arg << "\n";
+      }
+    } else if (arg.rfind("--end-seconds=", 0) == 0) {
+      try {
+        headless.end_seconds =
+            std::max(0.0, std::stod(arg.substr(std::string("--end-seconds=").size())));
+      } catch (...) {
+        std::cerr << "warning: invalid --end-seconds value: " << arg << "\n";
+      }
+    } else if (arg.rfind("--end-row=", 0) == 0) {
+      if (!ParseModuleOrderRowArgument(arg.substr(std::string("--end-row=").size()),
+                                       2,
+                                       &headless.end_module_slot,
+                                       &headless.end_order_row)) {
+        std::cerr << "warning: invalid --end-row value: " << arg << "\n";
+      }
+    } else if (arg == "--bench") {
+      bench.enabled = true;
+    } else if (arg.rfind("--bench-frames=", 0) == 0) {
+      try {
+        bench.frames = std::max(1, std::stoi(arg.substr(std::string("--bench-frames=").size())));
+      } catch (...) {
+        std::cerr << "warning: invalid --bench-frames value: " << arg << "\n";
+      }
+    } else if (arg.rfind("--bench-warmup=", 0) == 0) {
+      try {
+        bench.warmup_frames =
+            std::max(0, std::stoi(arg.substr(std::string("--bench-warmup=").size())));
+      } catch (...) {
+        std::cerr << "warning: invalid --bench-warmup value: " << arg << "\n";
+      }
+    } else if (arg.rfind("--bench-scenes=", 0) == 0) {
+      bench.scene_filter = arg.substr(std::string("--bench-scenes=").size());
+    } else if (arg.rfind("--bench-json=", 0) == 0) {
+      bench.json_path = arg.substr(std::string("--bench-json=").size());
+    } else if (arg.rfind("--bench-baseline=", 0) == 0) {
+      bench.baseline_path = arg.substr(std::string("--bench-baseline=").size());
+    } else if (arg.rfind("--bench-threshold=", 0) == 0) {
+      try {
+        bench.threshold_percent =
+            std::max(0.0, std::stod(arg.substr(std::string("--bench-threshold=").size())));
+      } catch (...) {
+        std::cerr << "warning: invalid --bench-threshold value: " << arg << "\n";
+      }
+    } else if (arg.rfind("--bench-max-allocs=", 0) == 0) {
+      try {
+        bench.max_allocations = static_cast<uint64_t>(
+            std::max(0LL, std::stoll(arg.substr(std::string("--bench-max-allocs=").size()))));
+      } catch (...) {
+        std::cerr << "warning: invalid --bench-max-allocs value: " << arg << "\n";
+      }
+    } else if (arg == "--alloc-sites") {
+      report_allocation_sites = true;
+    } else if (arg.rfind("--trace=", 0) == 0) {
+      trace.path = arg.substr(std::string("--trace=").size());
+    } else if (arg.rfind("--metrics=", 0) == 0) {
+      metrics.path = arg.substr(std::string("--metrics=").size());
+    } else if (arg.rfind("--metrics-period=", 0) == 0) {
+      try {
+        metrics.period_seconds =
+            std::max(0.01, std::stod(arg.substr(std::string("--metrics-period=").size())));
+      } catch (...) {
+        std::cerr << "warning: invalid --metrics-period value: " << arg << "\n";
+      }
+    } else if (arg.rfind("--stall-ms=", 0) == 0) {
+      try {
+        stall.budget_ms = std::max(0.0, std::stod(arg.substr(std::string("--stall-ms=").size())));
+      } catch (...) {
+        std::cerr << "warning: invalid --stall-ms value: " << arg << "\n";
+      }
+    } else if (arg.rfind("--stall-window=", 0) == 0) {
+      try {
+        stall.window_seconds =
+            std::max(0.1, std::stod(arg.substr(std::string("--stall-window=").size())));
+      } catch (...) {
+        std::cerr << "warning: invalid --stall-window value: " << arg << "\n";
+      }
+    } else if (arg.rfind("--stall-dir=", 0) == 0) {
+      stall.directory = arg.substr(std::string("--stall-dir=").size());
+    } else if (arg.rfind("--render-workers=", 0) == 0) {
+      try {
+        render_workers =
+            std::max(0, std::stoi(arg.substr(std::string("--render-workers=").size())));
+      } catch (...) {
+        std::cerr << "warning: invalid --render-workers value: " << arg << "\n";
+      }
+    } else if (arg.rfind("--dump-frames=", 0) == 0) {
+      dump_frames_dir = arg.substr(std::string("--dump-frames=").size());
+    } else if (arg.rfind("--prefetch-rows=", 0) == 0) {
+      try {
+        prefetch_rows = std::max(0, std::stoi(arg.substr(std::string("--prefetch-rows=").size())));
+      } catch (...) {
+        std::cerr << "warning: invalid --prefetch-rows value: " << arg << "\n";
+      }
+    } else if (arg.rfind("--audio-ahead-ms=", 0) == 0) {
+      try {
+        audio_ahead_ms = std::max(0, std::stoi(arg.substr(std::string("--audio-ahead-ms=").size())));
+      } catch (...) {
+        std::cerr << "warning: invalid --audio-ahead-ms value: " << arg << "\n";
+      }
+    } else if (arg.rfind("--asset-cache=", 0) == 0) {
+      asset_cache_dir = arg.substr(std::string("--asset-cache=").size());
+    } else if (arg == "--no-asset-cache") {
+      asset_cache_dir.clear();
     } else if (arg == "--feta-capture") {
       feta_harness.enabled = true;
       feta_harness.output_dir = std::filesystem::path("documentation") / "feta-checkpoints";
@@ -5780,6 +6362,72 @@ int main(int argc, char** argv) {
       feta_harness.has_reference_dir = true;
     }
   }
+
+  if (!trace.path.empty()) {
+    if (FORWARD_PROFILING) {
+      FORWARD_PROFILE_THREAD("main");
+      Profiler::SetEnabled(true);
+    } else {
+      std::cerr << "warning: --trace ignored, built without FORWARD_PROFILING\n";
+      trace.path.clear();
+    }
+  }
+  if (stall.budget_ms >= 0.0) {
+    if (FORWARD_PROFILING) {
+      FORWARD_PROFILE_THREAD("main");
+      Profiler::SetEnabled(true);
+    } else {
+      std::cerr << "warning: built without FORWARD_PROFILING; stalls are reported but no "
+                   "traces are written\n";
+    }
+  }
+  if (report_allocation_sites && !forward::core::AllocationSitesAvailable()) {
+    std::cerr << "warning: --alloc-sites needs a debug build with FORWARD_TRACK_ALLOCATIONS\n";
+    report_allocation_sites = false;
+  }
+  if (metrics.path == "-") {
+    metrics.out = &std::cout;
+  } else if (!metrics.path.empty()) {
+    metrics.file.open(metrics.path, std::ios::binary);
+    if (metrics.file.is_open()) {
+      metrics.out = &metrics.file;
+    } else {
+      std::cerr << "metrics disabled: cannot open " << metrics.path << "\n";
+    }
+  }
+
+  // Headless runs need neither a display nor an audio device; music is pulled
+  // through the offline backend so its rows follow the virtual clock. A bench
+  // is a headless run that ends once every scene has been timed.
+  if (bench.enabled) {
+    headless.enabled = true;
+    headless.max_frames = -1;
+    headless.end_seconds = -1.0;
+    headless.end_order_row = -1;
+  }
+  const Uint32 sdl_flags =
+      headless.enabled ? SDL_INIT_TIMER : (SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_EVENTS);
+  // Audio is initialised on demand so the offline backend runs without a device.
+  if (SDL_Init(sdl_flags) != 0) {
+    std::cerr << "SDL_Init failed: " << SDL_GetError() << "\n";
+    return 1;
+  }
+  if (headless.enabled) {
+    offline_audio = true;
+    if (!bench.enabled && headless.max_frames < 0 && headless.end_seconds < 0.0 &&
+        headless.end_order_row < 0) {
+      headless.max_frames = kDefaultHeadlessFrames;
+    }
+  }
+  if (!dump_frames_dir.empty()) {
+    std::error_code ec;
+    std::filesystem::create_directories(dump_frames_dir, ec);
+    if (ec) {
+      std::cerr << "frame dump disabled: cannot create " << dump_frames_dir.string() << "\n";
+      dump_frames_dir.clear();
+    }
+  }
+
   if (watercube_harness.enabled && watercube_harness.output_dir.empty()) {
     watercube_harness.output_dir = std::filesystem::path("documentation") / "watercube-checkpoints";
   }
@@ -5823,12 +6471,9 @@ int main(int argc, char** argv) {
     }
   }
   watercube_harness.captured_rows.clear();
-  watercube_harness.last_order_row = -1;
   maku_harness.captured_rows.clear();
-  maku_harness.last_order_row = -1;
   maku_harness.direct_row_hint = maku_bootstrap_row;
   feta_harness.captured_rows.clear();
-  feta_harness.last_order_row = -1;
   if (disable_audio && verbose_audio) {
     std::cerr << "audio disabled by command line (--nosound)\n";
   }
@@ -5839,15 +6484,12 @@ int main(int argc, char** argv) {
   camera.near_plane = 0.1f;
 
   RenderInstance mesh_instance;
-  const float radius = mesh.BoundingRadius();
-  mesh_instance.uniform_scale = (radius > 0.001f) ? (1.0f / radius) : 1.0f;
   mesh_instance.translation = Vec3(0.0f, 0.0f, 2.6f);
   mesh_instance.draw_fill = true;
   mesh_instance.draw_wire = true;
   mesh_instance.enable_backface_culling = true;
 
   RenderInstance halo_instance;
-  halo_instance.uniform_scale = mesh_instance.uniform_scale * 1.075f;
   halo_instance.draw_fill = true;
   halo_instance.draw_wire = false;
   halo_instance.enable_backface_culling = true;
@@ -5885,331 +6527,81 @@ int main(int argc, char** argv) {
   UppolRuntime uppol_runtime;
   MmaamkaParticlePass particles;
   KaaakmaBackgroundPass background;
-  {
-    std::string image_error;
-    const std::array<std::pair<std::string, std::string>, 5> credit_files = {
-        std::pair<std::string, std::string>{"images/kosmos/sav1.jpg", "images/kosmos/sav2.jpg"},
-        std::pair<std::string, std::string>{"images/kosmos/jmag1.jpg", "images/kosmos/jmag2.jpg"},
-        std::pair<std::string, std::string>{"images/kosmos/jugi1.jpg", "images/kosmos/jugi2.jpg"},
-        std::pair<std::string, std::string>{"images/kosmos/anis1.jpg", "images/kosmos/anis2.jpg"},
-        std::pair<std::string, std::string>{"images/kosmos/car1.jpg", "images/kosmos/car2.jpg"},
-    };
-
-    bool all_credits_loaded = true;
-    for (size_t i = 0; i < credit_files.size(); ++i) {
-      const auto& pair = credit_files[i];
-      bool ok = LoadForwardImage(pair.first, &mute95.credits[i].first, &image_error);
-      if (!ok) {
-        std::cerr << "mute95 credit load failed: " << image_error << "\n";
-        all_credits_loaded = false;
-      }
-      ok = LoadForwardImage(pair.second, &mute95.credits[i].second, &image_error);
-      if (!ok) {
-        std::cerr << "mute95 credit load failed: " << image_error << "\n";
-        all_credits_loaded = false;
-      }
-    }
-
-    const std::string palette_path = ResolveForwardAssetPath("images/kosmos/krad3.gif");
-    const bool has_palette = !palette_path.empty() && LoadGifGlobalPalette(palette_path, &mute95.palette);
-    if (!has_palette) {
-      std::cerr << "mute95 palette load failed: unable to parse GIF global palette\n";
-    }
-    mute95.enabled = all_credits_loaded && has_palette;
-  }
-
-  if (std::filesystem::path(mesh_path).filename().string() == "fetus.igu") {
-    std::string image_error;
-    const std::string babyenv_path = ResolveForwardAssetPath("images/babyenv.jpg");
-    const std::string flare_path = ResolveForwardAssetPath("images/flare1.jpg");
-    const std::string kosmusp_path = ResolveForwardAssetPath("images/verax/kosmusp.jpg");
-    const std::string background_mesh_path = ResolveFirstExistingForwardPath(
-        std::array<std::string, 2>{"meshes/octa8.igu", "meshes/half8.igu"});
-
-    const bool has_babyenv =
-        !babyenv_path.empty() && forward::core::LoadImage32(babyenv_path, feta.babyenv, &image_error);
-    if (!has_babyenv && !babyenv_path.empty()) {
-      std::cerr << "feta babyenv load failed: " << image_error << "\n";
-    }
-
-    const bool has_flare =
-        !flare_path.empty() && forward::core::LoadImage32(flare_path, feta.flare, &image_error);
-    if (!has_flare && !flare_path.empty()) {
-      std::cerr << "feta flare load failed: " << image_error << "\n";
-    }
-
-    if (!kosmusp_path.empty() &&
-        !forward::core::LoadImage32(kosmusp_path, background.texture, &image_error)) {
-      std::cerr << "kaaakma background texture load failed: " << image_error << "\n";
-    }
-    if (!background_mesh_path.empty() &&
-        !forward::core::LoadIguMesh(background_mesh_path, background.mesh, &mesh_error)) {
-      std::cerr << "kaaakma background mesh load failed: " << mesh_error << "\n";
-      background.mesh.Clear();
-    }
-    if (!background.mesh.Empty() && !background.texture.Empty()) {
-      const float background_radius = background.mesh.BoundingRadius();
-      background_instance.uniform_scale =
-          (background_radius > 0.001f) ? (10000.0f / background_radius) : 10000.0f;
-      background.enabled = true;
-    }
-
-    feta.enabled = has_babyenv;
-    particles.flare = feta.flare;
-    particles.enabled = has_flare;
-  }
-
-  {
-    std::string image_error;
-    Image32 saari_height;
-    Image32 saari_tex_full;
-    Image32 saari_backdrop_full;
+  QuickWinPostLayer post;
 
-    const bool has_height =
-        LoadForwardImage("images/scape/saarih15.gif", &saari_height, &image_error);
-    if (!has_height) {
-      std::cerr << "saari heightmap load failed: " << image_error << "\n";
-    }
+  // Asset decoding/parsing runs as independent tasks on a worker pool while the
+  // main thread brings up audio and the SDL window. Each task only writes the
+  // asset fields it owns; finalize tasks depend on the loads they aggregate.
+  using TaskId = forward::core::TaskGraph::TaskId;
+  GetAssetCache().SetDirectory(asset_cache_dir);
+  forward::core::TaskGraph loader;
+  const uint64_t load_start_counter = SDL_GetPerformanceCounter();
 
-    const bool has_terrain_tex =
-        LoadForwardImage("images/scape/saari.gif", &saari_tex_full, &image_error);
-    if (!has_terrain_tex) {
-      std::cerr << "saari texture load failed: " << image_error << "\n";
-    }
+  bool mesh_loaded = false;
+  std::string mesh_error;
+  loader.AddTask("mesh", [&] {
+    mesh_loaded = LoadIguMeshCached(mesh_path, mesh, &mesh_error);
+  });
 
-    const bool has_backdrop =
-        LoadForwardImage("images/verax/tai1sp.jpg", &saari_backdrop_full, &image_error);
-    if (!has_backdrop) {
-      std::cerr << "saari backdrop load failed: " << image_error << "\n";
-    }
+  AddMute95LoadTasks(loader, &mute95);
 
-    if (has_terrain_tex) {
-      saari.terrain_texture = ExtractTopHalf(saari_tex_full);
-      saari.water_texture = ExtractBottomHalf(saari_tex_full);
-      if (saari.terrain_texture.Empty()) {
-        saari.terrain_texture = std::move(saari_tex_full);
+  if (std::filesystem::path(mesh_path).filename().string() == "fetus.igu") {
+    const TaskId babyenv_task = loader.AddTask("feta babyenv", [&feta] {
+      std::string image_error;
+      const std::string babyenv_path = ResolveForwardAssetPath("images/babyenv.jpg");
+      if (!babyenv_path.empty() &&
+          !LoadImage32Cached(babyenv_path, feta.babyenv, &image_error)) {
+        std::cerr << "feta babyenv load failed: " + image_error + "\n";
       }
-      if (saari.water_texture.Empty()) {
-        saari.water_texture = saari.terrain_texture;
+    });
+    const TaskId flare_task = loader.AddTask("feta flare", [&feta] {
+      std::string image_error;
+      const std::string flare_path = ResolveForwardAssetPath("images/flare1.jpg");
+      if (!flare_path.empty() && !LoadImage32Cached(flare_path, feta.flare, &image_error)) {
+        std::cerr << "feta flare load failed: " + image_error + "\n";
       }
-    }
-    if (has_backdrop) {
-      saari.backdrop_texture = ExtractRect(saari_backdrop_full, 0, 0, 256, 256);
-      if (saari.backdrop_texture.Empty()) {
-        saari.backdrop_texture = std::move(saari_backdrop_full);
+    });
+    const TaskId background_texture_task = loader.AddTask("kaaakma texture", [&background] {
+      std::string image_error;
+      const std::string kosmusp_path = ResolveForwardAssetPath("images/verax/kosmusp.jpg");
+      if (!kosmusp_path.empty() &&
+          !LoadImage32Cached(kosmusp_path, background.texture, &image_error)) {
+        std::cerr << "kaaakma background texture load failed: " + image_error + "\n";
       }
-    }
-
-    bool mesh_ok = false;
-    if (has_height) {
-      mesh_ok = BuildSaariTerrainMeshFromHeightmap(saari_height, &saari.terrain);
-      if (!mesh_ok) {
-        std::cerr << "saari terrain mesh build failed\n";
-      } else if (!BuildSaariSeaMeshFromTerrain(saari.terrain, &saari.sea)) {
-        std::cerr << "saari sea mesh build failed\n";
+    });
+    const TaskId background_mesh_task = loader.AddTask("kaaakma mesh", [&background] {
+      std::string error;
+      const std::string background_mesh_path = ResolveFirstExistingForwardPath(
+          std::array<std::string, 2>{"meshes/octa8.igu", "meshes/half8.igu"});
+      if (!background_mesh_path.empty() &&
+          !LoadIguMeshCached(background_mesh_path, background.mesh, &error)) {
+        std::cerr << "kaaakma background mesh load failed: " + error + "\n";
+        background.mesh.Clear();
       }
-    }
-
-    bool backdrop_mesh_ok = false;
-    const std::string half8_path = ResolveForwardAssetPath("meshes/half8.igu");
-    if (!half8_path.empty() &&
-        forward::core::LoadIguMesh(half8_path, saari.backdrop_mesh, &mesh_error) &&
-        !saari.backdrop_mesh.Empty()) {
-      // Java kaaakma constructor mirrors sky U coordinates (u = 1 - u).
-      FlipMeshUvU(&saari.backdrop_mesh);
-      const float r = saari.backdrop_mesh.BoundingRadius();
-      saari.backdrop_scale = (r > 0.001f) ? (10000.0f / r) : 10000.0f;
-      backdrop_mesh_ok = true;
-    } else {
-      std::cerr << "saari backdrop mesh load failed\n";
-    }
-
-    const std::string saari_ase_path = ResolveForwardAssetPath("asses/alku6.ase");
-    bool tracks_ok = false;
-    bool objects_ok = false;
-    if (!saari_ase_path.empty()) {
-      tracks_ok = ParseSaariAseCameraTracks(saari_ase_path,
-                                            &saari.camera_track,
-                                            &saari.target_track,
-                                            &saari.camera_fov_degrees);
-      objects_ok = ParseSaariAseObjects(saari_ase_path, &saari.animated_objects);
-    }
-    if (!tracks_ok) {
-      std::cerr << "saari camera tracks parse failed\n";
-    }
-    if (!objects_ok) {
-      std::cerr << "saari ASE object parse failed\n";
-    } else {
-      std::cerr << "saari ASE objects loaded: " << saari.animated_objects.size() << "\n";
-    }
-
-    saari.enabled = mesh_ok && !saari.sea.Empty() && !saari.terrain_texture.Empty() &&
-                    !saari.water_texture.Empty() && !saari.backdrop_texture.Empty() && backdrop_mesh_ok;
-  }
-
-  {
-    std::string image_error;
-    std::array<uint32_t, 256> env_palette{};
-    bool has_env_palette = false;
+    });
 
-    const std::string envplane_path = ResolveForwardAssetPath("images/envplane.gif");
-    if (!envplane_path.empty()) {
-      has_env_palette = LoadGifGlobalPalette(envplane_path, &env_palette);
-      if (!has_env_palette) {
-        Image32 envplane_image;
-        if (LoadForwardImage("images/envplane.gif", &envplane_image, &image_error) &&
-            !envplane_image.Empty()) {
-          const int y = 0;
-          for (int i = 0; i < 256; ++i) {
-            const int x = (i * std::max(1, envplane_image.width - 1)) / 255;
-            env_palette[static_cast<size_t>(i)] =
-                envplane_image.pixels[static_cast<size_t>(y) *
-                                          static_cast<size_t>(envplane_image.width) +
-                                      static_cast<size_t>(x)];
-          }
-          has_env_palette = true;
-        }
+    loader.AddTask("feta finalize", [&] {
+      if (!background.mesh.Empty() && !background.texture.Empty()) {
+        const float background_radius = background.mesh.BoundingRadius();
+        background_instance.uniform_scale =
+            (background_radius > 0.001f) ? (10000.0f / background_radius) : 10000.0f;
+        background.enabled = true;
       }
-    }
-    if (!has_env_palette) {
-      std::cerr << "kukot envplane load failed\n";
-    } else {
-      kukot.object_texture = BuildKukotEnvTextureFromPalette(env_palette, 48.0f, 192.0f, 80.0f);
-    }
-
-    kukot.random_tile = BuildKukotRandomTile(0x06C0FFEEu);
-
-    if (!LoadForwardImage("images/flare1.jpg", &kukot.flare, &image_error)) {
-      std::cerr << "kukot flare load failed: " << image_error << "\n";
-    }
-
-    const std::string kukot_ase_path = ResolveForwardAssetPath("asses/under1.ase");
-    bool tracks_ok = false;
-    bool objects_ok = false;
-    if (!kukot_ase_path.empty()) {
-      tracks_ok = ParseSaariAseCameraTracks(kukot_ase_path,
-                                            &kukot.camera_track,
-                                            &kukot.target_track,
-                                            &kukot.camera_fov_degrees);
-      static const std::vector<std::string> kKukotObjectNames = {"kellu", "kellu01", "kellu02"};
-      objects_ok = ParseAseAnimatedObjects(kukot_ase_path, kKukotObjectNames, &kukot.animated_objects);
-    }
-    if (!tracks_ok) {
-      std::cerr << "kukot camera tracks parse failed\n";
-    }
-    if (!objects_ok) {
-      std::cerr << "kukot ASE object parse failed\n";
-    } else {
-      std::cerr << "kukot ASE objects loaded: " << kukot.animated_objects.size() << "\n";
-    }
-
-    kukot.enabled = !kukot.object_texture.Empty() && !kukot.random_tile.Empty() &&
-                    !kukot.flare.Empty() && tracks_ok && objects_ok;
+      feta.enabled = !feta.babyenv.Empty();
+      particles.flare = feta.flare;
+      particles.enabled = !feta.flare.Empty();
+    }, {babyenv_task, flare_task, background_texture_task, background_mesh_task});
   }
 
-  {
-    std::string image_error;
-    Image32 maku_height;
-    Image32 maku_texture;
-    bool ok = LoadForwardImage("images/scape/loopk40.gif", &maku_height, &image_error);
-    if (!ok) {
-      std::cerr << "maku heightmap load failed: " << image_error << "\n";
-    }
-    ok = LoadForwardImage("images/scape/loopa2.gif", &maku_texture, &image_error);
-    if (!ok) {
-      std::cerr << "maku texture load failed: " << image_error << "\n";
-    }
-    bool mesh_ok = false;
-    if (!maku_height.Empty()) {
-      mesh_ok = BuildTerrainMeshFromHeightmap(maku_height, 200.0f, 1.94f, 0, &maku.terrain);
-      if (!mesh_ok) {
-        std::cerr << "maku terrain mesh build failed\n";
-      }
-    }
-    if (!maku_texture.Empty()) {
-      maku.terrain_texture = std::move(maku_texture);
-    }
+  AddSaariLoadTasks(loader, &saari);
 
-    bool tracks_ok = false;
-    const std::string maku_ase_path = ResolveForwardAssetPath("asses/vuori5.ase");
-    if (!maku_ase_path.empty()) {
-      tracks_ok = ParseMakuAseCameraTracks(
-          maku_ase_path, &maku.camera_track, &maku.target_track, &maku.camera_fov_degrees);
-    }
-    if (!tracks_ok) {
-      std::cerr << "maku camera tracks parse failed\n";
-    }
-    maku.enabled = mesh_ok && !maku.terrain_texture.Empty() && tracks_ok;
-  }
+  AddKukotLoadTasks(loader, &kukot);
 
-  {
-    std::string image_error;
-    bool textures_ok = true;
-    textures_ok &= LoadForwardImage("images/1.jpg", &watercube.panel_overlay, &image_error);
-    if (watercube.panel_overlay.Empty()) {
-      std::cerr << "watercube panel overlay load failed: " << image_error << "\n";
-      textures_ok = false;
-    }
-    textures_ok &= LoadForwardImage("images/txt1.jpg", &watercube.scroll_texture, &image_error);
-    if (watercube.scroll_texture.Empty()) {
-      std::cerr << "watercube scroll texture load failed: " << image_error << "\n";
-      textures_ok = false;
-    }
-    textures_ok &= LoadForwardImage("images/reunus2.jpg", &watercube.box_texture, &image_error);
-    if (watercube.box_texture.Empty()) {
-      std::cerr << "watercube box texture load failed: " << image_error << "\n";
-      textures_ok = false;
-    }
-    textures_ok &= LoadForwardImage("images/rinku2.jpg", &watercube.ring_texture, &image_error);
-    if (watercube.ring_texture.Empty()) {
-      std::cerr << "watercube ring texture load failed: " << image_error << "\n";
-      textures_ok = false;
-    }
-    textures_ok &= LoadForwardImage("images/riple2.jpg", &watercube.ripple_texture, &image_error);
-    if (watercube.ripple_texture.Empty()) {
-      std::cerr << "watercube ripple texture load failed: " << image_error << "\n";
-      textures_ok = false;
-    }
-
-    if (!LoadForwardImage("images/env3.jpg", &watercube.env_texture, &image_error)) {
-      std::cerr << "watercube env texture load failed: " << image_error << "\n";
-    }
-
-    const std::string watercube_ase_path = ResolveForwardAssetPath("asses/nosto3.ase");
-    bool tracks_ok = false;
-    bool objects_ok = false;
-    if (!watercube_ase_path.empty()) {
-      tracks_ok = ParseSaariAseCameraTracks(watercube_ase_path,
-                                            &watercube.camera_track,
-                                            &watercube.target_track,
-                                            &watercube.camera_fov_degrees);
-      static const std::vector<std::string> kWatercubeObjectNames = {"Box01", "TriPatch01"};
-      objects_ok =
-          ParseAseAnimatedObjects(watercube_ase_path, kWatercubeObjectNames, &watercube.animated_objects);
-    }
-    if (!tracks_ok) {
-      std::cerr << "watercube camera tracks parse failed\n";
-    }
-    if (!objects_ok) {
-      std::cerr << "watercube ASE object parse failed\n";
-    } else {
-      std::cerr << "watercube ASE objects loaded: " << watercube.animated_objects.size() << "\n";
-    }
+  AddMakuLoadTasks(loader, &maku);
 
-    const std::string kluns1_path = ResolveForwardAssetPath("meshes/kluns1.igu");
-    if (!kluns1_path.empty() && !forward::core::LoadIguMesh(kluns1_path, watercube.kluns1, &mesh_error)) {
-      std::cerr << "watercube kluns1 load failed: " << mesh_error << "\n";
-      watercube.kluns1.Clear();
-    }
-    const std::string kluns2_path = ResolveForwardAssetPath("meshes/kluns2.igu");
-    if (!kluns2_path.empty() && forward::core::LoadIguMesh(kluns2_path, watercube.kluns2, &mesh_error)) {
-      watercube.has_kluns2 = !watercube.kluns2.Empty();
-    }
-
-    watercube.enabled = textures_ok && tracks_ok && objects_ok;
-  }
+  AddWatercubeLoadTasks(loader, &watercube);
 
-  {
+  loader.AddTask("uppol phorward", [&uppol] {
     const std::string uppol_path = ResolveForwardAssetPath("images/phorward.gif");
     std::string uppol_error;
     if (!uppol_path.empty() &&
@@ -6220,42 +6612,57 @@ int main(int argc, char** argv) {
       if (uppol_path.empty()) {
         std::cerr << "uppol source load failed: images/phorward.gif not found\n";
       } else {
-        std::cerr << "uppol source load failed: " << uppol_error << "\n";
+        std::cerr << "uppol source load failed: " + uppol_error + "\n";
       }
     }
-  }
-
-  QuickWinPostLayer post;
+  });
 
-  const std::string phorward_path = ResolveForwardAssetPath("images/phorward.gif");
-  std::string image_error;
-  if (!phorward_path.empty() &&
-      forward::core::LoadImage32(phorward_path, domina.phorward, &image_error)) {
-    domina.enabled = true;
-    post.primary = domina.phorward;
-    post.enabled = true;
-  } else if (!phorward_path.empty()) {
-    std::cerr << "domina image load failed: " << image_error << "\n";
-    std::cerr << "quick-win image load failed: " << image_error << "\n";
-  }
-
-  std::string secondary_path = ResolveForwardAssetPath("images/komplex.gif");
-  if (secondary_path.empty()) {
-    secondary_path = ResolveForwardAssetPath("images/back.gif");
-  }
-  if (!secondary_path.empty()) {
-    Image32 secondary;
-    if (forward::core::LoadImage32(secondary_path, secondary, &image_error)) {
-      post.secondary = std::move(secondary);
-      domina.komplex = post.secondary;
-    } else {
-      std::cerr << "secondary post image load failed: " << image_error << "\n";
-    }
+  {
+    const TaskId primary_task = loader.AddTask("domina phorward", [&domina] {
+      const std::string phorward_path = ResolveForwardAssetPath("images/phorward.gif");
+      std::string image_error;
+      if (!phorward_path.empty() &&
+          LoadImage32Cached(phorward_path, domina.phorward, &image_error)) {
+        domina.enabled = true;
+      } else if (!phorward_path.empty()) {
+        std::cerr << "domina image load failed: " + image_error + "\n";
+        std::cerr << "quick-win image load failed: " + image_error + "\n";
+      }
+    });
+    const TaskId secondary_task = loader.AddTask("post secondary", [&post] {
+      std::string secondary_path = ResolveForwardAssetPath("images/komplex.gif");
+      if (secondary_path.empty()) {
+        secondary_path = ResolveForwardAssetPath("images/back.gif");
+      }
+      std::string image_error;
+      if (!secondary_path.empty() &&
+          !LoadImage32Cached(secondary_path, post.secondary, &image_error)) {
+        std::cerr << "secondary post image load failed: " + image_error + "\n";
+      }
+    });
+    loader.AddTask("post finalize", [&domina, &post] {
+      if (domina.enabled) {
+        post.primary = domina.phorward;
+        post.enabled = true;
+      }
+      if (!post.secondary.Empty()) {
+        domina.komplex = post.secondary;
+      }
+    }, {primary_task, secondary_task});
   }
 
+  loader.Start();
+
   XmPlayer xm_player;
   MusicState music;
   XmTiming xm_timing;
+  // Row starts handed to the audio device since the previous frame.
+  std::vector<XmRowEvent> row_events;
+  row_events.reserve(64);
+  // Offline backend: the loop pulls as many frames as the frame advanced.
+  WavWriter audio_wav;
+  std::vector<int16_t> offline_pcm;
+  double offline_frames_due = 0.0;
   if (!disable_audio) {
     std::string audio_error;
     const std::string mod1_path = ResolveForwardAssetPath("mods/kuninga.xm");
@@ -6270,68 +6677,129 @@ int main(int argc, char** argv) {
       std::cerr << "audio init: missing mods/jarnomix.xm\n";
     }
 
+    // The device is opened here, concurrently with asset loading; mod1 only
+    // starts once every asset is ready so the row clock is not ahead of the first frame.
     if (music.has_mod1 && music.has_mod2) {
-      if (!xm_player.Initialize(44100, 1024, &audio_error)) {
+      const bool initialized =
+          offline_audio
+              ? xm_player.InitializeOffline(kOfflineAudioRate, &audio_error)
+              : (SDL_InitSubSystem(SDL_INIT_AUDIO) == 0 &&
+                 xm_player.Initialize(44100, 1024, &audio_error, audio_ahead_ms));
+      if (!initialized) {
+        if (audio_error.empty()) {
+          audio_error = SDL_GetError();
+        }
         std::cerr << "audio init failed: " << audio_error << "\n";
       } else if (!xm_player.LoadModule(1, mod1_path, &audio_error) ||
-                 !xm_player.LoadModule(2, mod2_path, &audio_error) ||
-                 !xm_player.StartModule(1, false, &audio_error)) {
+                 !xm_player.LoadModule(2, mod2_path, &audio_error)) {
         std::cerr << "audio module setup failed: " << audio_error << "\n";
       } else {
         music.enabled = true;
-        if (verbose_audio) {
-          const char* driver = SDL_GetCurrentAudioDriver();
-          std::cerr << "audio enabled via SDL driver: " << (driver ? driver : "unknown") << "\n";
-        }
       }
     }
-  }
-
-  SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
-
-  const int initial_w = kLogicalWidth * kWindowScale;
-  const int initial_h = kLogicalHeight * kWindowScale;
-
-  SDL_Window* window = SDL_CreateWindow("forward native harness",
-                                        SDL_WINDOWPOS_CENTERED,
-                                        SDL_WINDOWPOS_CENTERED,
-                                        initial_w,
-                                        initial_h,
-                                        SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
-  if (!window) {
-    std::cerr << "SDL_CreateWindow failed: " << SDL_GetError() << "\n";
-    SDL_Quit();
-    return 1;
-  }
-
-  SDL_Renderer* renderer_sdl =
-      SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-  if (!renderer_sdl) {
-    renderer_sdl = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
-  }
-  if (!renderer_sdl) {
-    std::cerr << "SDL_CreateRenderer failed: " << SDL_GetError() << "\n";
+    if (music.enabled && !audio_wav_path.empty() &&
+        !audio_wav.Open(audio_wav_path, kOfflineAudioRate, 2, &audio_error)) {
+      std::cerr << "audio wav: " << audio_error << "\n";
+    }
+  }
+
+  SDL_Window* window = nullptr;
+  SDL_Renderer* renderer_sdl = nullptr;
+  SDL_Texture* texture = nullptr;
+  if (!headless.enabled) {
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
+
+    const int initial_w = kLogicalWidth * kWindowScale;
+    const int initial_h = kLogicalHeight * kWindowScale;
+
+    window = SDL_CreateWindow("forward native harness",
+                              SDL_WINDOWPOS_CENTERED,
+                              SDL_WINDOWPOS_CENTERED,
+                              initial_w,
+                              initial_h,
+                              SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
+    if (!window) {
+      std::cerr << "SDL_CreateWindow failed: " << SDL_GetError() << "\n";
+      loader.Wait();
+      SDL_Quit();
+      return 1;
+    }
+
+    renderer_sdl =
+        SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (!renderer_sdl) {
+      renderer_sdl = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    }
+    if (!renderer_sdl) {
+      std::cerr << "SDL_CreateRenderer failed: " << SDL_GetError() << "\n";
+      loader.Wait();
+      SDL_DestroyWindow(window);
+      SDL_Quit();
+      return 1;
+    }
+
+    texture = SDL_CreateTexture(renderer_sdl,
+                                SDL_PIXELFORMAT_ARGB8888,
+                                SDL_TEXTUREACCESS_STREAMING,
+                                kLogicalWidth,
+                                kLogicalHeight);
+    if (!texture) {
+      std::cerr << "SDL_CreateTexture failed: " << SDL_GetError() << "\n";
+      loader.Wait();
+      SDL_DestroyRenderer(renderer_sdl);
+      SDL_DestroyWindow(window);
+      SDL_Quit();
+      return 1;
+    }
+  }
+
+  loader.Wait();
+  const double load_seconds =
+      static_cast<double>(SDL_GetPerformanceCounter() - load_start_counter) /
+      static_cast<double>(SDL_GetPerformanceFrequency());
+  std::cerr << "assets loaded: " << loader.TaskCount() << " tasks on " << loader.WorkerCount()
+            << " workers in " << static_cast<int>(load_seconds * 1000.0) << " ms\n";
+  if (GetAssetCache().Enabled()) {
+    std::cerr << "asset cache " << GetAssetCache().Directory() << ": " << GetAssetCache().Hits()
+              << " hits, " << GetAssetCache().Misses() << " misses\n";
+  }
+
+  if (!mesh_loaded) {
+    std::cerr << "LoadIguMesh failed: " << mesh_error << "\n";
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(renderer_sdl);
     SDL_DestroyWindow(window);
     SDL_Quit();
     return 1;
   }
+  const float radius = mesh.BoundingRadius();
+  mesh_instance.uniform_scale = (radius > 0.001f) ? (1.0f / radius) : 1.0f;
+  halo_instance.uniform_scale = mesh_instance.uniform_scale * 1.075f;
 
-  SDL_Texture* texture = SDL_CreateTexture(renderer_sdl,
-                                           SDL_PIXELFORMAT_ARGB8888,
-                                           SDL_TEXTUREACCESS_STREAMING,
-                                           kLogicalWidth,
-                                           kLogicalHeight);
-  if (!texture) {
-    std::cerr << "SDL_CreateTexture failed: " << SDL_GetError() << "\n";
-    SDL_DestroyRenderer(renderer_sdl);
-    SDL_DestroyWindow(window);
-    SDL_Quit();
-    return 1;
+  if (music.enabled) {
+    std::string audio_error;
+    if (!xm_player.StartModule(1, false, &audio_error)) {
+      std::cerr << "audio module setup failed: " << audio_error << "\n";
+      music.enabled = false;
+    } else if (verbose_audio && xm_player.IsOffline()) {
+      std::cerr << "audio enabled via offline backend\n";
+    } else if (verbose_audio) {
+      const char* driver = SDL_GetCurrentAudioDriver();
+      std::cerr << "audio enabled via SDL driver: " << (driver ? driver : "unknown") << "\n";
+    }
   }
 
   Surface32 surface(kLogicalWidth, kLogicalHeight, true);
-  Surface32 halo_surface(kLogicalWidth, kLogicalHeight, true);
   Renderer3D renderer_3d(kLogicalWidth, kLogicalHeight);
+  FrameArena frame_arena;
+  RenderTargetPool render_targets;
+  // Feta's widest frame has five passes that can overlap; beyond four helpers
+  // the extra threads would only wait.
+  if (render_workers < 0) {
+    render_workers =
+        std::clamp(static_cast<int>(std::thread::hardware_concurrency()) - 1, 0, 4);
+  }
+  RenderPassGraph render_passes(kLogicalWidth, kLogicalHeight, render_workers);
 
   DemoState state;
   if (mute95.enabled && domina.enabled && saari.enabled) {
@@ -6376,7 +6844,24 @@ int main(int argc, char** argv) {
   state.mesh_label = std::filesystem::path(mesh_path).filename().string();
   state.post_label = state.show_post && post.enabled ? "phorward" : "off";
   double sequence_script_start_seconds = state.timeline_seconds;
+
+  SceneLifecycleManager::SceneRefs scene_refs;
+  scene_refs.mute95 = &mute95;
+  scene_refs.mute95_runtime = &mute95_runtime;
+  scene_refs.domina_runtime = &domina_runtime;
+  scene_refs.saari = &saari;
+  scene_refs.saari_runtime = &saari_runtime;
+  scene_refs.kukot = &kukot;
+  scene_refs.kukot_runtime = &kukot_runtime;
+  scene_refs.maku = &maku;
+  scene_refs.maku_runtime = &maku_runtime;
+  scene_refs.watercube = &watercube;
+  scene_refs.watercube_runtime = &watercube_runtime;
+  scene_refs.music = music.enabled ? &xm_player : nullptr;
+  SceneLifecycleManager scene_lifecycle(scene_refs, prefetch_rows);
+
   auto enter_maku_scene = [&](int order_row) {
+    scene_lifecycle.EnsureResident(SequenceStage::kMaku);
     state.scene_mode = SceneMode::kMaku;
     state.script_driven = false;
     state.scene_label = "maku@0x" + FormatOrderRowHex(order_row);
@@ -6385,7 +6870,6 @@ int main(int argc, char** argv) {
     RunMakuScriptAtOrderRow(maku_runtime, order_row, 0.0);
     maku_harness.direct_row_hint = order_row;
     maku_harness.captured_rows.clear();
-    maku_harness.last_order_row = -1;
   };
 
   for (int i = 1; i < argc; ++i) {
@@ -6432,12 +6916,9 @@ int main(int argc, char** argv) {
                                           : "mute95->domina";
         sequence_script_start_seconds = state.timeline_seconds;
         watercube_harness.captured_rows.clear();
-        watercube_harness.last_order_row = -1;
         maku_harness.captured_rows.clear();
-        maku_harness.last_order_row = -1;
         maku_harness.direct_row_hint = maku_bootstrap_row;
         feta_harness.captured_rows.clear();
-        feta_harness.last_order_row = -1;
         feta_runtime.initialized = false;
       }
     } else if (arg == "--scene=feta" || arg == "--feta") {
@@ -6449,6 +6930,19 @@ int main(int argc, char** argv) {
       feta_runtime.initialized = false;
     } else if (arg == "--debug-maku-no-fog" || arg == "--maku-no-fog") {
       state.debug_maku_no_fog = true;
+    } else if (arg == "--overdraw") {
+      state.debug_overdraw = true;
+    } else if (arg.rfind("--layer-downscale=", 0) == 0) {
+      int downscale = 0;
+      try {
+        downscale = std::stoi(arg.substr(std::string("--layer-downscale=").size()));
+      } catch (...) {
+      }
+      if (downscale == 1 || downscale == 2 || downscale == 4) {
+        state.layer_downscale = downscale;
+      } else {
+        std::cerr << "warning: invalid --layer-downscale value (1, 2 or 4): " << arg << "\n";
+      }
     }
   }
 
@@ -6470,21 +6964,184 @@ int main(int argc, char** argv) {
       music.enabled = false;
       return;
     }
+    // mod2 is preloaded; the mixer swaps to it on the exact row.
+    xm_player.ScheduleModuleSwitch(1, kMod1ToMod2Row >> 8, kMod1ToMod2Row & 0xFF, 2, true);
     music.module2_started = false;
     xm_player.SetPaused(state.paused);
     xm_timing = xm_player.GetTiming();
   };
 
+  // Set by a seek; the frame loop back-dates the scene it lands in.
+  struct {
+    bool pending = false;
+    int module_slot = 0;
+    int64_t module_time_ms = 0;
+  } seek_origin;
+
+  auto seek_sequence = [&](int module_slot, int order_row) {
+    if (!music.enabled || state.scene_mode != SceneMode::kMute95DominaSequence) {
+      std::cerr << "seek: needs music and the scripted sequence (--script)\n";
+      return;
+    }
+    std::string audio_error;
+    const bool switch_module = (module_slot == 2) != music.module2_started;
+    if (switch_module && !xm_player.StartModule(module_slot, module_slot == 2, &audio_error)) {
+      std::cerr << "seek: module start failed: " << audio_error << "\n";
+      return;
+    }
+    if (switch_module && module_slot == 1) {
+      xm_player.ScheduleModuleSwitch(1, kMod1ToMod2Row >> 8, kMod1ToMod2Row & 0xFF, 2, true);
+    }
+    music.module2_started = module_slot == 2;
+    XmSeekPoint point;
+    if (!xm_player.SeekToOrderRow(order_row >> 8, order_row & 0xFF, &point, &audio_error)) {
+      std::cerr << "seek: " << audio_error << "\n";
+      return;
+    }
+    xm_timing = xm_player.GetTiming();
+    state.timeline_seconds = static_cast<double>(xm_timing.clock_time_ms) / 1000.0;
+    state.scene_start_seconds = state.timeline_seconds;
+    mute95_runtime.initialized = false;
+    domina_runtime.initialized = false;
+    saari_runtime.initialized = false;
+    kukot_runtime.initialized = false;
+    maku_runtime.initialized = false;
+    watercube_runtime.initialized = false;
+    feta_runtime.initialized = false;
+    uppol_runtime.initialized = false;
+    particles.initialized = false;
+    watercube_harness.captured_rows.clear();
+    maku_harness.captured_rows.clear();
+    feta_harness.captured_rows.clear();
+    seek_origin = {true, module_slot, point.module_time_ms};
+    std::cerr << "seek: module " << module_slot << " row 0x"
+              << FormatOrderRowHex(PackOrderRow(point.order, point.row)) << " at "
+              << point.module_time_ms << " ms\n";
+  };
+
+  // The scripted sequence from its first row, as key 4 selects it.
+  auto restart_sequence = [&]() {
+    if (!mute95.enabled || !domina.enabled) {
+      return false;
+    }
+    scene_lifecycle.EnsureResident(SequenceStage::kMute95);
+    state.scene_mode = SceneMode::kMute95DominaSequence;
+    state.sequence_stage = SequenceStage::kMute95;
+    state.script_driven = true;
+    state.scene_label = saari.enabled ? ((maku.enabled && watercube.enabled)
+                                             ? "mute95->domina->saari->kukot->maku->watercube->feta->uppol"
+                                             : (maku.enabled
+                                                    ? "mute95->domina->saari->kukot->maku->feta->uppol"
+                                                    : "mute95->domina->saari->kukot->feta->uppol"))
+                                      : "mute95->domina";
+    state.scene_start_seconds = state.timeline_seconds;
+    sequence_script_start_seconds = state.timeline_seconds;
+    mute95_runtime.initialized = false;
+    domina_runtime.initialized = false;
+    saari_runtime.initialized = false;
+    kukot_runtime.initialized = false;
+    maku_runtime.initialized = false;
+    watercube_runtime.initialized = false;
+    feta_runtime.initialized = false;
+    watercube_harness.captured_rows.clear();
+    maku_harness.captured_rows.clear();
+    maku_harness.direct_row_hint = maku_bootstrap_row;
+    feta_harness.captured_rows.clear();
+    restart_sequence_audio();
+    return true;
+  };
+
+  // Restarts the sequence and jumps to `scene`: by seeking the music when it
+  // drives the sequence, by moving the script start back otherwise.
+  auto enter_bench_scene = [&](const BenchScene& scene) {
+    if (!restart_sequence()) {
+      return false;
+    }
+    if (music.enabled) {
+      seek_sequence(scene.module_slot, scene.order_row);
+    } else {
+      sequence_script_start_seconds = state.timeline_seconds - scene.fallback_seconds;
+    }
+    return true;
+  };
+
   if (music.enabled) {
     xm_player.SetPaused(state.paused);
     if (state.scene_mode == SceneMode::kMute95DominaSequence) {
       restart_sequence_audio();
     }
   }
+  if (bench.enabled) {
+    bench.scenes = BuildBenchScenes(bench.scene_filter);
+    if (bench.scenes.empty()) {
+      std::cerr << "bench: no scenes selected\n";
+      running = false;
+    }
+    state.paused = false;
+  }
+  if (seek_order_row >= 0) {
+    seek_sequence(seek_module_slot, seek_order_row);
+  }
 
+  if (headless.enabled && !music.enabled && headless.end_order_row >= 0 &&
+      headless.max_frames < 0 && headless.end_seconds < 0.0) {
+    std::cerr << "headless: --end-row needs music; stopping after " << kDefaultHeadlessFrames
+              << " frames\n";
+    headless.max_frames = kDefaultHeadlessFrames;
+  }
+  uint64_t frame_index = 0;
+  const uint64_t run_start_counter = SDL_GetPerformanceCounter();
+  const double run_start_seconds = state.timeline_seconds;
+  const bool collect_zones = Profiler::Enabled();
+  std::vector<ProfileEvent> frame_zones;
+  uint64_t frame_top_counter = run_start_counter;
+  AllocationCounters frame_top_allocations = ThreadAllocations();
+  SetAllocationSiteCapture(report_allocation_sites);
   while (running) {
+    const AllocationCounters top_allocations = ThreadAllocations();
+    const AllocationCounters frame_allocations = top_allocations - frame_top_allocations;
+    frame_top_allocations = top_allocations;
+    if (collect_zones) {
+      frame_zones.clear();
+      const size_t dropped_zones = Profiler::Collect(&frame_zones);
+      if (!trace.path.empty() && CollectTrace(&trace, frame_zones, dropped_zones) &&
+          stall.budget_ms < 0.0) {
+        Profiler::SetEnabled(false);
+      }
+      if (stall.budget_ms >= 0.0) {
+        RecordStallWindow(&stall, frame_zones);
+      }
+    }
+    // Wall time of the previous frame, loop top to loop top, also when headless.
+    const uint64_t top_counter = SDL_GetPerformanceCounter();
+    const double frame_ms = static_cast<double>(top_counter - frame_top_counter) * 1000.0 /
+                            static_cast<double>(perf_freq);
+    frame_top_counter = top_counter;
+    if (frame_index > 0 && (metrics.out || stall.budget_ms >= 0.0)) {
+      const double wall_seconds =
+          static_cast<double>(top_counter - run_start_counter) / static_cast<double>(perf_freq);
+      if (metrics.out) {
+        AddMetricsFrame(&metrics, state, frame_ms, renderer_3d.FrameStats(), frame_allocations);
+      }
+      if (stall.budget_ms >= 0.0 && frame_ms > stall.budget_ms) {
+        const std::filesystem::path stall_trace =
+            DumpStallWindow(&stall, frame_index - 1, frame_ms);
+        if (metrics.out) {
+          WriteMetricsStall(&metrics, wall_seconds, frame_index - 1, frame_ms, state, stall_trace);
+        }
+      }
+      if (metrics.out && metrics.elapsed_seconds >= metrics.period_seconds) {
+        WriteMetricsLine(&metrics, wall_seconds, frame_index, state,
+                         music.enabled ? &xm_player : nullptr, stall, frame_arena,
+                         render_targets);
+      }
+    }
+    // Nothing drawn last frame holds on to its scratch.
+    frame_arena.Reset();
+    render_targets.EndFrame();
+    FORWARD_PROFILE_ZONE("frame");
     SDL_Event event;
-    while (SDL_PollEvent(&event)) {
+    while (!headless.enabled && SDL_PollEvent(&event)) {
       if (event.type == SDL_QUIT) {
         running = false;
       }
@@ -6514,6 +7171,9 @@ int main(int argc, char** argv) {
             std::cerr << "debug: maku no-fog "
                       << (state.debug_maku_no_fog ? "enabled" : "disabled") << "\n";
             break;
+          case SDLK_o:
+            state.debug_overdraw = !state.debug_overdraw;
+            break;
           case SDLK_LEFTBRACKET:
           case SDLK_MINUS:
             state.feta_fov_degrees = std::clamp(state.feta_fov_degrees - 1.0f, 40.0f, 120.0f);
@@ -6524,6 +7184,7 @@ int main(int argc, char** argv) {
             break;
           case SDLK_1:
             if (mute95.enabled) {
+              scene_lifecycle.EnsureResident(SequenceStage::kMute95);
               state.scene_mode = SceneMode::kMute95;
               state.script_driven = false;
               state.scene_label = "mute95";
@@ -6549,37 +7210,11 @@ int main(int argc, char** argv) {
             }
             break;
           case SDLK_4:
-            if (mute95.enabled && domina.enabled) {
-              state.scene_mode = SceneMode::kMute95DominaSequence;
-              state.sequence_stage = SequenceStage::kMute95;
-              state.script_driven = true;
-              state.scene_label = saari.enabled ? ((maku.enabled && watercube.enabled)
-                                                       ? "mute95->domina->saari->kukot->maku->watercube->feta->uppol"
-                                                       : (maku.enabled
-                                                              ? "mute95->domina->saari->kukot->maku->feta->uppol"
-                                                              : "mute95->domina->saari->kukot->feta->uppol"))
-                                                : "mute95->domina";
-              state.scene_start_seconds = state.timeline_seconds;
-              sequence_script_start_seconds = state.timeline_seconds;
-              mute95_runtime.initialized = false;
-              domina_runtime.initialized = false;
-              saari_runtime.initialized = false;
-              kukot_runtime.initialized = false;
-              maku_runtime.initialized = false;
-              watercube_runtime.initialized = false;
-              feta_runtime.initialized = false;
-              watercube_harness.captured_rows.clear();
-              watercube_harness.last_order_row = -1;
-              maku_harness.captured_rows.clear();
-              maku_harness.last_order_row = -1;
-              maku_harness.direct_row_hint = maku_bootstrap_row;
-              feta_harness.captured_rows.clear();
-              feta_harness.last_order_row = -1;
-              restart_sequence_audio();
-            }
+            restart_sequence();
             break;
           case SDLK_5:
             if (saari.enabled) {
+              scene_lifecycle.EnsureResident(SequenceStage::kSaari);
               state.scene_mode = SceneMode::kSaari;
               state.script_driven = false;
               state.scene_label = "saari";
@@ -6617,9 +7252,30 @@ int main(int argc, char** argv) {
       }
     }
 
+    if (bench.enabled && bench.scene_frame < 0) {
+      if (!enter_bench_scene(bench.scenes[bench.scene_index])) {
+        std::cerr << "bench: the scripted sequence needs the mute95 and domina assets\n";
+        break;
+      }
+      bench.scene_frame = 0;
+      bench.frame_ms.clear();
+      // Sized up front so recording a timed frame is not itself an allocation.
+      bench.frame_ms.reserve(static_cast<size_t>(bench.frames));
+      bench.allocations = AllocationCounters{};
+    }
+    const bool bench_timed_frame = bench.enabled && bench.scene_frame >= bench.warmup_frames;
+    if (bench_timed_frame && !report_allocation_sites) {
+      SetAllocationSiteCapture(true);
+    }
+
+    // Headless frames advance a virtual clock by exactly one step, however
+    // long they took to render.
     const uint64_t perf_now = SDL_GetPerformanceCounter();
+    const AllocationCounters frame_start_allocations = ThreadAllocations();
     const double frame_dt =
-        static_cast<double>(perf_now - perf_prev) / static_cast<double>(perf_freq);
+        headless.enabled
+            ? 1.0 / static_cast<double>(headless.fps)
+            : static_cast<double>(perf_now - perf_prev) / static_cast<double>(perf_freq);
     perf_prev = perf_now;
     state.frame_dt_seconds = frame_dt;
 
@@ -6636,27 +7292,42 @@ int main(int argc, char** argv) {
     }
     stats.simulated_ticks += static_cast<uint64_t>(ticks_this_frame);
 
+    row_events.clear();
+    if (music.enabled && xm_player.IsOffline() && !state.paused) {
+      FORWARD_PROFILE_ZONE("audio.offline");
+      offline_frames_due += frame_dt * static_cast<double>(xm_player.SampleRate());
+      const int frames = static_cast<int>(offline_frames_due);
+      offline_frames_due -= static_cast<double>(frames);
+      offline_pcm.resize(static_cast<size_t>(frames) * 2);
+      xm_player.RenderOffline(frames, audio_wav.IsOpen() ? offline_pcm.data() : nullptr);
+      audio_wav.Write(offline_pcm.data(), static_cast<size_t>(frames));
+    }
     if (music.enabled) {
+      XmRowEvent row_event;
+      while (xm_player.PopRowEvent(&row_event)) {
+        row_events.push_back(row_event);
+      }
       xm_timing = xm_player.GetTiming();
 
-      if (xm_timing.valid && xm_timing.module_slot == 1 && !music.module2_started &&
-          PackOrderRow(xm_timing.order, xm_timing.row) >= kMod1ToMod2Row) {
-        std::string audio_error;
-        if (!xm_player.StartModule(2, true, &audio_error)) {
-          std::cerr << "audio switch-to-mod2 failed: " << audio_error << "\n";
-          music.enabled = false;
-        } else {
-          music.module2_started = true;
-          xm_timing = xm_player.GetTiming();
-        }
+      // The player itself moves to mod2 at kMod1ToMod2Row; note when it has.
+      if (!music.module2_started) {
+        music.module2_started =
+            xm_timing.module_slot == 2 ||
+            std::any_of(row_events.begin(), row_events.end(),
+                        [](const XmRowEvent& event) { return event.module_slot == 2; });
       }
 
       if (!state.paused && xm_timing.valid) {
-        state.timeline_seconds = static_cast<double>(xm_timing.clock_time_ms) / 1000.0;
+        // Interpolated between callbacks; held monotonic against callback jitter.
+        const double clock_ms = InterpolateClockMs(xm_timing, SDL_GetPerformanceCounter());
+        state.timeline_seconds = std::max(state.timeline_seconds, clock_ms / 1000.0);
       }
     }
     state.music_module_slot = xm_timing.valid ? xm_timing.module_slot : 0;
     state.music_order_row = xm_timing.valid ? PackOrderRow(xm_timing.order, xm_timing.row) : -1;
+    if (headless.enabled && HeadlessRangeEnded(headless, state.timeline_seconds, xm_timing)) {
+      break;
+    }
 
     // Feta script messages are emitted before feta is shown in the original script.
     // Consume them at the global script level so palette/message state is ready at show row 0x1300.
@@ -6699,19 +7370,7 @@ int main(int argc, char** argv) {
         } else {
           state.scene_label = "mute95->domina->saari->kukot->maku->watercube->feta->uppol [watercube]";
         }
-        if (desired == SequenceStage::kMute95) {
-          mute95_runtime.initialized = false;
-        } else if (desired == SequenceStage::kDomina) {
-          domina_runtime.initialized = false;
-        } else if (desired == SequenceStage::kSaari) {
-          saari_runtime.initialized = false;
-        } else if (desired == SequenceStage::kKukot) {
-          kukot_runtime.initialized = false;
-        } else if (desired == SequenceStage::kMaku) {
-          maku_runtime.initialized = false;
-        } else {
-          watercube_runtime.initialized = false;
-        }
+        scene_lifecycle.EnterStage(desired);
       }
 
       // Original script switches from watercube to feta at module 2 row 0x1300.
@@ -6747,6 +7406,32 @@ int main(int argc, char** argv) {
       }
     }
 
+    if (seek_origin.pending) {
+      // Scene time runs from the row where the sequence enters the scene, not
+      // from the seek target.
+      seek_origin.pending = false;
+      const auto [start_slot, start_row] =
+          SequenceSceneStartRow(state.scene_mode, state.sequence_stage);
+      XmSeekPoint start;
+      std::string seek_error;
+      if (start_slot == seek_origin.module_slot &&
+          xm_player.FindSeekPoint(
+              start_slot, start_row >> 8, start_row & 0xFF, &start, &seek_error) &&
+          start.module_time_ms <= seek_origin.module_time_ms) {
+        state.scene_start_seconds =
+            state.timeline_seconds -
+            static_cast<double>(seek_origin.module_time_ms - start.module_time_ms) / 1000.0;
+      }
+    }
+
+    {
+      FORWARD_PROFILE_ZONE("stream.update");
+      scene_lifecycle.Update(
+          state, xm_timing, std::max(0.0, state.timeline_seconds - sequence_script_start_seconds));
+    }
+
+    renderer_3d.SetOverdrawView(state.debug_overdraw);
+    renderer_3d.BeginFrame();
     DrawFrame(surface,
               state,
               mute95,
@@ -6769,6 +7454,9 @@ int main(int argc, char** argv) {
               feta_runtime,
               camera,
               renderer_3d,
+              frame_arena,
+              render_targets,
+              render_passes,
               mesh_instance,
               halo_instance,
               background_instance,
@@ -6776,29 +7464,89 @@ int main(int argc, char** argv) {
               saari_terrain_instance,
               saari_object_instance,
               watercube_object_instance,
-              halo_surface,
               feta,
               post);
 
     MaybeCaptureWatercubeCheckpoint(
-        &watercube_harness, state, xm_timing, surface, watercube_runtime);
-    MaybeCaptureMakuCheckpoint(&maku_harness, state, xm_timing, surface, maku_runtime);
-    MaybeCaptureFetaCheckpoint(&feta_harness, state, xm_timing, surface, feta_runtime);
-
-    if (SDL_UpdateTexture(texture,
-                          nullptr,
-                          surface.FrontPixels(),
-                          kLogicalWidth * static_cast<int>(sizeof(uint32_t))) != 0) {
-      std::cerr << "SDL_UpdateTexture failed: " << SDL_GetError() << "\n";
-      running = false;
+        &watercube_harness, state, row_events, xm_timing, surface, watercube_runtime);
+    MaybeCaptureMakuCheckpoint(&maku_harness, state, row_events, xm_timing, surface, maku_runtime);
+    MaybeCaptureFetaCheckpoint(&feta_harness, state, row_events, xm_timing, surface, feta_runtime);
+
+    if (bench.enabled) {
+      const BenchScene& scene = bench.scenes[bench.scene_index];
+      if (bench_timed_frame) {
+        bench.allocations += ThreadAllocations() - frame_start_allocations;
+        if (!report_allocation_sites) {
+          SetAllocationSiteCapture(false);
+        }
+        bench.frame_ms.push_back(static_cast<double>(SDL_GetPerformanceCounter() - perf_now) *
+                                 1000.0 / static_cast<double>(perf_freq));
+      }
+      if (++bench.scene_frame >= bench.warmup_frames + bench.frames) {
+        const forward::core::FrameTimeSummary summary =
+            forward::core::SummarizeFrameTimes(bench.frame_ms);
+        std::cerr << "bench " << scene.name << ": mean " << std::fixed << std::setprecision(3)
+                  << summary.mean_ms << " ms, p95 " << summary.p95_ms << " ms, max "
+                  << summary.max_ms << " ms\n";
+        bench.results.push_back(
+            {scene.name, summary, bench.allocations.count, bench.allocations.bytes});
+        // Steady-state frames must not allocate; where they do is only known
+        // to debug builds.
+        if (forward::core::AllocationTrackingEnabled() &&
+            bench.allocations.count > bench.max_allocations) {
+          ++bench.allocation_failures;
+          std::cerr << "bench " << scene.name << ": " << bench.allocations.count
+                    << " heap allocations (" << bench.allocations.bytes << " bytes) in "
+                    << bench.frames << " timed frames, limit " << bench.max_allocations << "\n";
+          if (!report_allocation_sites) {
+            PrintAllocationSites(kReportedAllocationSites);
+          }
+        } else if (!report_allocation_sites) {
+          TakeAllocationSites(0);
+        }
+        bench.scene_frame = -1;
+        if (++bench.scene_index >= bench.scenes.size()) {
+          running = false;
+        }
+      }
     }
 
-    SDL_SetRenderDrawColor(renderer_sdl, 0, 0, 0, 255);
-    SDL_RenderClear(renderer_sdl);
+    if (!dump_frames_dir.empty()) {
+      std::ostringstream name;
+      name << "frame_" << std::setfill('0') << std::setw(6) << frame_index << ".ppm";
+      WritePpmImage(dump_frames_dir / name.str(), surface.FrontPixels(), kLogicalWidth,
+                    kLogicalHeight);
+    }
+    ++frame_index;
 
-    const SDL_Rect dst = ComputePresentationRect(renderer_sdl);
-    SDL_RenderCopy(renderer_sdl, texture, nullptr, &dst);
-    SDL_RenderPresent(renderer_sdl);
+    if (headless.enabled) {
+      ++headless.frames;
+      if (headless.max_frames >= 0 && headless.frames >= headless.max_frames) {
+        running = false;
+      }
+      continue;
+    }
+
+    {
+      FORWARD_PROFILE_ZONE("texture.upload");
+      if (SDL_UpdateTexture(texture,
+                            nullptr,
+                            surface.FrontPixels(),
+                            kLogicalWidth * static_cast<int>(sizeof(uint32_t))) != 0) {
+        std::cerr << "SDL_UpdateTexture failed: " << SDL_GetError() << "\n";
+        running = false;
+      }
+    }
+
+    {
+      FORWARD_PROFILE_ZONE("present");
+      SDL_SetRenderDrawColor(renderer_sdl, 0, 0, 0, 255);
+      SDL_RenderClear(renderer_sdl);
+
+      const SDL_Rect dst = ComputePresentationRect(renderer_sdl);
+      SDL_RenderCopy(renderer_sdl, texture, nullptr, &dst);
+      SDL_RenderPresent(renderer_sdl);
+    }
 
     ++stats.rendered_frames;
 
@@ -6810,10 +7558,99 @@ int main(int argc, char** argv) {
     }
   }
 
+  SetAllocationSiteCapture(false);
+  int exit_code = 0;
+  if (bench.enabled) {
+    exit_code = (bench.results.size() == bench.scenes.size() && !bench.scenes.empty() &&
+                 bench.allocation_failures == 0)
+                    ? 0
+                    : 1;
+    std::string bench_error;
+    if (bench.json_path.empty()) {
+      std::cout << forward::core::FormatBenchJson("forward_bench", bench.results);
+    } else if (!forward::core::WriteBenchJson(
+                   bench.json_path, "forward_bench", bench.results, &bench_error)) {
+      std::cerr << "bench: " << bench_error << "\n";
+      exit_code = 1;
+    }
+    std::vector<BenchResult> baseline;
+    if (!bench.baseline_path.empty() &&
+        !forward::core::ReadBenchJson(bench.baseline_path, &baseline, &bench_error)) {
+      std::cerr << "bench baseline: " << bench_error << "\n";
+      exit_code = 1;
+    } else if (!bench.baseline_path.empty()) {
+      const std::vector<forward::core::BenchRegression> regressions =
+          forward::core::CompareToBaseline(bench.results, baseline, bench.threshold_percent);
+      for (const forward::core::BenchRegression& regression : regressions) {
+        std::cerr << "bench regression: " << regression.name << " " << regression.metric << " "
+                  << std::fixed << std::setprecision(3) << regression.baseline_ms << " -> "
+                  << regression.current_ms << " ms\n";
+      }
+      if (!regressions.empty()) {
+        exit_code = 1;
+      } else {
+        std::cerr << "bench: within " << bench.threshold_percent << "% of "
+                  << bench.baseline_path << "\n";
+      }
+    }
+  }
+  if (headless.enabled) {
+    const double wall_seconds =
+        static_cast<double>(SDL_GetPerformanceCounter() - run_start_counter) /
+        static_cast<double>(SDL_GetPerformanceFrequency());
+    std::cerr << "headless: " << headless.frames << " frames, timeline " << std::fixed
+              << std::setprecision(3) << run_start_seconds << "-" << state.timeline_seconds
+              << " s, " << std::setprecision(1) << wall_seconds * 1000.0 << " ms wall ("
+              << static_cast<double>(headless.frames) / std::max(wall_seconds, 0.0001)
+              << " fps)\n";
+  }
+  if (metrics.out && !metrics.frame_ms.empty()) {
+    WriteMetricsLine(&metrics,
+                     static_cast<double>(SDL_GetPerformanceCounter() - run_start_counter) /
+                         static_cast<double>(perf_freq),
+                     frame_index,
+                     state,
+                     music.enabled ? &xm_player : nullptr,
+                     stall,
+                     frame_arena,
+                     render_targets);
+  }
+  if (report_allocation_sites) {
+    std::cerr << "allocation sites:\n";
+    PrintAllocationSites(kReportedAllocationSites);
+  }
+  if (stall.stalls > 0) {
+    std::cerr << "stalls: " << stall.stalls << " frames over " << stall.budget_ms << " ms, "
+              << stall.dumps << " traces in " << stall.directory.string() << "\n";
+  }
+  if (music.enabled && verbose_audio) {
+    std::cerr << "audio underruns: " << xm_player.UnderrunCount() << "\n";
+  }
+  if (audio_wav.IsOpen()) {
+    std::cerr << "audio wav: " << audio_wav.FramesWritten() << " frames written to "
+              << audio_wav_path << "\n";
+    audio_wav.Close();
+  }
   xm_player.Shutdown();
+  if (!trace.path.empty()) {
+    Profiler::SetEnabled(false);
+    frame_zones.clear();
+    const size_t dropped_zones = Profiler::Collect(&frame_zones);
+    CollectTrace(&trace, frame_zones, dropped_zones);
+    std::string trace_error;
+    if (!Profiler::WriteChromeTrace(trace.path, trace.events, &trace_error)) {
+      std::cerr << "trace: " << trace_error << "\n";
+    } else {
+      std::cerr << "trace: " << trace.events.size() << " zones written to " << trace.path;
+      if (trace.dropped > 0) {
+        std::cerr << " (" << trace.dropped << " dropped)";
+      }
+      std::cerr << "\n";
+    }
+  }
   SDL_DestroyTexture(texture);
   SDL_DestroyRenderer(renderer_sdl);
   SDL_DestroyWindow(window);
   SDL_Quit();
-  return 0;
+  return exit_code;
 }